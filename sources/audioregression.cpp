@@ -0,0 +1,539 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "audioregression.h"
+#include "testbank.h"
+#include "options.h"
+#include "polyphonecore.h"
+#include "soundfontmanager.h"
+#include "sf2/inputparsersf2.h"
+#include "sampleutils.h"
+#include "synth.h"
+#include "modulatordata.h"
+#include <QFile>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QtMath>
+#include <QtEndian>
+
+static const quint32 SAMPLE_RATE = TestBank::SAMPLE_RATE;
+static const quint32 BUFFER_SIZE = 64; // Events are applied at the beginning of a buffer
+static const int SPECTRUM_SIZE = 4096;
+static const int RECORD_HEADER_SIZE = 46; // Header of the files written by the recorder of the synth
+
+static void setGen(SoundfontManager * sm, EltID id, AttributeType champ, qint16 value)
+{
+    AttributeValue val;
+    val.shValue = value;
+    sm->set(id, champ, val);
+}
+
+AudioRegression::AudioRegression(Options * options) :
+    _options(options)
+{}
+
+int AudioRegression::process()
+{
+    QString directory = _options->getOutputDirectory();
+    bool record = _options->regressionRecord();
+    if (record)
+        QDir().mkpath(directory);
+    if (!QDir(directory).exists())
+    {
+        writeLine("The directory " + directory + " does not exist.");
+        return 1;
+    }
+
+    TestBank::initialize();
+    SoundfontManager * sm = PolyphoneCore::soundfonts();
+    int sf2Index = createSoundfont(sm);
+
+    Synth * synth = new Synth(sm->getSoundfonts(), sm->getMutex());
+    TestBank::configureSynth(synth, &_midiValues);
+    synth->setSampleRateAndBufferSize(SAMPLE_RATE, BUFFER_SIZE);
+
+    QJsonArray results;
+    int errorCount = 0;
+    foreach (Scenario scenario, _scenarios)
+    {
+        QString referencePath = directory + "/" + scenario.name + ".wav";
+        QVector<float> data;
+        double time = render(synth, sf2Index, scenario, data, record ? referencePath : "");
+
+        QJsonObject result;
+        result["scenario"] = scenario.name;
+        result["render_time_ms"] = time;
+        result["realtime_ratio"] = time > 0 ? 1000.0 * data.size() / 2 / SAMPLE_RATE / time : 0.0;
+
+        QString error;
+        if (record)
+            writeLine(scenario.name + ": recorded (" + QString::number(time, 'f', 1) + " ms)");
+        else
+        {
+            QVector<float> reference;
+            if (!readReference(referencePath, reference))
+                error = "the reference " + referencePath + " cannot be read";
+            else if (reference.size() != data.size())
+                error = "the length differs from the reference";
+            else
+            {
+                double peakError = getPeakError(data, reference);
+                double spectralDistance = getSpectralDistance(data, reference);
+                result["peak_error"] = peakError;
+                result["spectral_distance_db"] = spectralDistance;
+                if (peakError > _options->peakTolerance() || spectralDistance > _options->spectralTolerance())
+                    error = "peak error " + QString::number(peakError) +
+                            ", spectral distance " + QString::number(spectralDistance) + " dB";
+            }
+
+            writeLine(scenario.name + ": " + (error.isEmpty() ? "ok" : "different, " + error) +
+                      " (" + QString::number(time, 'f', 1) + " ms)");
+        }
+        result["success"] = error.isEmpty();
+        result["error"] = error;
+        results.append(result);
+        if (!error.isEmpty())
+            errorCount++;
+    }
+
+    // The synth is deleted before the soundfont
+    delete synth;
+    PolyphoneCore::close(sf2Index);
+
+    // Samples of a soundfont parsed from memory, as the content of a sfArk file
+    QString loadingError = checkMemoryLoading(sm);
+    SoundfontManager::kill();
+
+    if (!record)
+        writeLine(QString::number(_scenarios.count() - errorCount) + " scenarios identical, " +
+                  QString::number(errorCount) + " different");
+    writeLine("memory loading: " + (loadingError.isEmpty() ? QString("ok") : "different, " + loadingError));
+    if (!loadingError.isEmpty())
+        errorCount++;
+
+    if (!_options->getSummaryFile().isEmpty())
+    {
+        QJsonObject summary;
+        summary["mode"] = record ? "record" : "compare";
+        summary["peak_tolerance"] = _options->peakTolerance();
+        summary["spectral_tolerance_db"] = _options->spectralTolerance();
+        summary["scenarios"] = results;
+        QJsonObject loading;
+        loading["success"] = loadingError.isEmpty();
+        loading["error"] = loadingError;
+        summary["memory_loading"] = loading;
+        if (!TestBank::writeFile(_options->getSummaryFile(), QJsonDocument(summary).toJson()))
+        {
+            writeLine("Couldn't write the summary " + _options->getSummaryFile());
+            return 1;
+        }
+    }
+
+    return errorCount > 0 ? 5 : 0;
+}
+
+int AudioRegression::createSoundfont(SoundfontManager * sm)
+{
+    int sf2Index = sm->add(EltID(elementSf2));
+    sm->beginBulkLoad(sf2Index);
+    sm->set(EltID(elementSf2, sf2Index), champ_name, "Regression");
+
+    // Samples
+    int tone60 = addSample(sm, sf2Index, "tone 60", 60, 4);
+    int tone72 = addSample(sm, sf2Index, "tone 72", 72, 2);
+    int left = addSample(sm, sf2Index, "stereo 60L", 60, 1);
+    int right = addSample(sm, sf2Index, "stereo 60R", 60, 6);
+    AttributeValue value;
+    value.sfLinkValue = leftSample;
+    sm->set(EltID(elementSmpl, sf2Index, left), champ_sfSampleType, value);
+    value.wValue = static_cast<quint16>(right);
+    sm->set(EltID(elementSmpl, sf2Index, left), champ_wSampleLink, value);
+    value.sfLinkValue = rightSample;
+    sm->set(EltID(elementSmpl, sf2Index, right), champ_sfSampleType, value);
+    value.wValue = static_cast<quint16>(left);
+    sm->set(EltID(elementSmpl, sf2Index, right), champ_wSampleLink, value);
+
+    // Loop and release
+    int inst = addInstrument(sm, sf2Index, "loop", -2400);
+    TestBank::addDivision(sm, EltID(elementInst, sf2Index, inst), tone60, 0, 127);
+    addScenario(sm, sf2Index, inst, "loop", 1.0, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 100)
+                << createEvent(0.25, EVENT_NOTE, 67, 80)
+                << createEvent(0.5, EVENT_NOTE, 60, 0)
+                << createEvent(0.5, EVENT_NOTE, 67, 0));
+
+    // Volume envelope and modulation envelope on the pitch, with different velocities
+    inst = addInstrument(sm, sf2Index, "envelope", -1586); // 0.4 s
+    EltID idInst(elementInst, sf2Index, inst);
+    setGen(sm, idInst, champ_attackVolEnv, -3986); // 0.1 s
+    setGen(sm, idInst, champ_holdVolEnv, -6000);
+    setGen(sm, idInst, champ_decayVolEnv, -2786); // 0.2 s
+    setGen(sm, idInst, champ_sustainVolEnv, 120); // 12 dB
+    setGen(sm, idInst, champ_attackModEnv, -3986);
+    setGen(sm, idInst, champ_decayModEnv, -1200); // 0.5 s
+    setGen(sm, idInst, champ_sustainModEnv, 500); // 50%
+    setGen(sm, idInst, champ_modEnvToPitch, 700);
+    TestBank::addDivision(sm, idInst, tone60, 0, 127);
+    addScenario(sm, sf2Index, inst, "envelope", 1.2, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 127)
+                << createEvent(0.1, EVENT_NOTE, 48, 40)
+                << createEvent(0.4, EVENT_NOTE, 48, 0)
+                << createEvent(0.6, EVENT_NOTE, 60, 0));
+
+    // Resonant filter swept by the modulation envelope
+    inst = addInstrument(sm, sf2Index, "filter", -2400);
+    idInst.indexElt = inst;
+    setGen(sm, idInst, champ_initialFilterFc, 9524); // 2 kHz
+    setGen(sm, idInst, champ_initialFilterQ, 90); // 9 dB
+    setGen(sm, idInst, champ_attackModEnv, -6000);
+    setGen(sm, idInst, champ_decayModEnv, -1200);
+    setGen(sm, idInst, champ_sustainModEnv, 1000);
+    setGen(sm, idInst, champ_modEnvToFilterFc, 2400);
+    TestBank::addDivision(sm, idInst, tone60, 0, 127);
+    addScenario(sm, sf2Index, inst, "filter", 1.2, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 127)
+                << createEvent(0.2, EVENT_NOTE, 72, 50)
+                << createEvent(0.8, EVENT_NOTE, 60, 0)
+                << createEvent(0.8, EVENT_NOTE, 72, 0));
+
+    // Vibrato and modulation LFOs
+    inst = addInstrument(sm, sf2Index, "lfo", -2400);
+    idInst.indexElt = inst;
+    setGen(sm, idInst, champ_initialFilterFc, 10000);
+    setGen(sm, idInst, champ_delayVibLFO, -3986);
+    setGen(sm, idInst, champ_freqVibLFO, -535); // 6 Hz
+    setGen(sm, idInst, champ_vibLfoToPitch, 50);
+    setGen(sm, idInst, champ_freqModLFO, -1736); // 3 Hz
+    setGen(sm, idInst, champ_modLfoToVolume, 60);
+    setGen(sm, idInst, champ_modLfoToFilterFc, 1200);
+    setGen(sm, idInst, champ_modLfoToPitch, 20);
+    TestBank::addDivision(sm, idInst, tone60, 0, 127);
+    addScenario(sm, sf2Index, inst, "lfo", 1.2, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 100)
+                << createEvent(1.0, EVENT_NOTE, 60, 0));
+
+    // Modulator on the filter driven by CC1, default modulators driven by the pitch wheel and CC7 / CC10
+    inst = addInstrument(sm, sf2Index, "modulators", -2400);
+    idInst.indexElt = inst;
+    setGen(sm, idInst, champ_initialFilterFc, 12000);
+    EltID idMod(elementInstMod, sf2Index, inst);
+    idMod.indexMod = sm->add(idMod);
+    value.sfModValue = SFModulator(static_cast<quint8>(1), typeLinear, false, false);
+    sm->set(idMod, champ_sfModSrcOper, value);
+    value.wValue = champ_initialFilterFc;
+    sm->set(idMod, champ_sfModDestOper, value);
+    value.shValue = -3000;
+    sm->set(idMod, champ_modAmount, value);
+    value.sfModValue = SFModulator();
+    sm->set(idMod, champ_sfModAmtSrcOper, value);
+    value.sfTransValue = linear;
+    sm->set(idMod, champ_sfModTransOper, value);
+    TestBank::addDivision(sm, idInst, tone60, 0, 127);
+    addScenario(sm, sf2Index, inst, "modulators", 1.2, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 100)
+                << createEvent(0.2, EVENT_CONTROLLER, 1, 64)
+                << createEvent(0.4, EVENT_CONTROLLER, 1, 127)
+                << createEvent(0.5, EVENT_BEND, 0, 4096)
+                << createEvent(0.6, EVENT_CONTROLLER, 7, 64)
+                << createEvent(0.7, EVENT_CONTROLLER, 10, 0)
+                << createEvent(0.9, EVENT_NOTE, 60, 0));
+
+    // Exclusive class: each note cuts the previous one
+    inst = addInstrument(sm, sf2Index, "exclusive class", -2400);
+    idInst.indexElt = inst;
+    setGen(sm, TestBank::addDivision(sm, idInst, tone60, 0, 63), champ_exclusiveClass, 1);
+    setGen(sm, TestBank::addDivision(sm, idInst, tone72, 64, 127), champ_exclusiveClass, 1);
+    addScenario(sm, sf2Index, inst, "exclusive_class", 1.2, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 100)
+                << createEvent(0.3, EVENT_NOTE, 72, 100)
+                << createEvent(0.6, EVENT_NOTE, 60, 100)
+                << createEvent(0.9, EVENT_NOTE, 60, 0)
+                << createEvent(0.9, EVENT_NOTE, 72, 0));
+
+    // Stereo samples
+    inst = addInstrument(sm, sf2Index, "stereo", -2400);
+    idInst.indexElt = inst;
+    setGen(sm, TestBank::addDivision(sm, idInst, left, 0, 127), champ_pan, -500);
+    setGen(sm, TestBank::addDivision(sm, idInst, right, 0, 127), champ_pan, 500);
+    addScenario(sm, sf2Index, inst, "stereo", 1.0, QList<Event>()
+                << createEvent(0, EVENT_NOTE, 60, 100)
+                << createEvent(0.6, EVENT_NOTE, 60, 0));
+
+    sm->endBulkLoad(sf2Index);
+    sm->clearNewEditing();
+    return sf2Index;
+}
+
+int AudioRegression::addSample(SoundfontManager * sm, int sf2Index, QString name, int key, int harmonicCount)
+{
+    // One second of harmonics, looped on an integer number of periods in the second half
+    QVector<float> vData = TestBank::createTone(440.0 * qPow(2.0, (key - 69) / 12.0), SAMPLE_RATE, harmonicCount);
+    return TestBank::addSample(sm, sf2Index, name, key, vData, SAMPLE_RATE / 2, SAMPLE_RATE / 2);
+}
+
+int AudioRegression::addInstrument(SoundfontManager * sm, int sf2Index, QString name, int releaseTime)
+{
+    // Looped samples with a release time
+    int instIndex = TestBank::addInstrument(sm, sf2Index, name);
+    setGen(sm, EltID(elementInst, sf2Index, instIndex), champ_releaseVolEnv, static_cast<qint16>(releaseTime));
+    return instIndex;
+}
+
+void AudioRegression::addScenario(SoundfontManager * sm, int sf2Index, int instIndex, QString name, double duration, QList<Event> events)
+{
+    // Preset using the instrument
+    Scenario scenario;
+    scenario.presetIndex = TestBank::addPreset(sm, sf2Index, name, _scenarios.count(), instIndex);
+    scenario.name = name;
+    scenario.length = static_cast<quint32>(duration * SAMPLE_RATE);
+    scenario.events = events;
+    _scenarios << scenario;
+}
+
+QString AudioRegression::checkMemoryLoading(SoundfontManager * sm)
+{
+    // Sample with a rate, a root key and a correction different from the default values
+    int sf2Index = sm->add(EltID(elementSf2));
+    sm->beginBulkLoad(sf2Index);
+    sm->set(EltID(elementSf2, sf2Index), champ_name, "Loading");
+    QVector<float> vData = TestBank::createTone(440.0 * qPow(2.0, -2.0 / 12.0), SAMPLE_RATE / 2, 3);
+    EltID idSmpl(elementSmpl, sf2Index, TestBank::addSample(sm, sf2Index, "tone 67", 67, vData, SAMPLE_RATE / 4, SAMPLE_RATE / 4));
+    AttributeValue value;
+    value.dwValue = 32000;
+    sm->set(idSmpl, champ_dwSampleRate, value);
+    value.cValue = 13;
+    sm->set(idSmpl, champ_chPitchCorrection, value);
+    sm->endBulkLoad(sf2Index);
+    sm->clearNewEditing();
+
+    // Save it and parse the file content from memory
+    QString error;
+    QByteArray data;
+    QTemporaryDir directory;
+    QString filePath = directory.path() + "/loading.sf2";
+    if (!directory.isValid())
+        error = "no temporary directory";
+    else if (!PolyphoneCore::save(sf2Index, filePath, QMap<QString, QVariant>(), error))
+        error = "the soundfont cannot be saved (" + error + ")";
+    else
+    {
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            data = file.readAll();
+            file.close();
+        }
+        else
+            error = "the soundfont cannot be read";
+    }
+    if (!error.isEmpty())
+    {
+        PolyphoneCore::close(sf2Index);
+        return error;
+    }
+
+    bool success = false;
+    int loadedIndex = -1;
+    InputParserSf2 parser;
+    parser.processData(data, sm, success, error, loadedIndex);
+    if (loadedIndex != -1)
+    {
+        sm->endBulkLoad(loadedIndex);
+        sm->clearNewEditing();
+    }
+
+    if (!success)
+        error = "the soundfont cannot be parsed (" + error + ")";
+    else
+    {
+        // Properties of the loaded sample
+        EltID idLoaded(elementSmpl, loadedIndex);
+        QList<int> sampleIndexes = sm->getSiblings(idLoaded);
+        if (sampleIndexes.count() != 1)
+            error = "1 sample expected, " + QString::number(sampleIndexes.count()) + " found";
+        else
+        {
+            idLoaded.indexElt = sampleIndexes[0];
+            if (sm->get(idLoaded, champ_dwSampleRate).dwValue != 32000)
+                error = "sample rate " + QString::number(sm->get(idLoaded, champ_dwSampleRate).dwValue) + " instead of 32000";
+            else if (sm->get(idLoaded, champ_byOriginalPitch).bValue != 67)
+                error = "root key " + QString::number(sm->get(idLoaded, champ_byOriginalPitch).bValue) + " instead of 67";
+            else if (sm->get(idLoaded, champ_chPitchCorrection).cValue != 13)
+                error = "correction " + QString::number(sm->get(idLoaded, champ_chPitchCorrection).cValue) + " instead of 13";
+            else if (sm->getData(idLoaded).size() != vData.size())
+                error = "the sample data has not been loaded";
+        }
+    }
+
+    if (loadedIndex != -1)
+        PolyphoneCore::close(loadedIndex);
+    PolyphoneCore::close(sf2Index);
+    return error;
+}
+
+AudioRegression::Event AudioRegression::createEvent(double time, EventType type, int number, int value, int channel)
+{
+    Event event;
+    event.position = static_cast<quint32>(time * SAMPLE_RATE);
+    event.type = type;
+    event.channel = channel;
+    event.number = number;
+    event.value = value;
+    return event;
+}
+
+double AudioRegression::render(Synth * synth, int sf2Index, const Scenario &scenario, QVector<float> &data, QString recordPath)
+{
+    // Initial state
+    _midiValues = DefaultMidiValues();
+    EltID idPrst(elementPrst, sf2Index, scenario.presetIndex);
+    if (!recordPath.isEmpty())
+        synth->startNewRecord(recordPath);
+
+    quint32 bufferNumber = (scenario.length + BUFFER_SIZE - 1) / BUFFER_SIZE;
+    data.resize(static_cast<int>(2 * bufferNumber * BUFFER_SIZE));
+    float dataL[BUFFER_SIZE];
+    float dataR[BUFFER_SIZE];
+    int eventIndex = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (quint32 i = 0; i < bufferNumber; i++)
+    {
+        // Events occurring before the end of the buffer
+        while (eventIndex < scenario.events.count() && scenario.events[eventIndex].position < (i + 1) * BUFFER_SIZE)
+        {
+            const Event &event = scenario.events[eventIndex++];
+            switch (event.type)
+            {
+            case EVENT_NOTE:
+                synth->play(idPrst, event.channel, event.number, event.value);
+                break;
+            case EVENT_CONTROLLER:
+                _midiValues.setControllerValue(event.channel, event.number, event.value);
+                break;
+            case EVENT_BEND:
+                _midiValues.setBendValue(event.channel, static_cast<float>(event.value) / 8192.0f);
+                break;
+            }
+        }
+
+        // Same channel order as the recorder
+        synth->readData(dataL, dataR, BUFFER_SIZE);
+        float * pData = data.data() + 2 * i * BUFFER_SIZE;
+        for (quint32 j = 0; j < BUFFER_SIZE; j++)
+        {
+            pData[2 * j] = dataR[j];
+            pData[2 * j + 1] = dataL[j];
+        }
+    }
+    double time = timer.nsecsElapsed() / 1000000.0;
+
+    if (!recordPath.isEmpty())
+        synth->endRecord();
+    synth->stop(true);
+
+    return time;
+}
+
+bool AudioRegression::readReference(QString filePath, QVector<float> &data)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QByteArray baData = file.readAll();
+    file.close();
+
+    // Stereo float data written by the synth
+    if (baData.size() < RECORD_HEADER_SIZE || !baData.startsWith("RIFF") || baData.mid(38, 4) != "data")
+        return false;
+    quint32 length = qFromLittleEndian<quint32>(baData.constData() + 42);
+    if (length > static_cast<quint32>(baData.size() - RECORD_HEADER_SIZE))
+        return false;
+
+    data.resize(static_cast<int>(length / 4));
+    const char * pData = baData.constData() + RECORD_HEADER_SIZE;
+    for (int i = 0; i < data.size(); i++)
+    {
+        quint32 value = qFromLittleEndian<quint32>(pData + 4 * i);
+        memcpy(data.data() + i, &value, 4);
+    }
+    return true;
+}
+
+double AudioRegression::getPeakError(const QVector<float> &data1, const QVector<float> &data2)
+{
+    double peak = 0;
+    for (int i = 0; i < data1.size(); i++)
+        peak = qMax(peak, static_cast<double>(qAbs(data1[i] - data2[i])));
+    return peak;
+}
+
+double AudioRegression::getSpectralDistance(const QVector<float> &data1, const QVector<float> &data2)
+{
+    // Log-spectral distance of the mono signals, averaged over consecutive frames
+    int frameNumber = data1.size() / 2 / SPECTRUM_SIZE;
+    if (frameNumber == 0)
+        return 0;
+
+    double total = 0;
+    QVector<float> frame1(SPECTRUM_SIZE), frame2(SPECTRUM_SIZE);
+    for (int i = 0; i < frameNumber; i++)
+    {
+        for (int j = 0; j < SPECTRUM_SIZE; j++)
+        {
+            int pos = 2 * (i * SPECTRUM_SIZE + j);
+            frame1[j] = 0.5f * (data1[pos] + data1[pos + 1]);
+            frame2[j] = 0.5f * (data2[pos] + data2[pos + 1]);
+        }
+        QVector<float> spectrum1 = SampleUtils::getFourierTransform(frame1);
+        QVector<float> spectrum2 = SampleUtils::getFourierTransform(frame2);
+
+        // Bins 100 dB under the maximum are not significant
+        float maxValue = 0;
+        for (int j = 0; j < spectrum2.size(); j++)
+            maxValue = qMax(maxValue, qMax(spectrum1[j], spectrum2[j]));
+        double noiseFloor = qMax(1e-5 * maxValue, 1e-12);
+
+        double sum = 0;
+        for (int j = 0; j < spectrum1.size(); j++)
+        {
+            double diff = 20.0 * log10((spectrum1[j] + noiseFloor) / (spectrum2[j] + noiseFloor));
+            sum += diff * diff;
+        }
+        total += qSqrt(sum / spectrum1.size());
+    }
+
+    return total / frameNumber;
+}
+
+void AudioRegression::writeLine(QString line)
+{
+    QTextStream out(stdout);
+    out << line << Qt::endl;
+}
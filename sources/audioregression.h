@@ -0,0 +1,98 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef AUDIOREGRESSION_H
+#define AUDIOREGRESSION_H
+
+#include "defaultmidivalues.h"
+#include "basetypes.h"
+#include <QStringList>
+#include <QVector>
+#include <QJsonObject>
+class Options;
+class SoundfontManager;
+class Synth;
+
+// Regression tests of the synth: scenarios are rendered offline and compared with reference renders
+// The soundfont is built in memory (envelopes, filters, modulators, loops, exclusive classes, stereo links)
+// so that the same input is used everywhere, only the references being stored in a directory
+class AudioRegression
+{
+public:
+    AudioRegression(Options * options);
+
+    /// Render all scenarios and either record the references or compare with them
+    /// The render time of each scenario is measured and possibly written in a JSON summary
+    /// Error codes:
+    /// 0: all scenarios match their reference (or all references have been recorded)
+    /// 1: the reference directory or the summary cannot be used
+    /// 5: at least one scenario differs from its reference, or a sample loaded from memory has lost its properties
+    int process();
+
+private:
+    enum EventType
+    {
+        EVENT_NOTE,       // Number is the key, value is the velocity (0 for a note off)
+        EVENT_CONTROLLER, // Number is the controller, value is its value
+        EVENT_BEND        // Value is from -8192 to 8191
+    };
+
+    struct Event
+    {
+        quint32 position; // Frame from which the event applies
+        EventType type;
+        int channel;
+        int number;
+        int value;
+    };
+
+    struct Scenario
+    {
+        QString name;
+        int presetIndex;
+        quint32 length; // Number of frames
+        QList<Event> events; // Sorted by position
+    };
+
+    Q_DISABLE_COPY(AudioRegression)
+
+    int createSoundfont(SoundfontManager * sm);
+    int addSample(SoundfontManager * sm, int sf2Index, QString name, int key, int harmonicCount);
+    int addInstrument(SoundfontManager * sm, int sf2Index, QString name, int releaseTime);
+    void addScenario(SoundfontManager * sm, int sf2Index, int instIndex, QString name, double duration, QList<Event> events);
+    QString checkMemoryLoading(SoundfontManager * sm);
+    static Event createEvent(double time, EventType type, int number, int value, int channel = 0);
+
+    double render(Synth * synth, int sf2Index, const Scenario &scenario, QVector<float> &data, QString recordPath);
+    bool readReference(QString filePath, QVector<float> &data);
+    static double getPeakError(const QVector<float> &data1, const QVector<float> &data2);
+    static double getSpectralDistance(const QVector<float> &data1, const QVector<float> &data2);
+    void writeLine(QString line);
+
+    Options * _options;
+    QList<Scenario> _scenarios;
+    DefaultMidiValues _midiValues;
+};
+
+#endif // AUDIOREGRESSION_H
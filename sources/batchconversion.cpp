@@ -0,0 +1,317 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "batchconversion.h"
+#include "options.h"
+#include "polyphonecore.h"
+#include "inputfactory.h"
+#include "soundfontmanager.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QSet>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+class RunnableBatchConversion: public QRunnable
+{
+public:
+    RunnableBatchConversion(BatchConversion * batch, BatchConversion::FileResult * result) : QRunnable(),
+        _batch(batch),
+        _result(result)
+    {}
+
+    void run() override
+    {
+        _batch->convertFile(_result);
+    }
+
+private:
+    BatchConversion * _batch;
+    BatchConversion::FileResult * _result;
+};
+
+BatchConversion::BatchConversion(Options * options) :
+    _options(options),
+    _processedCount(0)
+{}
+
+int BatchConversion::process()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Check the output directory, if specified
+    if (!_options->getOutputDirectory().isEmpty() && !QDir(_options->getOutputDirectory()).exists())
+    {
+        writeLine("The directory " + _options->getOutputDirectory() + " does not exist.");
+        return 1;
+    }
+
+    // List the files to convert
+    QStringList inputPaths;
+    foreach (QString arg, _options->getInputFiles())
+        addInputs(arg, inputPaths);
+    if (inputPaths.empty())
+    {
+        writeLine("No files to convert.");
+        return 1;
+    }
+
+    _results.resize(inputPaths.count());
+    for (int i = 0; i < inputPaths.count(); i++)
+    {
+        _results[i].inputPath = inputPaths[i];
+        _results[i].success = false;
+        _results[i].loadingTime = 0;
+        _results[i].savingTime = 0;
+    }
+    prepareOutputs();
+
+    // Singletons are created before the conversions start
+    PolyphoneCore::initialize();
+
+    // Convert the files
+    QThreadPool pool;
+    if (_options->jobNumber() > 0)
+        pool.setMaxThreadCount(_options->jobNumber());
+    writeLine("Converting " + QString::number(_results.count()) + " files with " +
+              QString::number(pool.maxThreadCount()) + " simultaneous conversions...");
+    for (int i = 0; i < _results.count(); i++)
+    {
+        FileResult * result = _results.data() + i;
+        if (result->error.isEmpty())
+            pool.start(new RunnableBatchConversion(this, result));
+        else
+        {
+            QMutexLocker locker(&_mutex);
+            writeLine("[" + QString::number(++_processedCount) + "/" + QString::number(_results.count()) + "] " +
+                      result->inputPath + ": " + result->error);
+        }
+    }
+    pool.waitForDone();
+
+    // Summary
+    int errorCount = 0;
+    foreach (FileResult result, _results)
+        if (!result.success)
+            errorCount++;
+    writeLine(QString::number(_results.count() - errorCount) + " files converted, " +
+              QString::number(errorCount) + " errors");
+
+    if (!_options->getSummaryFile().isEmpty() && !writeSummary(pool.maxThreadCount(), timer.elapsed()))
+    {
+        writeLine("Couldn't write the summary " + _options->getSummaryFile());
+        return 1;
+    }
+
+    // Destroy a singleton that has been silently created
+    SoundfontManager::kill();
+
+    return errorCount > 0 ? 5 : 0;
+}
+
+void BatchConversion::addInputs(QString arg, QStringList &inputPaths)
+{
+    QFileInfo fileInfo(arg);
+    QStringList paths;
+    if (fileInfo.isDir())
+    {
+        // All supported files in the directory and its sub-directories
+        QDirIterator it(arg, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            QString path = it.next();
+            if (InputFactory::isSuffixSupported(QFileInfo(path).suffix()))
+                paths << path;
+        }
+        paths.sort();
+    }
+    else if (fileInfo.fileName().contains('*') || fileInfo.fileName().contains('?') || fileInfo.fileName().contains('['))
+    {
+        // Wildcard pattern in the file name
+        QDir dir = fileInfo.dir();
+        foreach (QString fileName, dir.entryList(QStringList(fileInfo.fileName()), QDir::Files, QDir::Name))
+            if (InputFactory::isSuffixSupported(QFileInfo(fileName).suffix()))
+                paths << dir.filePath(fileName);
+    }
+    else if (fileInfo.isFile() && !InputFactory::isSuffixSupported(fileInfo.suffix()))
+    {
+        // List of files, one per line, relative paths being relative to the list
+        QFile file(arg);
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            QTextStream in(&file);
+            while (!in.atEnd())
+            {
+                QString line = in.readLine().trimmed();
+                if (!line.isEmpty() && !line.startsWith('#'))
+                    paths << (QFileInfo(line).isRelative() ? fileInfo.dir().filePath(line) : line);
+            }
+        }
+    }
+    else
+        paths << arg; // Errors are reported during the conversion
+
+    // Each file is converted only once
+    foreach (QString path, paths)
+    {
+        path = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+        if (!inputPaths.contains(path))
+            inputPaths << path;
+    }
+}
+
+void BatchConversion::prepareOutputs()
+{
+    // Outputs are computed before the conversions so that two inputs cannot write the same file
+    QSet<QString> outputPaths;
+    for (int i = 0; i < _results.count(); i++)
+    {
+        FileResult &result = _results[i];
+        QFileInfo inputFile(result.inputPath);
+        if (!inputFile.exists())
+        {
+            result.error = "The file does not exist.";
+            continue;
+        }
+        if (!InputFactory::isSuffixSupported(inputFile.suffix()))
+        {
+            result.error = "The file format is not supported.";
+            continue;
+        }
+
+        QString outputDirectory = _options->getOutputDirectory().isEmpty() ?
+                    inputFile.dir().absolutePath() : _options->getOutputDirectory();
+        if (!outputDirectory.endsWith('/'))
+            outputDirectory += '/';
+        result.outputPath = outputDirectory + inputFile.completeBaseName() + _options->getOutputExtension();
+
+        if (outputPaths.contains(result.outputPath.toLower()))
+            result.error = "The output " + result.outputPath + " is already used by another file.";
+        else if (QFileInfo::exists(result.outputPath) && _options->mode() != Options::MODE_CONVERSION_TO_SFZ)
+            result.error = "The file " + result.outputPath + " already exists.";
+        else
+            outputPaths << result.outputPath.toLower();
+    }
+}
+
+void BatchConversion::convertFile(FileResult * result)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Load the input file
+    QString error;
+    int sf2Index = PolyphoneCore::load(result->inputPath, error);
+    result->loadingTime = timer.elapsed();
+    if (sf2Index == -1)
+        result->error = "Couldn't load the file: " + error;
+    else
+    {
+        // The jobs share the undo history: none of the changes made while saving is recorded
+        SoundfontManager * sm = PolyphoneCore::soundfonts();
+        sm->beginBulkLoad(sf2Index);
+
+        // Options of the output
+        QMap<QString, QVariant> options;
+        switch (_options->mode())
+        {
+        case Options::MODE_CONVERSION_TO_SF3:
+            options["quality"] = _options->sf3Quality();
+            break;
+        case Options::MODE_CONVERSION_TO_SFZ:
+            options["prefix"] = _options->sfzPresetPrefix();
+            options["bankdir"] = _options->sfzOneDirPerBank();
+            options["gmsort"] = _options->sfzGeneralMidi();
+            break;
+        default:
+            break;
+        }
+
+        // Convert
+        timer.restart();
+        result->success = PolyphoneCore::save(sf2Index, result->outputPath, options, error);
+        result->savingTime = timer.elapsed();
+        if (!result->success)
+            result->error = "Couldn't create " + result->outputPath + ": " + error;
+
+        // Close the soundfont to release the memory, which also ends the bulk load
+        PolyphoneCore::close(sf2Index);
+    }
+
+    QMutexLocker locker(&_mutex);
+    writeLine("[" + QString::number(++_processedCount) + "/" + QString::number(_results.count()) + "] " +
+              result->inputPath + ": " + (result->success ?
+                                              "done (" + QString::number(result->loadingTime + result->savingTime) + " ms)" :
+                                              result->error));
+}
+
+bool BatchConversion::writeSummary(int jobNumber, qint64 totalTime)
+{
+    QJsonArray files;
+    int errorCount = 0;
+    foreach (FileResult result, _results)
+    {
+        QJsonObject file;
+        file["input"] = result.inputPath;
+        file["output"] = result.outputPath;
+        file["success"] = result.success;
+        file["error"] = result.error;
+        file["loading_time_ms"] = result.loadingTime;
+        file["saving_time_ms"] = result.savingTime;
+        files.append(file);
+
+        if (!result.success)
+            errorCount++;
+    }
+
+    QJsonObject summary;
+    summary["format"] = _options->getOutputExtension().mid(1);
+    summary["jobs"] = jobNumber;
+    summary["file_count"] = _results.count();
+    summary["success_count"] = _results.count() - errorCount;
+    summary["error_count"] = errorCount;
+    summary["total_time_ms"] = totalTime;
+    summary["files"] = files;
+
+    QFile file(_options->getSummaryFile());
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(QJsonDocument(summary).toJson());
+    file.close();
+    return true;
+}
+
+void BatchConversion::writeLine(QString line)
+{
+    QTextStream out(stdout);
+    out << line << Qt::endl;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef BATCHCONVERSION_H
+#define BATCHCONVERSION_H
+
+#include <QStringList>
+#include <QVector>
+#include <QMutex>
+class Options;
+
+// Conversion of many files in a single process, several files being converted at the same time
+// Input arguments can be files, directories (scanned recursively), wildcard patterns or lists of files (one path per line)
+class BatchConversion
+{
+public:
+    BatchConversion(Options * options);
+
+    /// Convert all files and possibly write a JSON summary
+    /// Error codes:
+    /// 0: all files have been converted
+    /// 1: no input files, the output directory does not exist or the summary cannot be written
+    /// 5: at least one file couldn't be converted
+    int process();
+
+private:
+    struct FileResult
+    {
+        QString inputPath;
+        QString outputPath;
+        bool success;
+        QString error;
+        qint64 loadingTime; // ms
+        qint64 savingTime; // ms
+    };
+
+    Q_DISABLE_COPY(BatchConversion)
+    friend class RunnableBatchConversion;
+
+    void addInputs(QString arg, QStringList &inputPaths);
+    void prepareOutputs();
+    void convertFile(FileResult * result);
+    bool writeSummary(int jobNumber, qint64 totalTime);
+    void writeLine(QString line);
+
+    Options * _options;
+    QVector<FileResult> _results;
+    QMutex _mutex;
+    int _processedCount;
+};
+
+#endif // BATCHCONVERSION_H
@@ -0,0 +1,460 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "benchmark.h"
+#include "testbank.h"
+#include "options.h"
+#include "polyphonecore.h"
+#include "soundfontmanager.h"
+#include "sampleutils.h"
+#include "synth.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QDateTime>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtMath>
+
+// Synthetic bank: looped tones spread over the keyboard, one instrument per division count
+static const quint32 SAMPLE_RATE = TestBank::SAMPLE_RATE;
+static const int SAMPLE_COUNT = 64;
+static const quint32 SAMPLE_LENGTH = 65536;
+static const int DIVISION_COUNTS[] = {1, 8, 32, 128};
+static const int DIVISION_COUNT_NUMBER = 4;
+
+// Rendering
+static const int BUFFER_SIZES[] = {64, 256, 1024};
+static const int BUFFER_SIZE_NUMBER = 3;
+static const int VOICE_COUNTS[] = {1, 16, 64, 256};
+static const int VOICE_COUNT_NUMBER = 4;
+static const quint32 RENDERING_LENGTH = 2 * SAMPLE_RATE; // Length of audio computed for each measure
+static const int NOTE_ON_NUMBER = 64;
+
+// DSP kernels
+static const quint32 DSP_LENGTH = 10 * SAMPLE_RATE;
+static const int DSP_REPETITIONS = 3; // The best time is kept
+
+Benchmark::Benchmark(Options * options) :
+    _options(options),
+    _failed(false)
+{}
+
+int Benchmark::process()
+{
+    QTemporaryDir directory;
+    if (!directory.isValid())
+    {
+        writeLine("Couldn't create a temporary directory.");
+        return 1;
+    }
+
+    TestBank::initialize();
+    SoundfontManager * sm = PolyphoneCore::soundfonts();
+
+    QJsonObject bank;
+    bank["sample_count"] = SAMPLE_COUNT;
+    bank["sample_length"] = static_cast<int>(SAMPLE_LENGTH);
+    bank["sample_rate"] = static_cast<int>(SAMPLE_RATE);
+    bank["instrument_count"] = DIVISION_COUNT_NUMBER;
+
+    QJsonObject results;
+    results["version"] = SOFT_VERSION;
+    results["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    results["threads"] = QThread::idealThreadCount();
+    results["bank"] = bank;
+
+    writeLine("Creating the synthetic bank...");
+    int sf2Index = createBank(sm);
+
+    writeLine("Measuring the saving...");
+    QStringList filePaths;
+    results["saving"] = measureSaving(sf2Index, directory.path(), filePaths);
+
+    writeLine("Measuring the rendering...");
+    results["rendering"] = measureRendering(sf2Index);
+
+    writeLine("Measuring the note-on latency...");
+    results["note_on"] = measureNoteOn(sf2Index);
+    PolyphoneCore::close(sf2Index);
+
+    writeLine("Measuring the DSP kernels...");
+    results["dsp"] = measureDsp();
+
+    writeLine("Measuring the loading...");
+    foreach (QString filePath, _options->getInputFiles())
+        filePaths << filePath;
+    results["loading"] = measureLoading(filePaths);
+
+    // Release the memory before the temporary directory is removed
+    SoundfontManager::kill();
+
+    if (!writeResults(QJsonDocument(results).toJson()))
+    {
+        writeLine("Couldn't write the results " + _options->getSummaryFile());
+        return 1;
+    }
+
+    return _failed ? 5 : 0;
+}
+
+int Benchmark::createBank(SoundfontManager * sm)
+{
+    int sf2Index = sm->add(EltID(elementSf2));
+    sm->beginBulkLoad(sf2Index);
+    sm->set(EltID(elementSf2, sf2Index), champ_name, "Benchmark");
+
+    // Samples, with a loop of an integer number of periods
+    quint32 seed = 1;
+    for (int i = 0; i < SAMPLE_COUNT; i++)
+    {
+        int key = 24 + i;
+        QVector<float> vData = TestBank::createTone(440.0 * qPow(2.0, (key - 69) / 12.0), SAMPLE_LENGTH, 4, &seed);
+        TestBank::addSample(sm, sf2Index, QString("tone %1").arg(key, 3, 10, QChar('0')), key, vData,
+                            SAMPLE_LENGTH / 4, SAMPLE_LENGTH / 2);
+    }
+
+    // Instruments splitting the keyboard in 1 to 128 divisions, and one preset for each of them
+    for (int i = 0; i < DIVISION_COUNT_NUMBER; i++)
+    {
+        int divisionCount = DIVISION_COUNTS[i];
+        QString name = QString("%1 division%2").arg(divisionCount).arg(divisionCount > 1 ? "s" : "");
+
+        EltID idInst(elementInst, sf2Index, TestBank::addInstrument(sm, sf2Index, name));
+        for (int j = 0; j < divisionCount; j++)
+            TestBank::addDivision(sm, idInst, j * SAMPLE_COUNT / divisionCount,
+                                  j * 128 / divisionCount, (j + 1) * 128 / divisionCount - 1);
+        TestBank::addPreset(sm, sf2Index, name, i, idInst.indexElt);
+    }
+
+    sm->endBulkLoad(sf2Index);
+    sm->clearNewEditing();
+    return sf2Index;
+}
+
+QJsonArray Benchmark::measureSaving(int sf2Index, QString directory, QStringList &savedFiles)
+{
+    QJsonArray results;
+    QStringList formats;
+    formats << "sf2" << "sf3" << "sfz";
+    foreach (QString format, formats)
+    {
+        // One directory per format, sfz exports being made of several files
+        QString formatDirectory = directory + "/" + format;
+        QDir().mkpath(formatDirectory);
+
+        QMap<QString, QVariant> options;
+        if (format == "sf3")
+            options["quality"] = 1;
+
+        QString error;
+        QElapsedTimer timer;
+        timer.start();
+        bool success = PolyphoneCore::save(sf2Index, formatDirectory + "/benchmark." + format, options, error);
+        double time = timer.nsecsElapsed() / 1000000.0;
+
+        // Size of everything written and file to load afterwards
+        qint64 size = 0;
+        QStringList files;
+        QDirIterator it(formatDirectory, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            QString path = it.next();
+            size += QFileInfo(path).size();
+            if (QFileInfo(path).suffix() == format)
+                files << path;
+        }
+        files.sort();
+        if (success && !files.isEmpty())
+            savedFiles << files[0];
+
+        QJsonObject result;
+        result["format"] = format;
+        result["success"] = success;
+        result["error"] = error;
+        result["time_ms"] = time;
+        result["size_bytes"] = size;
+        result["throughput_mb_s"] = time > 0 ? size / (1048.576 * time) : 0.0;
+        results.append(result);
+
+        if (!success)
+        {
+            writeLine("Couldn't save the " + format + " file: " + error);
+            _failed = true;
+        }
+    }
+
+    return results;
+}
+
+QJsonArray Benchmark::measureLoading(QStringList filePaths)
+{
+    QJsonArray results;
+    SoundfontManager * sm = PolyphoneCore::soundfonts();
+    foreach (QString filePath, filePaths)
+    {
+        resetPeakMemory();
+        qint64 memoryBefore = getMemory("VmRSS");
+
+        // Parsing, samples being possibly read when they are used
+        QString error;
+        QElapsedTimer timer;
+        timer.start();
+        int sf2Index = PolyphoneCore::load(filePath, error);
+        double loadingTime = timer.nsecsElapsed() / 1000000.0;
+
+        // Loading of all samples, as for the synthesizer
+        double sampleLoadingTime = 0;
+        if (sf2Index != -1)
+        {
+            timer.restart();
+            sm->loadAllSamples(sf2Index);
+            sampleLoadingTime = timer.nsecsElapsed() / 1000000.0;
+        }
+
+        qint64 peakMemory = getMemory("VmHWM");
+        PolyphoneCore::close(sf2Index);
+
+        QJsonObject result;
+        result["file"] = filePath;
+        result["format"] = QFileInfo(filePath).suffix().toLower();
+        result["success"] = sf2Index != -1;
+        result["error"] = error;
+        result["size_bytes"] = QFileInfo(filePath).size();
+        result["loading_time_ms"] = loadingTime;
+        result["sample_loading_time_ms"] = sampleLoadingTime;
+        result["peak_memory_kb"] = (peakMemory >= 0 && memoryBefore >= 0) ? peakMemory - memoryBefore : -1;
+        results.append(result);
+
+        if (sf2Index == -1)
+        {
+            writeLine("Couldn't load " + filePath + ": " + error);
+            _failed = true;
+        }
+    }
+
+    return results;
+}
+
+QJsonArray Benchmark::measureRendering(int sf2Index)
+{
+    SoundfontManager * sm = PolyphoneCore::soundfonts();
+    Synth synth(sm->getSoundfonts(), sm->getMutex());
+    TestBank::configureSynth(&synth, &_midiValues);
+
+    // Preset with one division per key: each voice uses the closest sample
+    EltID idPrst(elementPrst, sf2Index, DIVISION_COUNT_NUMBER - 1);
+
+    QJsonArray results;
+    QVector<float> dataL(BUFFER_SIZES[BUFFER_SIZE_NUMBER - 1]);
+    QVector<float> dataR(BUFFER_SIZES[BUFFER_SIZE_NUMBER - 1]);
+    for (int i = 0; i < BUFFER_SIZE_NUMBER; i++)
+    {
+        quint32 bufferSize = static_cast<quint32>(BUFFER_SIZES[i]);
+        synth.setSampleRateAndBufferSize(SAMPLE_RATE, bufferSize);
+        int bufferNumber = static_cast<int>(RENDERING_LENGTH / bufferSize);
+
+        for (int j = 0; j < VOICE_COUNT_NUMBER; j++)
+        {
+            // Sustained notes, several channels being used when there are more voices than keys
+            int voiceCount = VOICE_COUNTS[j];
+            for (int k = 0; k < voiceCount; k++)
+                synth.play(idPrst, k / 64, 32 + k % 64, 100);
+
+            // A few buffers are computed before the measure starts
+            for (int k = 0; k < 8; k++)
+                synth.readData(dataL.data(), dataR.data(), bufferSize);
+
+            QElapsedTimer timer;
+            timer.start();
+            for (int k = 0; k < bufferNumber; k++)
+                synth.readData(dataL.data(), dataR.data(), bufferSize);
+            double time = timer.nsecsElapsed() / 1000.0;
+            synth.stop(true);
+
+            QJsonObject result;
+            result["buffer_size"] = BUFFER_SIZES[i];
+            result["voices"] = voiceCount;
+            result["time_per_buffer_us"] = time / bufferNumber;
+            result["time_per_voice_us"] = time / bufferNumber / voiceCount;
+            result["realtime_ratio"] = time > 0 ? 1000000.0 * bufferNumber * bufferSize / SAMPLE_RATE / time : 0.0;
+            results.append(result);
+        }
+    }
+
+    return results;
+}
+
+QJsonArray Benchmark::measureNoteOn(int sf2Index)
+{
+    SoundfontManager * sm = PolyphoneCore::soundfonts();
+    Synth synth(sm->getSoundfonts(), sm->getMutex());
+    TestBank::configureSynth(&synth, &_midiValues);
+
+    quint32 bufferSize = static_cast<quint32>(BUFFER_SIZES[0]);
+    synth.setSampleRateAndBufferSize(SAMPLE_RATE, bufferSize);
+    QVector<float> dataL(static_cast<int>(bufferSize));
+    QVector<float> dataR(static_cast<int>(bufferSize));
+
+    QJsonArray results;
+    for (int i = 0; i < DIVISION_COUNT_NUMBER; i++)
+    {
+        // Time for finding the divisions and creating the voice, and time of the first buffer containing the note
+        EltID idPrst(elementPrst, sf2Index, i);
+        qint64 playTime = 0;
+        qint64 firstBufferTime = 0;
+        QElapsedTimer timer;
+        for (int j = 0; j < NOTE_ON_NUMBER; j++)
+        {
+            int key = 32 + j;
+            timer.start();
+            synth.play(idPrst, 0, key, 100);
+            playTime += timer.nsecsElapsed();
+            timer.start();
+            synth.readData(dataL.data(), dataR.data(), bufferSize);
+            firstBufferTime += timer.nsecsElapsed();
+            synth.play(idPrst, 0, key, 0);
+            synth.stop(true);
+        }
+
+        QJsonObject result;
+        result["divisions"] = DIVISION_COUNTS[i];
+        result["play_time_us"] = playTime / 1000.0 / NOTE_ON_NUMBER;
+        result["first_buffer_time_us"] = firstBufferTime / 1000.0 / NOTE_ON_NUMBER;
+        results.append(result);
+    }
+
+    return results;
+}
+
+QJsonArray Benchmark::measureDsp()
+{
+    quint32 seed = 1;
+    QVector<float> vData = TestBank::createTone(220.0, DSP_LENGTH, 4, &seed);
+    QVector<float> vLoop = TestBank::createTone(220.0, 2 * SAMPLE_RATE, 4, &seed);
+    QStringList kernels;
+    kernels << "resampleMono" << "bandFilter" << "getFourierTransform" << "loopStep1" << "correlation";
+
+    QJsonArray results;
+    foreach (QString kernel, kernels)
+    {
+        qint64 bestTime = -1;
+        int length = vData.size();
+        for (int i = 0; i < DSP_REPETITIONS; i++)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            if (kernel == "resampleMono")
+                SampleUtils::resampleMono(vData, SAMPLE_RATE, 48000);
+            else if (kernel == "bandFilter")
+                SampleUtils::bandFilter(vData, SAMPLE_RATE, 5000, 100, 4);
+            else if (kernel == "getFourierTransform")
+                SampleUtils::getFourierTransform(vData);
+            else if (kernel == "loopStep1")
+            {
+                quint32 loopStart = 0, loopEnd = 0, crossfade = 0;
+                SampleUtils::loopStep1(vLoop, SAMPLE_RATE, loopStart, loopEnd, crossfade);
+                length = vLoop.size();
+            }
+            else
+            {
+                // Same use as for the pitch detection
+                quint32 dMin;
+                SampleUtils::correlation(vData.constData(), 4000, SAMPLE_RATE, 20, 20000, dMin);
+                length = 4000;
+            }
+            qint64 time = timer.nsecsElapsed();
+            if (bestTime < 0 || time < bestTime)
+                bestTime = time;
+        }
+
+        QJsonObject result;
+        result["kernel"] = kernel;
+        result["samples"] = length;
+        result["time_ms"] = bestTime / 1000000.0;
+        result["msamples_per_second"] = bestTime > 0 ? 1000.0 * length / bestTime : 0.0;
+        results.append(result);
+    }
+
+    return results;
+}
+
+void Benchmark::resetPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    // The peak is then the current memory (Linux 4.0 and above)
+    QFile file("/proc/self/clear_refs");
+    if (file.open(QIODevice::WriteOnly))
+        file.write("5");
+#endif
+}
+
+qint64 Benchmark::getMemory(QString field)
+{
+    // Value in kB, or -1 if not available
+#ifdef Q_OS_LINUX
+    QFile file("/proc/self/status");
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream in(&file);
+        QString line;
+        while (in.readLineInto(&line))
+        {
+            if (line.startsWith(field + ":"))
+            {
+                bool ok;
+                qint64 value = line.mid(field.length() + 1).remove("kB").trimmed().toLongLong(&ok);
+                return ok ? value : -1;
+            }
+        }
+    }
+#else
+    Q_UNUSED(field)
+#endif
+    return -1;
+}
+
+bool Benchmark::writeResults(QByteArray json)
+{
+    if (_options->getSummaryFile().isEmpty())
+    {
+        QTextStream out(stdout);
+        out << json;
+        return true;
+    }
+
+    return TestBank::writeFile(_options->getSummaryFile(), json);
+}
+
+void Benchmark::writeLine(QString line)
+{
+    // Progress is written in the error output, the standard output possibly containing the results
+    QTextStream out(stderr);
+    out << line << Qt::endl;
+}
@@ -0,0 +1,69 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QStringList>
+#include <QJsonArray>
+#include "defaultmidivalues.h"
+class Options;
+class SoundfontManager;
+
+// Performance measures of the load, save, render and DSP hot paths
+// Everything runs on a synthetic bank generated in memory, other files to load can be added as inputs
+// The results are written as JSON for tracking regressions
+class Benchmark
+{
+public:
+    Benchmark(Options * options);
+
+    /// Run all measures and write the results in the file given with -l (or in the standard output)
+    /// Error codes:
+    /// 0: all measures have been done
+    /// 1: the temporary directory or the results cannot be written
+    /// 5: at least one file couldn't be saved or loaded
+    int process();
+
+private:
+    Q_DISABLE_COPY(Benchmark)
+
+    int createBank(SoundfontManager * sm);
+    QJsonArray measureSaving(int sf2Index, QString directory, QStringList &savedFiles);
+    QJsonArray measureLoading(QStringList filePaths);
+    QJsonArray measureRendering(int sf2Index);
+    QJsonArray measureNoteOn(int sf2Index);
+    QJsonArray measureDsp();
+    bool writeResults(QByteArray json);
+    void writeLine(QString line);
+
+    static void resetPeakMemory();
+    static qint64 getMemory(QString field);
+
+    Options * _options;
+    DefaultMidiValues _midiValues;
+    bool _failed;
+};
+
+#endif // BENCHMARK_H
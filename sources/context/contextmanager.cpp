@@ -45,7 +45,7 @@ KeyNameManager * ContextManager::keyName()
 {
     if (s_instance == nullptr)
         s_instance = new ContextManager();
-    return s_instance->_keyName;
+    return KeyNameManager::getInstance();
 }
 
 RecentFileManager * ContextManager::recentFile()
@@ -91,7 +91,6 @@ void ContextManager::kill()
 
 ContextManager::ContextManager(bool withAudioAndMidi) :
     _configuration(nullptr),
-    _keyName(nullptr),
     _recentFile(nullptr),
     _theme(nullptr),
     _translation(nullptr),
@@ -110,7 +109,8 @@ ContextManager::ContextManager(bool withAudioAndMidi) :
     _recentFile = new RecentFileManager(_configuration);
 
     // 4. Key names
-    _keyName = new KeyNameManager(_configuration);
+    KeyNameManager::getInstance()->setMiddleKey(static_cast<KeyNameManager::NameMiddleC>(
+        _configuration->getValue(ConfManager::SECTION_DISPLAY, "name_middle_c", 0).toInt()));
 
     // 5. Translations
     _translation = new TranslationManager(_configuration);
@@ -134,7 +134,7 @@ ContextManager::~ContextManager()
     delete _midi;
     delete _audio;
     delete _translation;
-    delete _keyName;
+    KeyNameManager::kill();
     delete _recentFile;
     delete _theme;
     delete _configuration;
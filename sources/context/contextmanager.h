@@ -76,7 +76,6 @@ private:
     static ContextManager * s_instance;
 
     ConfManager * _configuration;
-    KeyNameManager * _keyName;
     RecentFileManager * _recentFile;
     ThemeManager * _theme;
     TranslationManager * _translation;
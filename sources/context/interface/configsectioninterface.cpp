@@ -312,6 +312,7 @@ void ConfigSectionInterface::on_comboLangue_currentIndexChanged(int index)
 void ConfigSectionInterface::on_comboKeyName_currentIndexChanged(int index)
 {
     ContextManager::keyName()->setMiddleKey((KeyNameManager::NameMiddleC)index);
+    ContextManager::configuration()->setValue(ConfManager::SECTION_DISPLAY, "name_middle_c", index);
     ui->labelRestart->show();
 }
 
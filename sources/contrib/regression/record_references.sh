@@ -0,0 +1,22 @@
+#!/bin/sh
+# Record the reference renders of the regression tests (polyphone -g).
+# The references are rendered by the synthesizer as it was when the regression
+# mode was added, before any change of the audio engine.
+#
+# Usage: contrib/regression/record_references.sh [REFERENCE_COMMIT]
+# Run from the "sources" directory, with qmake and the build dependencies installed.
+
+set -e
+
+REFERENCE_COMMIT=${1:-bdf11d3}
+SOURCE_DIR=$(pwd)
+REFERENCE_DIR="$SOURCE_DIR/contrib/regression/references"
+WORK_DIR=$(mktemp -d)
+
+git worktree add --detach "$WORK_DIR" "$REFERENCE_COMMIT"
+trap 'git worktree remove --force "$WORK_DIR"' EXIT
+
+cd "$WORK_DIR/sources"
+qmake
+make -j"$(nproc)"
+./bin/polyphone -g -d "$REFERENCE_DIR" -c record
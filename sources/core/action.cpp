@@ -24,7 +24,15 @@
 
 #include "action.h"
 
-Action::Action()
+Action::Action() :
+    removedDataSize(0)
 {
 
 }
+
+qint64 Action::getMemorySize() const
+{
+    return static_cast<qint64>(sizeof(Action)) +
+            static_cast<qint64>(qNewValue.size() + qOldValue.size()) * static_cast<qint64>(sizeof(QChar)) +
+            sampleDelta.getMemorySize() + removedDataSize;
+}
@@ -26,12 +26,16 @@
 #define ACTION_H
 
 #include "basetypes.h"
+#include "sampledelta.h"
 
 class Action
 {
 public:
     Action();
 
+    /// Approximate memory used by the action, in bytes
+    qint64 getMemorySize() const;
+
     // Type of action
     typedef enum
     {
@@ -51,8 +55,8 @@ public:
     QString qOldValue;
     AttributeValue vNewValue;
     AttributeValue vOldValue;
-    QVector<float> fNewValue;
-    QVector<float> fOldValue;
+    SampleDelta sampleDelta; // Sample data of the other version (previous one, or next one after an undo)
+    qint64 removedDataSize; // Sample data of a removed element, kept in memory until the action is dropped
 };
 
 #endif // ACTION_H
@@ -27,7 +27,11 @@
 #include "action.h"
 #include <QMap>
 
-ActionManager::ActionManager() {}
+static const qint64 DEFAULT_MEMORY_BUDGET = 512LL * 1024 * 1024;
+
+ActionManager::ActionManager() :
+    _memoryBudget(DEFAULT_MEMORY_BUDGET)
+{}
 
 ActionManager::~ActionManager()
 {
@@ -67,6 +71,9 @@ QList<int> ActionManager::commitActionSet()
         _actionSets[sf2Index]->addActions(actionsPerSoundfont[sf2Index]);
     }
 
+    // Keep the undo within the memory budget
+    this->limitMemory();
+
     return actionsPerSoundfont.keys();
 }
 
@@ -118,3 +125,42 @@ void ActionManager::dropSoundfont(int sf2Index)
     if (_actionSets.contains(sf2Index))
         delete _actionSets.take(sf2Index);
 }
+
+void ActionManager::setMemoryBudget(qint64 bytes)
+{
+    _memoryBudget = bytes;
+    this->limitMemory();
+}
+
+void ActionManager::limitMemory()
+{
+    // Memory used per soundfont
+    QMap<int, qint64> sizes;
+    qint64 total = 0;
+    foreach (int sf2Index, _actionSets.keys())
+    {
+        sizes[sf2Index] = _actionSets[sf2Index]->getMemorySize();
+        total += sizes[sf2Index];
+    }
+
+    // Remove the oldest undo of the soundfont using the most memory, then its furthest redo
+    while (total > _memoryBudget && !sizes.isEmpty())
+    {
+        int sf2Index = sizes.firstKey();
+        foreach (int key, sizes.keys())
+            if (sizes[key] > sizes[sf2Index])
+                sf2Index = key;
+
+        if (_actionSets[sf2Index]->dropOldestUndo() || _actionSets[sf2Index]->dropOldestRedo())
+        {
+            qint64 size = _actionSets[sf2Index]->getMemorySize();
+            total -= sizes[sf2Index] - size;
+            sizes[sf2Index] = size;
+        }
+        else
+        {
+            // Nothing more can be removed for this soundfont
+            total -= sizes.take(sf2Index);
+        }
+    }
+}
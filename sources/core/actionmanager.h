@@ -70,16 +70,24 @@ public:
     /// When a soundfont is closed, free all actions associated to it
     void dropSoundfont(int sf2Index);
 
+    /// Memory that can be used by the undo / redo of all soundfonts, in bytes (512 MB by default)
+    void setMemoryBudget(qint64 bytes);
+
 signals:
     /// Emitted when an ID must be definitely removed
     void dropId(EltID id);
 
 private:
+    // Delete the oldest undo, and then the furthest redo, until the memory used by all soundfonts fits in the budget
+    void limitMemory();
+
     // Current list of actions that are occurring
     QList<Action *> _currentActions;
 
     // Redo / undo and latest edition per soundfont
     QMap<int, ActionSet *> _actionSets;
+
+    qint64 _memoryBudget;
 };
 
 #endif // PILE_ACTIONS_H
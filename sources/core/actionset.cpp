@@ -28,7 +28,8 @@
 const int ActionSet::UNDO_NUMBER = 50;
 
 ActionSet::ActionSet() :
-    _latestEdition(0)
+    _latestEdition(0),
+    _memorySize(0)
 {
 
 }
@@ -63,8 +64,10 @@ void ActionSet::addActions(QList<Action *> actions)
     // Increment the edition and store it along with the action list
     _latestEdition++;
     _undoActions.insert(0, QPair<int, QList<Action *> >(_latestEdition, actions));
+    _memorySizes[_latestEdition] = computeMemorySize(actions);
+    _memorySize += _memorySizes[_latestEdition];
 
-    // Finally, clean the undo so that they are not unlimited
+    // Limit the number of undo
     this->cleanUndo();
 }
 
@@ -91,8 +94,9 @@ QList<Action *> ActionSet::undo()
     if (_undoActions.empty())
         return QList<Action *>();
 
-    // An undo become a redo
+    // An undo become a redo, its sample data being then swapped
     _redoActions.insert(0, _undoActions.takeFirst());
+    _outdatedMemorySizes << _redoActions.first().first;
 
     // Return the first redo
     return _redoActions.first().second;
@@ -103,45 +107,98 @@ QList<Action *> ActionSet::redo()
     if (_redoActions.empty())
         return QList<Action *>();
 
-    // A redo become an undo
+    // A redo become an undo, its sample data being then swapped
     _undoActions.insert(0, _redoActions.takeFirst());
+    _outdatedMemorySizes << _undoActions.first().first;
 
     // Return the first undo
     return _undoActions.first().second;
 }
 
-void ActionSet::clearRedo()
+qint64 ActionSet::getMemorySize()
 {
-    while (!_redoActions.empty())
+    // Update the size of the editions that have been swapped
+    while (!_outdatedMemorySizes.isEmpty())
     {
-        QPair<int, QList<Action *> > item = _redoActions.takeLast(); // Reverse order
-        while (!item.second.empty())
-        {
-            Action * actionToDelete = item.second.takeFirst(); // Normal order
+        int edition = _outdatedMemorySizes.takeFirst();
+        if (!_memorySizes.contains(edition))
+            continue; // Deleted in the meantime
 
-            // Definitely delete an element that has been created and then deleted
-            if (actionToDelete->typeAction == Action::TypeCreation)
-                emit(dropId(actionToDelete->id));
-
-            delete actionToDelete;
+        // Recent editions are at the beginning of the lists
+        for (int i = 0; i < _undoActions.count() + _redoActions.count(); i++)
+        {
+            const QPair<int, QList<Action *> > &item = i < _undoActions.count() ?
+                        _undoActions[i] : _redoActions[i - _undoActions.count()];
+            if (item.first == edition)
+            {
+                qint64 size = computeMemorySize(item.second);
+                _memorySize += size - _memorySizes[edition];
+                _memorySizes[edition] = size;
+                break;
+            }
         }
     }
+
+    return _memorySize;
+}
+
+qint64 ActionSet::computeMemorySize(const QList<Action *> &actions)
+{
+    qint64 result = 0;
+    foreach (Action * action, actions)
+        result += action->getMemorySize();
+    return result;
+}
+
+void ActionSet::clearRedo()
+{
+    while (this->dropOldestRedo());
 }
 
 void ActionSet::cleanUndo()
 {
     while (_undoActions.count() > UNDO_NUMBER)
+        this->dropOldestUndo();
+}
+
+bool ActionSet::dropOldestUndo()
+{
+    if (_undoActions.count() < 2)
+        return false;
+
+    QPair<int, QList<Action *> > item = _undoActions.takeLast(); // Reverse order
+    _memorySize -= _memorySizes.take(item.first);
+    while (!item.second.empty())
     {
-        QPair<int, QList<Action *> > item = _undoActions.takeLast(); // Reverse order
-        while (!item.second.empty())
-        {
-            Action * actionToDelete = item.second.takeLast(); // Reverse order
+        Action * actionToDelete = item.second.takeLast(); // Reverse order
 
-            // Definitely delete an element that has been deleted a long time ago
-            if (actionToDelete->typeAction == Action::TypeRemoval)
-                emit(dropId(actionToDelete->id));
+        // Definitely delete an element that has been deleted a long time ago
+        if (actionToDelete->typeAction == Action::TypeRemoval)
+            emit(dropId(actionToDelete->id));
 
-            delete actionToDelete;
-        }
+        delete actionToDelete;
+    }
+
+    return true;
+}
+
+bool ActionSet::dropOldestRedo()
+{
+    if (_redoActions.empty())
+        return false;
+
+    QPair<int, QList<Action *> > item = _redoActions.takeLast(); // Reverse order
+    _memorySize -= _memorySizes.take(item.first);
+    while (!item.second.empty())
+    {
+        Action * actionToDelete = item.second.takeFirst(); // Normal order
+
+        // Definitely delete an element that has been created and then deleted
+        if (actionToDelete->typeAction == Action::TypeCreation)
+            emit(dropId(actionToDelete->id));
+
+        delete actionToDelete;
     }
+
+    return true;
 }
@@ -26,6 +26,7 @@
 #define ACTIONSET_H
 
 #include <QList>
+#include <QMap>
 #include <QObject>
 #include "basetypes.h"
 class Action;
@@ -56,18 +57,33 @@ public:
     /// Perform a redo and get the list of actions to compute
     QList<Action *> redo();
 
+    /// Approximate memory used by all undo and redo, in bytes
+    /// The size of each edition is stored, only the editions swapped by an undo or a redo being computed again
+    qint64 getMemorySize();
+
+    /// Definitely delete the oldest undo, the latest one being always kept
+    /// Return false if nothing has been deleted
+    bool dropOldestUndo();
+
+    /// Definitely delete the redo that is the furthest from the current edition
+    /// Return false if nothing has been deleted
+    bool dropOldestRedo();
+
 signals:
     void dropId(EltID id);
 
 private:
     void clearRedo();
     void cleanUndo();
-
-    static const int UNDO_NUMBER;
+    static qint64 computeMemorySize(const QList<Action *> &actions);
 
     QList<QPair<int, QList<Action *> > > _redoActions;
     QList<QPair<int, QList<Action *> > > _undoActions;
     int _latestEdition;
+    QMap<int, qint64> _memorySizes; // Per edition
+    QList<int> _outdatedMemorySizes; // Editions whose sample data has been swapped
+    qint64 _memorySize;
+    static const int UNDO_NUMBER;
 };
 
 #endif // ACTIONSET_H
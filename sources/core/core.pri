@@ -0,0 +1,262 @@
+# Engine of Polyphone: model, inputs / outputs, samples and synth
+# Only QtCore is required, the file being included by polyphone.pro and polyphone-core.pro
+
+# Location of Stk
+contains(DEFINES, USE_LOCAL_STK) {
+    INCLUDEPATH += $$PWD/../lib/_option_stk
+    HEADERS += $$PWD/../lib/_option_stk/stk/Stk.h \
+        $$PWD/../lib/_option_stk/stk/SineWave.h \
+        $$PWD/../lib/_option_stk/stk/OnePole.h \
+        $$PWD/../lib/_option_stk/stk/Generator.h \
+        $$PWD/../lib/_option_stk/stk/Filter.h \
+        $$PWD/../lib/_option_stk/stk/Effect.h \
+        $$PWD/../lib/_option_stk/stk/Delay.h \
+        $$PWD/../lib/_option_stk/stk/Chorus.h \
+        $$PWD/../lib/_option_stk/stk/FreeVerb.h \
+        $$PWD/../lib/_option_stk/stk/DelayL.h \
+        $$PWD/../lib/_option_stk/stk/Iir.h
+    SOURCES += $$PWD/../lib/_option_stk/stk/Stk.cpp \
+        $$PWD/../lib/_option_stk/stk/SineWave.cpp \
+        $$PWD/../lib/_option_stk/stk/OnePole.cpp \
+        $$PWD/../lib/_option_stk/stk/Delay.cpp \
+        $$PWD/../lib/_option_stk/stk/Chorus.cpp \
+        $$PWD/../lib/_option_stk/stk/FreeVerb.cpp \
+        $$PWD/../lib/_option_stk/stk/DelayL.cpp \
+        $$PWD/../lib/_option_stk/stk/Iir.cpp
+} else {
+    LIBS += -lstk
+}
+
+INCLUDEPATH += $$PWD/../lib \
+    $$PWD \
+    $$PWD/input \
+    $$PWD/output \
+    $$PWD/model \
+    $$PWD/sample \
+    $$PWD/types \
+    $$PWD/../sound_engine \
+    $$PWD/../sound_engine/elements
+
+SOURCES += $$PWD/input/grandorgue/grandorguedatathrough.cpp \
+    $$PWD/input/grandorgue/grandorgueranklink.cpp \
+    $$PWD/input/grandorgue/grandorgueswitch.cpp \
+    $$PWD/input/sfz/sfzparametergroup.cpp \
+    $$PWD/input/sfz/sfzparameterregion.cpp \
+    $$PWD/input/sfz/sfzsampleindex.cpp \
+    $$PWD/output/sfz/balanceparameters.cpp \
+    $$PWD/output/sfz/sfzwriter.cpp \
+    $$PWD/sample/samplereaderogg.cpp \
+    $$PWD/solomanager.cpp \
+    $$PWD/input/abstractinputparser.cpp \
+    $$PWD/input/empty/inputparserempty.cpp \
+    $$PWD/input/grandorgue/grandorguepipe.cpp \
+    $$PWD/input/grandorgue/grandorguerank.cpp \
+    $$PWD/input/grandorgue/grandorguestop.cpp \
+    $$PWD/input/grandorgue/inputgrandorgue.cpp \
+    $$PWD/input/grandorgue/inputparsergrandorgue.cpp \
+    $$PWD/input/not_supported/inputparsernotsupported.cpp \
+    $$PWD/input/sf2/inputparsersf2.cpp \
+    $$PWD/input/sf2/inputsf2.cpp \
+    $$PWD/input/sf3/inputparsersf3.cpp \
+    $$PWD/input/sf3/inputsf3.cpp \
+    $$PWD/input/sfark/inputparsersfark.cpp \
+    $$PWD/input/sfark/inputsfark.cpp \
+    $$PWD/input/sfz/inputparsersfz.cpp \
+    $$PWD/input/sfz/inputsfz.cpp \
+    $$PWD/sample/samplereaderfactory.cpp \
+    $$PWD/sample/samplereaderflac.cpp \
+    $$PWD/sample/samplereadersf2.cpp \
+    $$PWD/sample/samplereaderwav.cpp \
+    $$PWD/sample/sampleutils.cpp \
+    $$PWD/sample/fouriertransform.cpp \
+    $$PWD/sample/firfilter.cpp \
+    $$PWD/sample/resampler.cpp \
+    $$PWD/sample/loopfinder.cpp \
+    $$PWD/sample/sampledelta.cpp \
+    $$PWD/sample/sampleedition.cpp \
+    $$PWD/sample/samplewriterwav.cpp \
+    $$PWD/sample/sound.cpp \
+    $$PWD/types/serializabletypes.cpp \
+    $$PWD/utils.cpp \
+    $$PWD/input/sfark/sfarkglobal.cpp \
+    $$PWD/input/sfark/sfarkfilemanager.cpp \
+    $$PWD/output/sfz/conversion_sfz.cpp \
+    $$PWD/keynamemanager.cpp \
+    $$PWD/../sound_engine/elements/liveeq.cpp \
+    $$PWD/../sound_engine/elements/osctriangle.cpp \
+    $$PWD/../sound_engine/modulatedparameter.cpp \
+    $$PWD/../sound_engine/synth.cpp \
+    $$PWD/../sound_engine/voice.cpp \
+    $$PWD/../sound_engine/voiceparam.cpp \
+    $$PWD/../sound_engine/soundengine.cpp \
+    $$PWD/../sound_engine/elements/calibrationsinus.cpp \
+    $$PWD/../sound_engine/elements/enveloppevol.cpp \
+    $$PWD/../sound_engine/elements/oscsinus.cpp \
+    $$PWD/../lib/sf3/sfont.cpp \
+    $$PWD/types/idlist.cpp \
+    $$PWD/soundfontmanager.cpp \
+    $$PWD/actionmanager.cpp \
+    $$PWD/model/soundfont.cpp \
+    $$PWD/model/division.cpp \
+    $$PWD/model/smpl.cpp \
+    $$PWD/model/instprst.cpp \
+    $$PWD/model/soundfonts.cpp \
+    $$PWD/model/treemodel.cpp \
+    $$PWD/model/treeitemfirstlevel.cpp \
+    $$PWD/model/treeitemroot.cpp \
+    $$PWD/model/treeitem.cpp \
+    $$PWD/actionset.cpp \
+    $$PWD/action.cpp \
+    $$PWD/input/inputfactory.cpp \
+    $$PWD/input/sf2/sf2header.cpp \
+    $$PWD/input/sf2/sf2sdtapart.cpp \
+    $$PWD/input/sf2/sf2pdtapart.cpp \
+    $$PWD/input/sf2/sf2pdtapart_phdr.cpp \
+    $$PWD/input/sf2/sf2pdtapart_inst.cpp \
+    $$PWD/input/sf2/sf2pdtapart_shdr.cpp \
+    $$PWD/input/sf2/sf2pdtapart_mod.cpp \
+    $$PWD/input/sf2/sf2pdtapart_gen.cpp \
+    $$PWD/input/sf2/sf2pdtapart_bag.cpp \
+    $$PWD/types/eltid.cpp \
+    $$PWD/types/attribute.cpp \
+    $$PWD/output/abstractoutput.cpp \
+    $$PWD/output/outputfactory.cpp \
+    $$PWD/output/empty/outputdummy.cpp \
+    $$PWD/output/sf2/outputsf2.cpp \
+    $$PWD/output/sfz/outputsfz.cpp \
+    $$PWD/output/not_supported/outputnotsupported.cpp \
+    $$PWD/output/sfz/sfzparamlist.cpp \
+    $$PWD/output/sf2/sf2indexconverter.cpp \
+    $$PWD/output/sf3/outputsf3.cpp \
+    $$PWD/input/sfz/sfzparameter.cpp \
+    $$PWD/../lib/iir/Biquad.cpp \
+    $$PWD/../lib/iir/Butterworth.cpp \
+    $$PWD/../lib/iir/Cascade.cpp \
+    $$PWD/../lib/iir/PoleFilter.cpp \
+    $$PWD/../lib/iir/State.cpp \
+    $$PWD/../sound_engine/parametermodulator.cpp \
+    $$PWD/../sound_engine/modulatorgroup.cpp \
+    $$PWD/../sound_engine/defaultmidivalues.cpp \
+    $$PWD/types/modulatordata.cpp \
+    $$PWD/input/sfark/sfarkextractor1.cpp \
+    $$PWD/input/sfark/sfarkextractor2.cpp \
+    $$PWD/polyphonecore.cpp
+
+HEADERS += $$PWD/input/grandorgue/grandorguedatathrough.h \
+    $$PWD/input/grandorgue/grandorgueranklink.h \
+    $$PWD/input/grandorgue/grandorgueswitch.h \
+    $$PWD/input/sfz/sfzparametergroup.h \
+    $$PWD/input/sfz/sfzparameterregion.h \
+    $$PWD/input/sfz/sfzsampleindex.h \
+    $$PWD/output/sfz/balanceparameters.h \
+    $$PWD/output/sfz/sfzwriter.h \
+    $$PWD/sample/samplereaderogg.h \
+    $$PWD/solomanager.h \
+    $$PWD/input/abstractinput.h \
+    $$PWD/input/abstractinputparser.h \
+    $$PWD/input/empty/inputparserempty.h \
+    $$PWD/input/grandorgue/grandorguepipe.h \
+    $$PWD/input/grandorgue/grandorguerank.h \
+    $$PWD/input/grandorgue/grandorguestop.h \
+    $$PWD/input/grandorgue/inputgrandorgue.h \
+    $$PWD/input/grandorgue/inputparsergrandorgue.h \
+    $$PWD/input/not_supported/inputparsernotsupported.h \
+    $$PWD/input/sf2/inputparsersf2.h \
+    $$PWD/input/sf2/inputsf2.h \
+    $$PWD/input/sf3/inputparsersf3.h \
+    $$PWD/input/sf3/inputsf3.h \
+    $$PWD/input/sfark/inputparsersfark.h \
+    $$PWD/input/sfark/inputsfark.h \
+    $$PWD/input/sfz/inputparsersfz.h \
+    $$PWD/input/sfz/inputsfz.h \
+    $$PWD/sample/infosound.h \
+    $$PWD/sample/samplereader.h \
+    $$PWD/sample/samplereaderfactory.h \
+    $$PWD/sample/samplereaderflac.h \
+    $$PWD/sample/samplereadersf2.h \
+    $$PWD/sample/samplereaderwav.h \
+    $$PWD/sample/sampleutils.h \
+    $$PWD/sample/fouriertransform.h \
+    $$PWD/sample/firfilter.h \
+    $$PWD/sample/resampler.h \
+    $$PWD/sample/loopfinder.h \
+    $$PWD/sample/sampledelta.h \
+    $$PWD/sample/sampleedition.h \
+    $$PWD/sample/samplewriterwav.h \
+    $$PWD/sample/sound.h \
+    $$PWD/types/serializabletypes.h \
+    $$PWD/utils.h \
+    $$PWD/input/sfark/sfarkglobal.h \
+    $$PWD/input/sfark/sfarkfilemanager.h \
+    $$PWD/input/sfark/sfarkextractor1.h \
+    $$PWD/output/sfz/conversion_sfz.h \
+    $$PWD/keynamemanager.h \
+    $$PWD/../sound_engine/elements/liveeq.h \
+    $$PWD/../sound_engine/elements/osctriangle.h \
+    $$PWD/../sound_engine/imidivalues.h \
+    $$PWD/../sound_engine/modulatedparameter.h \
+    $$PWD/../sound_engine/synth.h \
+    $$PWD/../sound_engine/voice.h \
+    $$PWD/../sound_engine/voiceparam.h \
+    $$PWD/../sound_engine/soundengine.h \
+    $$PWD/../sound_engine/elements/calibrationsinus.h \
+    $$PWD/../sound_engine/elements/enveloppevol.h \
+    $$PWD/../sound_engine/elements/oscsinus.h \
+    $$PWD/../lib/sf3/sfont.h \
+    $$PWD/types/idlist.h \
+    $$PWD/soundfontmanager.h \
+    $$PWD/actionmanager.h \
+    $$PWD/model/soundfont.h \
+    $$PWD/model/division.h \
+    $$PWD/model/modulator.h \
+    $$PWD/model/smpl.h \
+    $$PWD/model/instprst.h \
+    $$PWD/model/soundfonts.h \
+    $$PWD/model/treeitem.h \
+    $$PWD/model/treemodel.h \
+    $$PWD/model/treeitemfirstlevel.h \
+    $$PWD/model/treeitemroot.h \
+    $$PWD/actionset.h \
+    $$PWD/action.h \
+    $$PWD/input/inputfactory.h \
+    $$PWD/input/sf2/sf2header.h \
+    $$PWD/input/sf2/sf2sdtapart.h \
+    $$PWD/input/sf2/sf2pdtapart.h \
+    $$PWD/input/sf2/sf2pdtapart_phdr.h \
+    $$PWD/input/sf2/sf2pdtapart_inst.h \
+    $$PWD/input/sf2/sf2pdtapart_shdr.h \
+    $$PWD/input/sf2/sf2pdtapart_mod.h \
+    $$PWD/input/sf2/sf2pdtapart_gen.h \
+    $$PWD/input/sf2/sf2pdtapart_bag.h \
+    $$PWD/types/eltid.h \
+    $$PWD/types/complex.h \
+    $$PWD/types/attribute.h \
+    $$PWD/types/basetypes.h \
+    $$PWD/output/abstractoutput.h \
+    $$PWD/output/outputfactory.h \
+    $$PWD/output/empty/outputdummy.h \
+    $$PWD/output/sf2/outputsf2.h \
+    $$PWD/output/sfz/outputsfz.h \
+    $$PWD/output/not_supported/outputnotsupported.h \
+    $$PWD/output/sfz/sfzparamlist.h \
+    $$PWD/output/sf2/sf2indexconverter.h \
+    $$PWD/output/sf3/outputsf3.h \
+    $$PWD/input/sfz/sfzparameter.h \
+    $$PWD/types/indexedelementlist.h \
+    $$PWD/../lib/iir/Iir_2.h \
+    $$PWD/../lib/iir/Biquad.h \
+    $$PWD/../lib/iir/Butterworth.h \
+    $$PWD/../lib/iir/Cascade.h \
+    $$PWD/../lib/iir/Common.h \
+    $$PWD/../lib/iir/Layout.h \
+    $$PWD/../lib/iir/MathSupplement.h \
+    $$PWD/../lib/iir/PoleFilter.h \
+    $$PWD/../lib/iir/State.h \
+    $$PWD/../lib/iir/Types.h \
+    $$PWD/../sound_engine/parametermodulator.h \
+    $$PWD/../sound_engine/modulatorgroup.h \
+    $$PWD/../sound_engine/defaultmidivalues.h \
+    $$PWD/types/modulatordata.h \
+    $$PWD/input/sfark/sfarkextractor2.h \
+    $$PWD/input/sfark/abstractextractor.h \
+    $$PWD/polyphonecore.h
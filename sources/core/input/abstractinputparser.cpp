@@ -26,7 +26,6 @@
 #include "basetypes.h"
 #include "soundfontmanager.h"
 #include <QFuture>
-#include "contextmanager.h"
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
 #include <QtConcurrent/QtConcurrent>
@@ -35,6 +34,8 @@
 #include <QtConcurrentRun>
 #endif
 
+bool AbstractInputParser::s_loadAllSamples = false;
+
 AbstractInputParser::AbstractInputParser() : QObject(),
     _futureWatcher(new QFutureWatcher<void>()),
     _sm(nullptr),
@@ -99,15 +100,17 @@ void AbstractInputParser::processAsync()
         EltID id(elementSf2, _sf2Index);
         _sm->set(id, champ_filenameInitial, _fileName);
         _sm->set(id, champ_filenameForData, tempFilePath.isEmpty() ? _fileName : tempFilePath);
+        _sm->set(id, champ_filenameTemporary, tempFilePath);
 
         // Possibly load all samples
-        if (ContextManager::s_playerMode)
+        if (s_loadAllSamples)
             _sm->loadAllSamples(_sf2Index);
     }
     else if (!tempFilePath.isEmpty())
         QFile::remove(tempFilePath);
 
     // The operation are not stored in the action manager
+    _sm->endBulkLoad(_sf2Index);
     _sm->clearNewEditing();
     _sm->emitNewSoundfontLoaded(_sf2Index);
 }
@@ -60,6 +60,9 @@ public:
     /// Name of the file to open
     QString getFileName() { return _fileName; }
 
+    /// If true, all samples are loaded in memory right after the parsing (player mode)
+    static bool s_loadAllSamples;
+
 signals:
     /// Signal emitted when the file is processed
     void finished();
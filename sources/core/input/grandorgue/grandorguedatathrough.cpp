@@ -23,6 +23,27 @@
 ***************************************************************************/
 
 #include "grandorguedatathrough.h"
+#include "sound.h"
+#include <QRunnable>
+#include <QThreadPool>
+
+class RunnableGrandOrgueProbe: public QRunnable
+{
+public:
+    RunnableGrandOrgueProbe(GrandOrgueDataThrough * godt, QString filePath) : QRunnable(),
+        _godt(godt),
+        _filePath(filePath)
+    {}
+
+    void run() override
+    {
+        _godt->probeFile(_filePath);
+    }
+
+private:
+    GrandOrgueDataThrough * _godt;
+    QString _filePath;
+};
 
 GrandOrgueDataThrough::GrandOrgueDataThrough() :
     _maxGain(0),
@@ -32,6 +53,11 @@ GrandOrgueDataThrough::GrandOrgueDataThrough() :
 
 }
 
+GrandOrgueDataThrough::~GrandOrgueDataThrough()
+{
+    qDeleteAll(_sounds);
+}
+
 void GrandOrgueDataThrough::setMaxRankGain(int rankId, double gain)
 {
     if (_maxGainPerRank.contains(rankId))
@@ -52,6 +78,35 @@ void GrandOrgueDataThrough::finalizePreprocess()
             _maxGain = val;
 }
 
+void GrandOrgueDataThrough::probeFiles()
+{
+    // Dedicated pool, the import itself may run in the global one
+    QThreadPool pool;
+    _filesToProbe.removeDuplicates();
+    foreach (QString filePath, _filesToProbe)
+        if (!_sounds.contains(filePath))
+            pool.start(new RunnableGrandOrgueProbe(this, filePath));
+    pool.waitForDone();
+    _filesToProbe.clear();
+}
+
+void GrandOrgueDataThrough::probeFile(QString filePath)
+{
+    // The sound is kept even if not valid, for the error
+    Sound * sound = new Sound();
+    sound->setFileName(filePath, false);
+
+    QMutexLocker locker(&_mutex);
+    _sounds[filePath] = sound;
+}
+
+Sound * GrandOrgueDataThrough::getSound(QString filePath)
+{
+    if (!_sounds.contains(filePath))
+        probeFile(filePath);
+    return _sounds[filePath];
+}
+
 void GrandOrgueDataThrough::setSf2SmplId(QString filePath, QList<int> sf2ElementIds, bool hasLoop)
 {
     _smplIds[filePath] = sf2ElementIds;
@@ -60,12 +115,12 @@ void GrandOrgueDataThrough::setSf2SmplId(QString filePath, QList<int> sf2Element
 
 bool GrandOrgueDataThrough::hasLoop(QString filePath)
 {
-    return _hasLoop.contains(filePath) && _hasLoop[filePath];
+    return _hasLoop.value(filePath, false);
 }
 
 QList<int> GrandOrgueDataThrough::getSf2SmplId(QString filePath)
 {
-    return _smplIds.contains(filePath) ? _smplIds[filePath] : QList<int>();
+    return _smplIds.value(filePath);
 }
 
 void GrandOrgueDataThrough::storeSampleName(QString sampleName)
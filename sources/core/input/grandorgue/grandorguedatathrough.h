@@ -26,13 +26,19 @@
 #define GRANDORGUEDATATHROUGH_H
 
 #include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QStringList>
 class GrandOrgueRank;
 class GrandOrgueStop;
+class Sound;
 
 class GrandOrgueDataThrough
 {
 public:
     GrandOrgueDataThrough();
+    ~GrandOrgueDataThrough();
 
     // Gain per rank (instrument)
     void setMaxRankGain(int rankId, double gain);
@@ -41,6 +47,15 @@ public:
     // Finalize the pre-process
     void finalizePreprocess();
 
+    // Sample files to read before the creation of the soundfont
+    void addFilesToProbe(QStringList filePaths) { _filesToProbe << filePaths; }
+
+    // Read the header of all files to probe, in parallel
+    void probeFiles();
+
+    // Result of the probe (done now if the file has not been probed yet)
+    Sound * getSound(QString filePath);
+
     // Maximum gain found in the sample set
     double getMaxGain() { return _maxGain; }
 
@@ -57,11 +72,18 @@ public:
     void getNextBankPreset(int &bank, int &preset);
 
 private:
+    Q_DISABLE_COPY(GrandOrgueDataThrough)
+    friend class RunnableGrandOrgueProbe;
+    void probeFile(QString filePath);
+
     QMap<int, double> _maxGainPerRank;
     double _maxGain;
-    QMap<QString, QList<int> > _smplIds;
-    QMap<QString, bool> _hasLoop;
-    QList<QString> _sampleNames;
+    QHash<QString, QList<int> > _smplIds;
+    QHash<QString, bool> _hasLoop;
+    QSet<QString> _sampleNames;
+    QStringList _filesToProbe;
+    QHash<QString, Sound *> _sounds;
+    QMutex _mutex;
     int _currentBank;
     int _currentPreset;
 };
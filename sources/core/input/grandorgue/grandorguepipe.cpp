@@ -107,6 +107,19 @@ bool GrandOrguePipe::isValid()
     return !_relativePath.isEmpty() && _error.isEmpty();
 }
 
+QStringList GrandOrguePipe::getFilePaths()
+{
+    QStringList filePaths;
+    if (this->isValid())
+    {
+        filePaths << _rootDir + "/" + _relativePath;
+        QString releaseFilePath = getReleaseFilePath();
+        if (!releaseFilePath.isEmpty())
+            filePaths << _rootDir + "/" + releaseFilePath;
+    }
+    return filePaths;
+}
+
 void GrandOrguePipe::process(EltID parent, int key)
 {
     if (!this->isValid())
@@ -267,11 +280,11 @@ QList<int> GrandOrguePipe::getSampleIds(int sf2Id, QString relativeFilePath)
     if (!sampleIndex.empty())
         return sampleIndex;
 
-    // Otherwise load a new sample
-    Sound sound;
-    if (!sound.setFileName(filePath, false))
-        _error = sound.getError();
-    quint32 nChannels = sound.getUInt32(champ_wChannels);
+    // Otherwise load a new sample (the file has already been probed)
+    Sound * sound = _godt->getSound(filePath);
+    if (!sound->getError().isEmpty())
+        _error = sound->getError();
+    quint32 nChannels = sound->getUInt32(champ_wChannels);
     QString name = QFileInfo(filePath).completeBaseName();
     if (name.length() < 16)
     {
@@ -348,25 +361,25 @@ QList<int> GrandOrguePipe::getSampleIds(int sf2Id, QString relativeFilePath)
             sm->set(idElt, champ_sfSampleType, val);
         }
         sm->set(idElt, champ_filenameForData, filePath);
-        val.dwValue = sound.getUInt32(champ_dwStart16);
+        val.dwValue = sound->getUInt32(champ_dwStart16);
         sm->set(idElt, champ_dwStart16, val);
-        val.dwValue = sound.getUInt32(champ_dwStart24);
+        val.dwValue = sound->getUInt32(champ_dwStart24);
         sm->set(idElt, champ_dwStart24, val);
         val.wValue = numChannel;
         sm->set(idElt, champ_wChannel, val);
-        val.dwValue = sound.getUInt32(champ_dwLength);
+        val.dwValue = sound->getUInt32(champ_dwLength);
         sm->set(idElt, champ_dwLength, val);
-        val.dwValue = sound.getUInt32(champ_dwSampleRate);
+        val.dwValue = sound->getUInt32(champ_dwSampleRate);
         sm->set(idElt, champ_dwSampleRate, val);
-        val.dwValue = sound.getUInt32(champ_dwStartLoop);
+        val.dwValue = sound->getUInt32(champ_dwStartLoop);
         quint32 startLoop = val.dwValue;
         sm->set(idElt, champ_dwStartLoop, val);
-        val.dwValue = sound.getUInt32(champ_dwEndLoop);
+        val.dwValue = sound->getUInt32(champ_dwEndLoop);
         hasLoop |= (startLoop != val.dwValue);
         sm->set(idElt, champ_dwEndLoop, val);
-        val.bValue = (quint8)sound.getUInt32(champ_byOriginalPitch);
+        val.bValue = (quint8)sound->getUInt32(champ_byOriginalPitch);
         sm->set(idElt, champ_byOriginalPitch, val);
-        val.cValue = (char)sound.getInt32(champ_chPitchCorrection);
+        val.cValue = (char)sound->getInt32(champ_chPitchCorrection);
         sm->set(idElt, champ_chPitchCorrection, val);
     }
 
@@ -45,6 +45,9 @@ public:
 
     void addTuning(int offset) { _tuning += offset; }
 
+    // Full path of the sample files (attack and release)
+    QStringList getFilePaths();
+
     void process(EltID parent, int key);
 
 private:
@@ -103,11 +103,12 @@ void GrandOrgueRank::preProcess()
 {
     if (!_pipes.isEmpty())
     {
-        // Include the gain and the tuning of the rank in the pipes
+        // Include the gain and the tuning of the rank in the pipes, list the files to read
         foreach (GrandOrguePipe * pipe, _pipes.values())
         {
             pipe->addGain(_gain);
             pipe->addTuning(_tuning);
+            _godt->addFilesToProbe(pipe->getFilePaths());
         }
 
         // Maximum gain of the pipes
@@ -220,6 +220,7 @@ void InputParserGrandOrgue::createSf2(int &sf2Index, QString filename)
     EltID idSf2(elementSf2, -1, -1, -1, -1);
     idSf2.indexSf2 = sm->add(idSf2);
     sf2Index = idSf2.indexSf2;
+    sm->beginBulkLoad(sf2Index);
 
     // Title, comment
     QFileInfo fileInfo(filename);
@@ -235,6 +236,9 @@ void InputParserGrandOrgue::createSf2(int &sf2Index, QString filename)
         goSwitch->preProcess();
     _godt->finalizePreprocess();
 
+    // Read all sample files in parallel
+    _godt->probeFiles();
+
     // Process switches and stops for creating presets and instruments
     foreach (GrandOrgueSwitch * goSwitch, _switches)
         goSwitch->process(sm, sf2Index, _stops, _ranks);
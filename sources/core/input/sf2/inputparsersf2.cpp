@@ -29,9 +29,93 @@
 #include "sf2header.h"
 #include "sf2sdtapart.h"
 #include "sf2pdtapart.h"
+#include "samplereadersf2.h"
+#include <QRunnable>
+#include <QThreadPool>
+#include <QStringList>
+
+class RunnableSf2DataLoader: public QRunnable
+{
+public:
+    RunnableSf2DataLoader(const QByteArray &data, quint32 start16, quint32 start24, quint32 length, QVector<float> &result) : QRunnable(),
+        _data(data),
+        _start16(start16),
+        _start24(start24),
+        _length(length),
+        _result(result)
+    {}
+
+    void run() override
+    {
+        // Check the positions, the data is not loaded if the file is corrupted
+        quint64 size = static_cast<quint64>(_data.size());
+        if (static_cast<quint64>(_start16) + 2 * static_cast<quint64>(_length) > size ||
+                (_start24 > 0 && static_cast<quint64>(_start24) + _length > size))
+            return;
+
+        _result.resize(_length);
+        SampleReaderSf2::convert(reinterpret_cast<const qint16 *>(_data.constData() + _start16),
+                                 _start24 > 0 ? reinterpret_cast<const quint8 *>(_data.constData() + _start24) : nullptr,
+                                 _length, _result.data());
+    }
+
+private:
+    const QByteArray &_data;
+    quint32 _start16, _start24, _length;
+    QVector<float> &_result;
+};
 
 InputParserSf2::InputParserSf2() : AbstractInputParser() {}
 
+void InputParserSf2::processData(const QByteArray &data, SoundfontManager * sm, bool &success, QString &error, int &sf2Index)
+{
+    // Keep the variables (no file is associated to the samples)
+    _sm = sm;
+    _filename = "";
+
+    // Parse the data
+    QDataStream stream(data);
+    this->parse(stream, success, error, sf2Index);
+    if (success)
+        loadSampleData(data, sf2Index);
+}
+
+void InputParserSf2::loadSampleData(const QByteArray &data, int sf2Index)
+{
+    // Convert the samples in parallel
+    EltID id(elementSmpl, sf2Index);
+    QList<int> sampleIndexes = _sm->getSiblings(id);
+    QVector<QVector<float> > results(sampleIndexes.size());
+    QThreadPool pool;
+    for (int i = 0; i < sampleIndexes.size(); i++)
+    {
+        id.indexElt = sampleIndexes[i];
+        quint32 start24 = _sm->get(id, champ_bpsFile).wValue >= 24 ? _sm->get(id, champ_dwStart24).dwValue : 0;
+        pool.start(new RunnableSf2DataLoader(data, _sm->get(id, champ_dwStart16).dwValue, start24,
+                                             _sm->get(id, champ_dwLength).dwValue, results[i]));
+    }
+    pool.waitForDone();
+
+    // Store the data
+    QStringList corruptedSamples;
+    for (int i = 0; i < sampleIndexes.size(); i++)
+    {
+        id.indexElt = sampleIndexes[i];
+
+        // Positions out of the data: the sample information is kept unchanged, without data
+        if (results[i].isEmpty() && _sm->get(id, champ_dwLength).dwValue > 0)
+        {
+            corruptedSamples << _sm->getQstr(id, champ_name);
+            continue;
+        }
+
+        _sm->set(id, results[i]);
+    }
+
+    if (!corruptedSamples.isEmpty())
+        _sm->emitError(tr("Corrupted data for the samples: %1").arg("\"" + corruptedSamples.join("\", \"") + "\""));
+}
+
 void InputParserSf2::processInternal(QString fileName, SoundfontManager * sm, bool &success, QString &error, int &sf2Index, QString &tempFilePath)
 {
     Q_UNUSED(tempFilePath)
@@ -100,6 +184,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
 
     // Create a new soundfont
     sf2Index = _sm->add(EltID(elementSf2));
+    _sm->beginBulkLoad(sf2Index);
     EltID id(elementSf2, sf2Index);
 
     /// General data
@@ -136,9 +221,10 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
     /// Samples
 
     id = EltID(elementSmpl, sf2Index);
+    quint32 defaultSampleRate = 0;
     for (int i = 0; i < pdtaPart._shdrs.count() - 1; i++) // Terminal sample (EOS) is not read
     {
-        Sf2PdtaPart_shdr SHDR = pdtaPart._shdrs[i];
+        const Sf2PdtaPart_shdr &SHDR = pdtaPart._shdrs[i];
 
         id.indexElt = _sm->add(id);
         _sm->set(id, champ_name, SHDR._name);
@@ -159,17 +245,24 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
         {
             // Bad configuration in the sf2 file => we try to find a valid sample rate somewhere else
             // to avoid future arythmetic exceptions (divisions by 0)
-            for (int i = 0; i < pdtaPart._shdrs.count() - 1; i++) // Terminal sample (EOS) is not read
+            if (defaultSampleRate == 0)
             {
-                value.dwValue = pdtaPart._shdrs[i]._sampleRate.value;
-                if (value.dwValue != 0)
-                    break;
+                for (int j = 0; j < pdtaPart._shdrs.count() - 1; j++) // Terminal sample (EOS) is not read
+                {
+                    defaultSampleRate = pdtaPart._shdrs[j]._sampleRate.value;
+                    if (defaultSampleRate != 0)
+                        break;
+                }
+                if (defaultSampleRate == 0)
+                    defaultSampleRate = 44100; // Nothing else has been found, 44100 is set since this is common
             }
-            if (value.dwValue == 0)
-                value.dwValue = 44100; // Nothing else has been found, 44100 is set since this is common
+            value.dwValue = defaultSampleRate;
         }
         _sm->set(id, champ_dwSampleRate, value);
-        _sm->set(id, champ_filenameForData, _filename);
+
+        // Data already in memory (sfArk extraction) is loaded later, without any file
+        if (!_filename.isEmpty())
+            _sm->set(id, champ_filenameForData, _filename);
 
         // Start / end / length of the sample
         value.dwValue = SHDR._end.value - SHDR._start.value;
@@ -207,7 +300,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
     int l, global;
     for (int i = 0; i < pdtaPart._insts.count() - 1; i++) // Terminal instrument (EOI) is not read
     {
-        Sf2PdtaPart_inst inst = pdtaPart._insts[i];
+        const Sf2PdtaPart_inst &inst = pdtaPart._insts[i];
 
         l = 0;
         id.indexElt = _sm->add(id);
@@ -221,7 +314,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
         // Foreach ibag
         for (int j = bagmin; j < bagmax; j++)
         {
-            Sf2PdtaPart_bag bag = pdtaPart._ibags[j];
+            const Sf2PdtaPart_bag &bag = pdtaPart._ibags[j];
 
             // Indexes of IMOD and IGEN
             modmin = bag._modIndex.value;
@@ -279,7 +372,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
                     id2.indexMod = _sm->add(id2);
                 }
 
-                Sf2PdtaPart_mod mod = pdtaPart._imods[k];
+                const Sf2PdtaPart_mod &mod = pdtaPart._imods[k];
                 value.sfModValue = mod._sfModSrcOper;
                 _sm->set(id2, champ_sfModSrcOper, value);
                 value.wValue = mod._sfModDestOper.value;
@@ -304,7 +397,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
     id.indexElt = -1;
     for (int i = 0; i < pdtaPart._phdrs.count() - 1; i++) // Terminal preset (EOP) is not read
     {
-        Sf2PdtaPart_phdr prst = pdtaPart._phdrs[i];
+        const Sf2PdtaPart_phdr &prst = pdtaPart._phdrs[i];
 
         l = 0;
         id.indexElt = _sm->add(id);
@@ -328,7 +421,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
         // Foreach pbag
         for (int j = bagmin; j < bagmax; j++)
         {
-            Sf2PdtaPart_bag bag = pdtaPart._pbags[j];
+            const Sf2PdtaPart_bag &bag = pdtaPart._pbags[j];
 
             // Indexes of PMOD and PGEN
             modmin = bag._modIndex.value;
@@ -386,7 +479,7 @@ void InputParserSf2::fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPa
                     id2.indexMod = _sm->add(id2);
                 }
 
-                Sf2PdtaPart_mod mod = pdtaPart._pmods[k];
+                const Sf2PdtaPart_mod &mod = pdtaPart._pmods[k];
                 value.sfModValue = mod._sfModSrcOper;
                 _sm->set(id2, champ_sfModSrcOper, value);
                 value.wValue = mod._sfModDestOper.value;
@@ -38,12 +38,16 @@ class InputParserSf2 : public AbstractInputParser
 public:
     InputParserSf2();
 
+    // Parse a sf2 file already in memory, the sample data being directly loaded
+    void processData(const QByteArray &data, SoundfontManager * sm, bool &success, QString &error, int &sf2Index);
+
 protected slots:
     void processInternal(QString fileName, SoundfontManager * sm, bool &success, QString &error, int &sf2Index, QString &tempFilePath) override;
 
 private:
     void parse(QDataStream &stream, bool &success, QString &error, int &sf2Index);
     void fillSf2(Sf2Header &header, Sf2SdtaPart &sdtaPart, Sf2PdtaPart &pdtaPart, bool &success, QString &error, int &sf2Index);
+    void loadSampleData(const QByteArray &data, int sf2Index);
 
     SoundfontManager * _sm;
     QString _filename;
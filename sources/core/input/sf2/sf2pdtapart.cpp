@@ -32,172 +32,61 @@ Sf2PdtaPart::Sf2PdtaPart() :
 
 }
 
+template<class T>
+bool readSubChunk(const char * &data, const char * dataEnd, char name[4], quint32Reversed &size,
+                  int recordSize, QVector<T> &records)
+{
+    // 4 char for the name and the size of the section
+    if (dataEnd - data < 8)
+        return false;
+    memcpy(name, data, 4);
+    size.value = readQuint32(data + 4);
+    data += 8;
+    if (size.value % recordSize != 0)
+        return false;
+
+    // All records are decoded from the memory (missing records at the end of a truncated file stay empty)
+    quint32 availableSize = qMin(size.value, static_cast<quint32>(dataEnd - data));
+    records.resize(size.value / recordSize);
+    for (quint32 i = 0; i < availableSize / recordSize; i++)
+        records[i].read(data + i * recordSize);
+    data += availableSize;
+    return true;
+}
+
 QDataStream & operator >> (QDataStream &in, Sf2PdtaPart &pdta)
 {
     // 4 char, should be "LIST"
     if (in.readRawData(pdta._LIST, 4) != 4)
         return in;
 
-    // 4 char, should be "pdta"
-    if (in.readRawData(pdta._pdta, 4) != 4)
-        return in;
-
     // Size of the section "pdta"
     in >> pdta._pdtaSize;
 
-    /// Read PHDR
-
-    // 4 char, should be "phdr"
-    if (in.readRawData(pdta._phdr, 4) != 4)
-        return in;
-
-    // Size of the section "phdr"
-    in >> pdta._phdrSize;
-    if (pdta._phdrSize.value % 38 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._phdrSize.value / 38; i++)
-    {
-        pdta._phdrs << Sf2PdtaPart_phdr();
-        in >> pdta._phdrs[i];
-    }
-
-    /// Read PBAG
-
-    // 4 char, should be "pbag"
-    if (in.readRawData(pdta._pbag, 4) != 4)
-        return in;
-
-    // Size of the section "pbag"
-    in >> pdta._pbagSize;
-    if (pdta._pbagSize.value % 4 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._pbagSize.value / 4; i++)
-    {
-        pdta._pbags << Sf2PdtaPart_bag();
-        in >> pdta._pbags[i];
-    }
-
-    /// Read PMOD
-
-    // 4 char, should be "pmod"
-    if (in.readRawData(pdta._pmod, 4) != 4)
-        return in;
-
-    // Size of the section "pmod"
-    in >> pdta._pmodSize;
-    if (pdta._pmodSize.value % 10 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._pmodSize.value / 10; i++)
-    {
-        pdta._pmods << Sf2PdtaPart_mod();
-        in >> pdta._pmods[i];
-    }
-
-    /// Read PGEN
-
-    // 4 char, should be "pgen"
-    if (in.readRawData(pdta._pgen, 4) != 4)
-        return in;
-
-    // Size of the section "pgen"
-    in >> pdta._pgenSize;
-    if (pdta._pgenSize.value % 4 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._pgenSize.value / 4; i++)
-    {
-        pdta._pgens << Sf2PdtaPart_gen();
-        in >> pdta._pgens[i];
-    }
-
-    /// Read INST
-
-    // 4 char, should be "inst"
-    if (in.readRawData(pdta._inst, 4) != 4)
-        return in;
-
-    // Size of the section "inst"
-    in >> pdta._instSize;
-    if (pdta._instSize.value % 22 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._instSize.value / 22; i++)
-    {
-        pdta._insts << Sf2PdtaPart_inst();
-        in >> pdta._insts[i];
-    }
-
-    /// Read IBAG
-
-    // 4 char, should be "ibag"
-    if (in.readRawData(pdta._ibag, 4) != 4)
-        return in;
-
-    // Size of the section "ibag"
-    in >> pdta._ibagSize;
-    if (pdta._ibagSize.value % 4 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._ibagSize.value / 4; i++)
-    {
-        pdta._ibags << Sf2PdtaPart_bag();
-        in >> pdta._ibags[i];
-    }
-
-    /// Read IMOD
-
-    // 4 char, should be "imod"
-    if (in.readRawData(pdta._imod, 4) != 4)
-        return in;
-
-    // Size of the section "imod"
-    in >> pdta._imodSize;
-    if (pdta._imodSize.value % 10 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._imodSize.value / 10; i++)
-    {
-        pdta._imods << Sf2PdtaPart_mod();
-        in >> pdta._imods[i];
-    }
-
-    /// Read IGEN
-
-    // 4 char, should be "igen"
-    if (in.readRawData(pdta._igen, 4) != 4)
+    // 4 char, should be "pdta"
+    if (in.readRawData(pdta._pdta, 4) != 4)
         return in;
 
-    // Size of the section "igen"
-    in >> pdta._igenSize;
-    if (pdta._igenSize.value % 4 != 0)
+    // The section, at the end of the file, is read at once
+    // (its size is not used since it may be wrong in some files)
+    if (in.device() == nullptr)
         return in;
+    QByteArray buffer = in.device()->readAll();
+    const char * data = buffer.constData();
+    const char * dataEnd = data + buffer.size();
 
-    for (unsigned int i = 0; i < pdta._igenSize.value / 4; i++)
-    {
-        pdta._igens << Sf2PdtaPart_gen();
-        in >> pdta._igens[i];
-    }
-
-    /// READ SHDR
-
-    // 4 char, should be "shdr"
-    if (in.readRawData(pdta._shdr, 4) != 4)
+    // Read PHDR, PBAG, PMOD, PGEN, INST, IBAG, IMOD, IGEN and SHDR
+    if (!readSubChunk(data, dataEnd, pdta._phdr, pdta._phdrSize, 38, pdta._phdrs) ||
+            !readSubChunk(data, dataEnd, pdta._pbag, pdta._pbagSize, 4, pdta._pbags) ||
+            !readSubChunk(data, dataEnd, pdta._pmod, pdta._pmodSize, 10, pdta._pmods) ||
+            !readSubChunk(data, dataEnd, pdta._pgen, pdta._pgenSize, 4, pdta._pgens) ||
+            !readSubChunk(data, dataEnd, pdta._inst, pdta._instSize, 22, pdta._insts) ||
+            !readSubChunk(data, dataEnd, pdta._ibag, pdta._ibagSize, 4, pdta._ibags) ||
+            !readSubChunk(data, dataEnd, pdta._imod, pdta._imodSize, 10, pdta._imods) ||
+            !readSubChunk(data, dataEnd, pdta._igen, pdta._igenSize, 4, pdta._igens) ||
+            !readSubChunk(data, dataEnd, pdta._shdr, pdta._shdrSize, 46, pdta._shdrs))
         return in;
 
-    // Size of the section "shdr"
-    in >> pdta._shdrSize;
-    if (pdta._shdrSize.value % 46 != 0)
-        return in;
-
-    for (unsigned int i = 0; i < pdta._shdrSize.value / 46; i++)
-    {
-        pdta._shdrs << Sf2PdtaPart_shdr();
-        in >> pdta._shdrs[i];
-    }
-
     pdta._isValid = true;
     return in;
 }
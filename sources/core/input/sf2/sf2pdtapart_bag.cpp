@@ -42,3 +42,9 @@ QDataStream & operator >> (QDataStream &in, Sf2PdtaPart_bag &bag)
     return in;
 }
 
+void Sf2PdtaPart_bag::read(const char * data)
+{
+    _genIndex.value = readQuint16(data);
+    _modIndex.value = readQuint16(data + 2);
+    _isValid = true;
+}
@@ -40,3 +40,10 @@ QDataStream & operator >> (QDataStream &in, Sf2PdtaPart_gen &gen)
     gen._isValid = true;
     return in;
 }
+
+void Sf2PdtaPart_gen::read(const char * data)
+{
+    _sfGenOper.value = readQuint16(data);
+    _genAmount.value = readQuint16(data + 2);
+    _isValid = true;
+}
@@ -32,6 +32,9 @@ class Sf2PdtaPart_gen
 public:
     Sf2PdtaPart_gen();
 
+    // Read a record of 4 bytes (little endian)
+    void read(const char * data);
+
     bool _isValid;
 
     quint16Reversed _sfGenOper;
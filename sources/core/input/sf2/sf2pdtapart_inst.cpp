@@ -48,3 +48,10 @@ QDataStream & operator >> (QDataStream &in, Sf2PdtaPart_inst &inst)
     inst._isValid = true;
     return in;
 }
+
+void Sf2PdtaPart_inst::read(const char * data)
+{
+    _name = QString::fromLatin1(data, qstrnlen(data, 20)).trimmed();
+    _iBagIndex.value = readQuint16(data + 20);
+    _isValid = true;
+}
@@ -33,6 +33,9 @@ class Sf2PdtaPart_inst
 public:
     Sf2PdtaPart_inst();
 
+    // Read a record of 22 bytes (little endian)
+    void read(const char * data);
+
     bool _isValid;
 
     QString _name;
@@ -39,3 +39,13 @@ QDataStream & operator >> (QDataStream &in, Sf2PdtaPart_mod &mod)
     mod._isValid = true;
     return  in;
 }
+
+void Sf2PdtaPart_mod::read(const char * data)
+{
+    readSFModulator(data, _sfModSrcOper);
+    _sfModDestOper.value = readQuint16(data + 2);
+    _modAmount.value = static_cast<qint16>(readQuint16(data + 4));
+    readSFModulator(data + 6, _sfModAmtSrcOper);
+    _sfModTransOper.value = readQuint16(data + 8);
+    _isValid = true;
+}
@@ -32,6 +32,9 @@ class Sf2PdtaPart_mod
 public:
     Sf2PdtaPart_mod();
 
+    // Read a record of 10 bytes (little endian)
+    void read(const char * data);
+
     bool _isValid;
 
     SFModulator _sfModSrcOper;
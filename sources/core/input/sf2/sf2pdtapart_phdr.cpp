@@ -62,3 +62,15 @@ QDataStream & operator >> (QDataStream &in, Sf2PdtaPart_phdr &phdr)
     phdr._isValid = true;
     return in;
 }
+
+void Sf2PdtaPart_phdr::read(const char * data)
+{
+    _name = QString::fromLatin1(data, qstrnlen(data, 20)).trimmed();
+    _preset.value = readQuint16(data + 20);
+    _bank.value = readQuint16(data + 22);
+    _pBagIndex.value = readQuint16(data + 24);
+    _library.value = readQuint32(data + 26);
+    _genre.value = readQuint32(data + 30);
+    _morphology.value = readQuint32(data + 34);
+    _isValid = true;
+}
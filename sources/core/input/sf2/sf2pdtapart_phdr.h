@@ -33,6 +33,9 @@ class Sf2PdtaPart_phdr
 public:
     Sf2PdtaPart_phdr();
 
+    // Read a record of 38 bytes (little endian)
+    void read(const char * data);
+
     bool _isValid;
 
     QString _name;
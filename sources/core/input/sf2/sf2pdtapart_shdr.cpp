@@ -60,3 +60,18 @@ QDataStream & operator >> (QDataStream &in, Sf2PdtaPart_shdr &shdr)
     shdr._isValid = true;
     return in;
 }
+
+void Sf2PdtaPart_shdr::read(const char * data)
+{
+    _name = QString::fromLatin1(data, qstrnlen(data, 20)).trimmed();
+    _start.value = readQuint32(data + 20);
+    _end.value = readQuint32(data + 24);
+    _startLoop.value = readQuint32(data + 28);
+    _endLoop.value = readQuint32(data + 32);
+    _sampleRate.value = readQuint32(data + 36);
+    _originalPitch = static_cast<quint8>(data[40]);
+    _correction = static_cast<qint8>(data[41]);
+    _wSampleLink.value = readQuint16(data + 42);
+    _sfSampleType.value = readQuint16(data + 44);
+    _isValid = true;
+}
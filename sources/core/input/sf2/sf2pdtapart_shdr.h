@@ -33,6 +33,9 @@ class Sf2PdtaPart_shdr
 public:
     Sf2PdtaPart_shdr();
 
+    // Read a record of 46 bytes (little endian)
+    void read(const char * data);
+
     bool _isValid;
 
     QString _name;
@@ -26,6 +26,7 @@
 #include "soundfontmanager.h"
 #include "sf3/sfont.h"
 #include "inputfactory.h"
+#include <QMutex>
 
 InputParserSf3::InputParserSf3() : AbstractInputParser() {}
 
@@ -34,7 +35,9 @@ void InputParserSf3::processInternal(QString fileName, SoundfontManager * sm, bo
     Q_UNUSED(sm)
     success = false;
 
-    // Name of the temporary file
+    // Name of the temporary file, created at once since several files can be loaded at the same time
+    static QMutex s_tempFileMutex;
+    QMutexLocker locker(&s_tempFileMutex);
     tempFilePath = QDir::tempPath() + "/" + QFileInfo(fileName).completeBaseName() + "_tmp";
     if (QFile(tempFilePath + ".sf2").exists())
     {
@@ -44,13 +47,15 @@ void InputParserSf3::processInternal(QString fileName, SoundfontManager * sm, bo
         tempFilePath = tempFilePath + "-" + QString::number(index);
     }
     tempFilePath += ".sf2";
+    QFile fo(tempFilePath);
+    bool isOpen = fo.open(QIODevice::WriteOnly);
+    locker.unlock();
 
     // First convert to sf2
     SfTools::SoundFont sf(fileName);
     if (sf.read())
     {
-        QFile fo(tempFilePath);
-        if (fo.open(QIODevice::WriteOnly))
+        if (isOpen)
         {
             if (sf.uncompress(&fo))
             {
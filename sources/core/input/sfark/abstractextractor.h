@@ -36,8 +36,12 @@ class AbstractExtractor: public QObject
 public:
     AbstractExtractor() {}
     virtual ~AbstractExtractor() {}
-    virtual bool extract(const char * outputFilePath) = 0;
+    virtual bool extract(QByteArray &sf2Data) = 0; // The sf2 is extracted in memory
     virtual QString getError() = 0;
+
+protected:
+    // Name of the simulated output file
+    static constexpr const char * OUTPUT_FILE_NAME = "extracted.sf2";
 };
 
 #endif // ABSTRACTEXTRACTOR_H
@@ -26,29 +26,15 @@
 #include "abstractextractor.h"
 #include "sfarkextractor1.h"
 #include "sfarkextractor2.h"
-#include <QDataStream>
-#include <QFileInfo>
-#include <QDir>
-#include "inputfactory.h"
+#include "sf2/inputparsersf2.h"
 
 InputParserSfArk::InputParserSfArk() : AbstractInputParser() {}
 
 void InputParserSfArk::processInternal(QString fileName, SoundfontManager * sm, bool &success, QString &error, int &sf2Index, QString &tempFilePath)
 {
-    Q_UNUSED(sm)
+    Q_UNUSED(tempFilePath)
     success = false;
 
-    // Name of the temporary file
-    tempFilePath = QDir::tempPath() + "/" + QFileInfo(fileName).completeBaseName() + "_tmp";
-    if (QFile(tempFilePath + ".sf2").exists())
-    {
-        int index = 1;
-        while (QFile(tempFilePath + "-" + QString::number(index) + ".sf2").exists())
-            index++;
-        tempFilePath = tempFilePath + "-" + QString::number(index);
-    }
-    tempFilePath += ".sf2";
-
     // Take the right version of the extractor
     AbstractExtractor * sfArkExtractor;
     SfArkExtractor1 * extractorV1 = new SfArkExtractor1(fileName.toStdString().c_str());
@@ -60,20 +46,13 @@ void InputParserSfArk::processInternal(QString fileName, SoundfontManager * sm,
         sfArkExtractor = new SfArkExtractor2(fileName.toStdString().c_str());
     }
 
-    // Convert data
-    if (sfArkExtractor->extract(tempFilePath.toStdString().c_str()))
+    // Convert data in memory
+    QByteArray sf2Data;
+    if (sfArkExtractor->extract(sf2Data))
     {
         // Then load the sf2
-        AbstractInputParser * sf2Input = InputFactory::getInput(tempFilePath);
-        sf2Input->process(false);
-        if (sf2Input->isSuccess())
-        {
-            success = true;
-            sf2Index = sf2Input->getSf2Index();
-        }
-        else
-            error = sf2Input->getError();
-        delete sf2Input;
+        InputParserSf2 sf2Input;
+        sf2Input.processData(sf2Data, sm, success, error, sf2Index);
     }
     else
         error = sfArkExtractor->getError();
@@ -50,11 +50,11 @@ SfArkExtractor1::~SfArkExtractor1()
     delete _sfArkInfo;
 }
 
-bool SfArkExtractor1::extract(const char * outputFilePath)
+bool SfArkExtractor1::extract(QByteArray &sf2Data)
 {
     if (_error == SFARKERR_OK)
     {
-        if (!(_error = (SfArkError)SfarkBeginExtract(outputFilePath)))
+        if (!(_error = (SfArkError)SfarkBeginExtract(OUTPUT_FILE_NAME)))
         {
             do
             {
@@ -66,6 +66,7 @@ bool SfArkExtractor1::extract(const char * outputFilePath)
         _error = SFARKERR_OK;
 
     cleanFiles();
+    sf2Data = _fileManager.takeData(OUTPUT_FILE_NAME);
 
     return _error == SFARKERR_OK || _error == SFARKERR_CHKSUM; // checksum errors are accepted
 }
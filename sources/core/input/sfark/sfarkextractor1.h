@@ -39,7 +39,7 @@ public:
     SfArkExtractor1(const char * fileName);
 
     virtual ~SfArkExtractor1();
-    bool extract(const char * outputFilePath) override;
+    bool extract(QByteArray &sf2Data) override;
     bool isVersion1();
     QString getError() override
     {
@@ -123,9 +123,10 @@ SfArkExtractor2::~SfArkExtractor2()
     _fileManager.clearData();
 }
 
-bool SfArkExtractor2::extract(const char *outputFilePath)
+bool SfArkExtractor2::extract(QByteArray &sf2Data)
 {
-    _errorNumber = sfkl_Decode(_filename.toStdString().c_str(), outputFilePath);
+    _errorNumber = sfkl_Decode(_filename.toStdString().c_str(), OUTPUT_FILE_NAME);
+    sf2Data = _fileManager.takeData(OUTPUT_FILE_NAME);
     _error = (_errorNumber != SFARKLIB_SUCCESS && _errorNumber != SFARKLIB_ERR_CORRUPT && _errorNumber != SFARKLIB_ERR_FILECHECK);
     return !_error;
 }
@@ -303,7 +303,7 @@ class SfArkExtractor2: public AbstractExtractor
 public:
     SfArkExtractor2(const char * fileName);
     virtual ~SfArkExtractor2();
-    bool extract(const char * outputFilePath) override;
+    bool extract(QByteArray &sf2Data) override;
     virtual QString getError() override
     {
         QString error = "";
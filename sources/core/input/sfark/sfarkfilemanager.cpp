@@ -24,6 +24,7 @@
 
 #include "sfarkfilemanager.h"
 #include <QFile>
+#include <QBuffer>
 #include <QDataStream>
 
 SfArkFileManager::SfArkFileManager() :
@@ -44,7 +45,17 @@ int SfArkFileManager::openReadOnly(const char * name)
         handler = _mapName.value(name);
     else
     {
-        QFile * file = new QFile(name);
+        // Simulated file or real file
+        QIODevice * file;
+        if (_mapMemory.contains(name))
+        {
+            QBuffer * buffer = new QBuffer();
+            buffer->setData(_mapMemory.value(name));
+            file = buffer;
+        }
+        else
+            file = new QFile(name);
+
         if (file->open(QIODevice::ReadOnly))
         {
             _mapName[name] = _maxFileHandler;
@@ -70,9 +81,10 @@ int SfArkFileManager::create(const char *name)
         handler = _mapName.value(name);
     else
     {
-        QFile * file = new QFile(name);
+        QBuffer * file = new QBuffer();
         if (file->open(QIODevice::ReadWrite))
         {
+            _mapMemory[name] = QByteArray();
             _mapName[name] = _maxFileHandler;
             _mapFile[_maxFileHandler] = file;
             _maxFileHandler++;
@@ -90,8 +102,12 @@ int SfArkFileManager::create(const char *name)
 
 void SfArkFileManager::deleteFile(const char * name)
 {
-    QFile file (name);
-    file.remove();
+    _mapMemory.remove(name);
+}
+
+QByteArray SfArkFileManager::takeData(const char * name)
+{
+    return _mapMemory.take(name);
 }
 
 // Return true if success, otherwise false
@@ -104,11 +120,17 @@ void SfArkFileManager::close(int fileHandler)
     // Fermeture si fichier ouvert
     if (_mapFile.contains(fileHandler))
     {
-        QFile * file = _mapFile.take(fileHandler);
+        QIODevice * file = _mapFile.take(fileHandler);
+        QString key = _mapName.key(fileHandler, "");
+
+        // Keep the content of a simulated file that has been written
+        QBuffer * buffer = qobject_cast<QBuffer *>(file);
+        if (buffer != nullptr && buffer->isWritable() && !key.isEmpty())
+            _mapMemory[key] = buffer->data();
+
         file->close();
         delete file;
 
-        QString key = _mapName.key(fileHandler, "");
         if (!key.isEmpty())
             _mapName.remove(key);
     }
@@ -174,7 +196,7 @@ void SfArkFileManager::clearData()
     keys = _mapFile.keys();
     foreach (int key, keys)
     {
-        QFile * file = _mapFile.take(key);
+        QIODevice * file = _mapFile.take(key);
         file->close();
         delete file;
     }
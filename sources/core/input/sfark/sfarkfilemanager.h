@@ -27,7 +27,8 @@
 
 #include <QString>
 #include <QMap>
-class QFile;
+#include <QByteArray>
+class QIODevice;
 
 class SfArkFileManager
 {
@@ -39,7 +40,7 @@ public:
     // Return a file handler if success, otherwise -1
     int openReadOnly(const char *name);
 
-    // Simulate the creation of a file
+    // Simulate the creation of a file, the data being kept in memory
     // Return a file handler
     int create(const char * name);
 
@@ -64,10 +65,14 @@ public:
     // Delete a file after being closed
     void deleteFile(const char * name);
 
+    // Take the content of a simulated file after being closed
+    QByteArray takeData(const char * name);
+
 private:
     QMap<QString, int> _mapName;
     QMap<int, QDataStream *> _mapDataStream;
-    QMap<int, QFile *> _mapFile;
+    QMap<int, QIODevice *> _mapFile;
+    QMap<QString, QByteArray> _mapMemory; // Content of the simulated files
 
     int _maxFileHandler;
 };
@@ -24,6 +24,7 @@
 
 #include "inputparsersfz.h"
 #include "soundfontmanager.h"
+#include "sfzsampleindex.h"
 #include <QRegularExpression>
 
 InputParserSfz::InputParserSfz() : AbstractInputParser() {}
@@ -34,6 +35,7 @@ void InputParserSfz::processInternal(QString fileName, SoundfontManager * sm, bo
     Q_UNUSED(tempFilePath)
 
     _currentBloc = BLOC_UNKNOWN;
+    _defaultPath = "";
 
     // Parse the file
     _rootDir = QFileInfo(fileName).dir().path();
@@ -43,15 +45,25 @@ void InputParserSfz::processInternal(QString fileName, SoundfontManager * sm, bo
     if (!success)
         return;
 
-    bool isChannel10 = true;
-    double ampliMax = 0;
+    // All samples must be valid
+    QString path = QFileInfo(fileName).path();
+    QStringList samplePaths;
     for (int i = 0; i < _presetList.size(); i++)
     {
-        // All samples must be valid
         _presetList[i].moveOpcodesInGlobal(_globalZone);
         _presetList[i].moveOpcodeInSamples(SfzParameter::op_sample, QMetaType::QString);
-        _presetList[i].checkSampleValid(QFileInfo(fileName).path());
+        _presetList[i].checkSampleValid(path);
+        samplePaths << _presetList[i].getSamplePaths(path);
+    }
+
+    // Read the sample files in parallel
+    SfzSampleIndex sampleIndex;
+    sampleIndex.probe(samplePaths);
 
+    bool isChannel10 = true;
+    double ampliMax = 0;
+    for (int i = 0; i < _presetList.size(); i++)
+    {
         // Offsets must be defined for samples, not in gloobal division
         _presetList[i].moveOpcodeInSamples(SfzParameter::op_offset, QMetaType::Int);
         _presetList[i].moveOpcodeInSamples(SfzParameter::op_end, QMetaType::Int);
@@ -72,7 +84,7 @@ void InputParserSfz::processInternal(QString fileName, SoundfontManager * sm, bo
         _presetList[i].moveKeynumInSamples(SfzParameter::op_noteToModEnvHold, SfzParameter::op_pitcheg_hold);
         _presetList[i].moveKeynumInSamples(SfzParameter::op_fileg_decaycc133, SfzParameter::op_fileg_decay);
         _presetList[i].moveKeynumInSamples(SfzParameter::op_fileg_holdcc133, SfzParameter::op_fileg_hold);
-        _presetList[i].adjustCorrection(QFileInfo(fileName).path());
+        _presetList[i].adjustCorrection(path, sampleIndex);
 
         // Adapt the volume if a volume modulation applies
         _presetList[i].adjustModulationVolume();
@@ -94,7 +106,7 @@ void InputParserSfz::processInternal(QString fileName, SoundfontManager * sm, bo
             _presetList[i].adjustVolume(-ampliMax);
 
     // Create a soundfont
-    createSf2(sf2Index, fileName, isChannel10);
+    createSf2(sf2Index, fileName, isChannel10, sampleIndex);
 
     success = true;
 }
@@ -118,83 +130,131 @@ void InputParserSfz::parseFile(QString filename, bool &success, QString &error)
     }
 
     _openFilePaths << filename;
-    QTextStream in(&inputFile);
-    while (!in.atEnd())
+
+    // Map the file in memory if possible, otherwise read it
+    QByteArray content;
+    qint64 size = inputFile.size();
+    const char * data = size > 0 ? reinterpret_cast<const char *>(inputFile.map(0, size)) : nullptr;
+    if (data == nullptr)
+    {
+        content = inputFile.readAll();
+        data = content.constData();
+        size = content.size();
+    }
+    const char * end = data + size;
+
+    // Skip a possible BOM
+    if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        data += 3;
+
+    // Parse each line
+    success = true;
+    while (data < end && success)
     {
-        // Read one line
-        QString line = in.readLine();
-        if (line.isEmpty())
-            continue;
+        const char * lineEnd = data;
+        while (lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r')
+            lineEnd++;
 
         // Remove comment
-        if (line.contains("//"))
-            line = line.left(line.indexOf("//"));
+        const char * commentPos = data;
+        while (commentPos + 1 < lineEnd && (commentPos[0] != '/' || commentPos[1] != '/'))
+            commentPos++;
+        parseLine(data, commentPos + 1 < lineEnd ? commentPos : lineEnd, success, error);
 
-        // Cut the line
-        QStringList list = line.split(" ", Qt::KeepEmptyParts);
-        int length = list.size();
-        for (int i = length - 1; i >= 1; i--)
-        {
-            if (!list.at(i).contains(QRegularExpression("[<>=]")))
-            {
-                list[i-1] += " " + list[i];
-                list.removeAt(i);
-            }
-        }
+        data = lineEnd + 1;
+    }
+
+    inputFile.close();
+    _openFilePaths.removeAll(filename);
+}
 
-        // Trim spaces and remove empty fields
-        length = list.size();
-        for (int i = length - 1; i >= 0; i--)
+void InputParserSfz::parseLine(const char * begin, const char * end, bool &success, QString &error)
+{
+    // An element starts with the first word of the line or with a word containing '<', '>' or '='
+    // It goes until the next element, so that values can contain spaces
+    const char * elementBegin = nullptr;
+    const char * pos = begin;
+    while (pos < end)
+    {
+        // Skip spaces
+        while (pos < end && (*pos == ' ' || *pos == '\t'))
+            pos++;
+        if (pos == end)
+            break;
+
+        // Find the end of the word
+        const char * wordBegin = pos;
+        bool isNewElement = (elementBegin == nullptr);
+        while (pos < end && *pos != ' ' && *pos != '\t')
         {
-            QString strTmp = list.at(i).trimmed();
-            if (strTmp.isEmpty())
-                list.removeAt(i);
-            else
-                list[i] = strTmp;
+            if (*pos == '<' || *pos == '>' || *pos == '=')
+                isNewElement = true;
+            pos++;
         }
 
-        // Store elements
-        foreach (QString str, list)
+        if (isNewElement)
         {
-            // Valid?
-            if (str.size() <= 2)
-                continue;
-
-            if (str.indexOf("#include") == 0)
+            if (elementBegin != nullptr)
             {
-                // Read another file
-                QString otherFile = getFilePathFromInclude(str);
-                this->parseFile(otherFile, success, error);
-
-                // In case of error, return immediately
+                parseElement(elementBegin, wordBegin, success, error);
                 if (!success)
-                {
-                    inputFile.close();
                     return;
-                }
-            }
-            else if (str.indexOf("#define") == 0)
-            {
-                QStringList splitTmp = str.split(' ', Qt::SkipEmptyParts);
-                if (splitTmp.size() == 3)
-                    _replacements[splitTmp[1]] = splitTmp[2];
-            }
-            else if (str.left(1) == "<" && str.right(1) == ">")
-                changeBloc(str.right(str.size()-1).left(str.size()-2));
-            else if (str.contains("="))
-            {
-                int index = str.indexOf("=");
-                QString opcode = str.left(index).toLower();
-                QString value = this->applyReplacements(str.right(str.length() - index - 1));
-                if (!opcode.isEmpty() && !value.isEmpty())
-                    addOpcode(opcode, value);
             }
+            elementBegin = wordBegin;
         }
     }
-    inputFile.close();
-    _openFilePaths.removeAll(filename);
 
-    success = true;
+    if (elementBegin != nullptr)
+        parseElement(elementBegin, end, success, error);
+}
+
+void InputParserSfz::parseElement(const char * begin, const char * end, bool &success, QString &error)
+{
+    // Trim spaces
+    while (begin < end && (*begin == ' ' || *begin == '\t'))
+        begin++;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t'))
+        end--;
+
+    // Valid?
+    int length = static_cast<int>(end - begin);
+    if (length <= 2)
+        return;
+
+    if (length >= 8 && memcmp(begin, "#include", 8) == 0)
+    {
+        // Read another file
+        QString otherFile = getFilePathFromInclude(QString::fromUtf8(begin, length));
+        this->parseFile(otherFile, success, error);
+    }
+    else if (length >= 7 && memcmp(begin, "#define", 7) == 0)
+    {
+        QStringList splitTmp = QString::fromUtf8(begin, length).simplified().split(' ', Qt::SkipEmptyParts);
+        if (splitTmp.size() == 3)
+            _replacements[splitTmp[1]] = splitTmp[2];
+    }
+    else if (*begin == '<')
+    {
+        // Header, possibly directly followed by an opcode
+        const char * headerEnd = static_cast<const char *>(memchr(begin, '>', length));
+        if (headerEnd != nullptr)
+        {
+            changeBloc(QString::fromLatin1(begin + 1, static_cast<int>(headerEnd - begin - 1)));
+            if (headerEnd + 1 < end)
+                parseElement(headerEnd + 1, end, success, error);
+        }
+    }
+    else
+    {
+        const char * equalPos = static_cast<const char *>(memchr(begin, '=', length));
+        if (equalPos != nullptr)
+        {
+            QString opcode = QString::fromLatin1(begin, static_cast<int>(equalPos - begin)).toLower();
+            QString value = this->applyReplacements(QString::fromUtf8(equalPos + 1, static_cast<int>(end - equalPos - 1)));
+            if (!opcode.isEmpty() && !value.isEmpty())
+                addOpcode(opcode, value);
+        }
+    }
 }
 
 QString InputParserSfz::getFilePathFromInclude(QString str)
@@ -216,8 +276,8 @@ QString InputParserSfz::getFilePathFromInclude(QString str)
 
 QString InputParserSfz::applyReplacements(QString opcodeValue)
 {
-    foreach (QString key, _replacements.keys())
-        opcodeValue = opcodeValue.replace(key, _replacements[key]);
+    for (QMap<QString, QString>::const_iterator it = _replacements.constBegin(); it != _replacements.constEnd(); ++it)
+        opcodeValue.replace(it.key(), it.value());
     return opcodeValue;
 }
 
@@ -251,28 +311,27 @@ void InputParserSfz::addOpcode(QString opcode, QString value)
     switch (_currentBloc)
     {
     case BLOC_GROUP: case BLOC_REGION:
-        _presetList.last().addParam(opcode, value);
+        _presetList.last().addParam(opcode, value, _defaultPath);
         break;
     case BLOC_CONTROL:
         if (opcode == "default_path")
         {
-            QString defaultPath = value.replace("\\", "/");
-            if (!defaultPath.isEmpty() && defaultPath[0] == '/')
-                defaultPath = defaultPath.right(defaultPath.size() - 1);
-            if (!defaultPath.isEmpty() && defaultPath.endsWith('/'))
-                defaultPath = defaultPath.left(defaultPath.size() - 1);
-            SfzParameter::DEFAULT_PATH = defaultPath;
+            _defaultPath = value.replace("\\", "/");
+            if (!_defaultPath.isEmpty() && _defaultPath[0] == '/')
+                _defaultPath = _defaultPath.right(_defaultPath.size() - 1);
+            if (!_defaultPath.isEmpty() && _defaultPath.endsWith('/'))
+                _defaultPath = _defaultPath.left(_defaultPath.size() - 1);
         }
         break;
     case BLOC_GLOBAL:
-        _globalZone << SfzParameter(opcode, value);
+        _globalZone << SfzParameter(opcode, value, _defaultPath);
         break;
     case BLOC_UNKNOWN:
         break;
     }
 }
 
-void InputParserSfz::createSf2(int &sf2Index, QString filename, bool isChannel10)
+void InputParserSfz::createSf2(int &sf2Index, QString filename, bool isChannel10, SfzSampleIndex &sampleIndex)
 {
     SoundfontManager * sm = SoundfontManager::getInstance();
     int numBank = 0;
@@ -285,6 +344,7 @@ void InputParserSfz::createSf2(int &sf2Index, QString filename, bool isChannel10
     {
         idSf2.indexSf2 = sm->add(idSf2);
         sf2Index = idSf2.indexSf2;
+        sm->beginBulkLoad(sf2Index);
         sm->set(idSf2, champ_name, nom);
     }
     else
@@ -306,6 +366,9 @@ void InputParserSfz::createSf2(int &sf2Index, QString filename, bool isChannel10
     val.wValue = numPreset;
     sm->set(idPrst, champ_wPreset, val);
 
+    // Index the existing samples
+    sampleIndex.load(sm, idSf2.indexSf2);
+
     // Create instruments
     EltID idInst(elementInst, idSf2.indexSf2);
     for (int i = 0; i < _presetList.size(); i++)
@@ -334,7 +397,7 @@ void InputParserSfz::createSf2(int &sf2Index, QString filename, bool isChannel10
         sm->set(idPrstInst, champ_instrument, val);
 
         // Fill the instrument and create samples
-        _presetList[i].decode(sm, idInst, QFileInfo(filename).path());
+        _presetList[i].decode(sm, idInst, QFileInfo(filename).path(), sampleIndex);
 
         // Find the preset keyRange and velRange
         int keyMin = 127;
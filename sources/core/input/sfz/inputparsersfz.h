@@ -28,6 +28,7 @@
 #include "abstractinputparser.h"
 #include "sfzparametergroup.h"
 class SoundfontManager;
+class SfzSampleIndex;
 
 class InputParserSfz : public AbstractInputParser
 {
@@ -54,15 +55,18 @@ private:
     SfzParameterRegion _globalZone;
     QStringList _openFilePaths;
     QString _rootDir;
+    QString _defaultPath; // Prefix of the sample paths, specific to each file parsed
     QMap<QString, QString> _replacements;
 
     void parseFile(QString filename, bool &success, QString &error);
+    void parseLine(const char * begin, const char * end, bool &success, QString &error);
+    void parseElement(const char * begin, const char * end, bool &success, QString &error);
     QString applyReplacements(QString opcodeValue);
     QString getFilePathFromInclude(QString str);
     void changeBloc(QString bloc);
     void addOpcode(QString opcode, QString value);
 
-    void createSf2(int &sf2Index, QString filename, bool isChannel10);
+    void createSf2(int &sf2Index, QString filename, bool isChannel10, SfzSampleIndex &sampleIndex);
     QString getInstrumentName(QString filePath, int &numBank, int &numPreset);
 };
 
@@ -23,376 +23,155 @@
 ***************************************************************************/
 
 #include "sfzparameter.h"
-#include "contextmanager.h"
+#include "keynamemanager.h"
 #include <QDebug>
 
-QString SfzParameter::DEFAULT_PATH = "";
-
-SfzParameter::SfzParameter(QString opcode, QString valeur) :
-    _opcode(op_unknown),
+SfzParameter::SfzParameter(QString opcode, QString valeur, QString defaultPath) :
+    _opcode(getOpCode(opcode)),
     _intValue(0),
     _dblValue(0.)
 {
     QString valeurLow = valeur.toLower();
-    opcode = opcode.remove('_');
-    if (opcode == "sample")
+    switch (_opcode)
     {
-        _opcode = op_sample;
+    case op_sample:
         _strValue = valeur.replace("\\", "/");
         if (!_strValue.isEmpty() && _strValue[0] == '/')
             _strValue = _strValue.right(_strValue.size() - 1);
-        if (!DEFAULT_PATH.isEmpty())
-            _strValue = DEFAULT_PATH + "/" + _strValue;
-    }
-    else if (opcode == "key")
-    {
-        _opcode = op_key;
-        _intValue = ContextManager::keyName()->getKeyNum(valeurLow, true);
-    }
-    else if (opcode == "lokey")
-    {
-        _opcode = op_keyMin;
-        _intValue = ContextManager::keyName()->getKeyNum(valeurLow, true);
-    }
-    else if (opcode == "hikey")
-    {
-        _opcode = op_keyMax;
-        _intValue = ContextManager::keyName()->getKeyNum(valeurLow, true);
-    }
-    else if (opcode == "lovel")
-    {
-        _opcode = op_velMin;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "hivel")
-    {
-        _opcode = op_velMax;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "pitchkeycenter")
-    {
-        _opcode = op_rootKey;
-        _intValue = ContextManager::keyName()->getKeyNum(valeurLow, true);
-    }
-    else if (opcode == "group")
-    {
-        _opcode = op_exclusiveClass;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "offby")
-    {
-        _opcode = op_off_by;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "tune")
-    {
-        _opcode = op_tuningFine;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "transpose")
-    {
-        _opcode = op_tuningCoarse;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "delay")
-    {
-        _opcode = op_delay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "offset")
-    {
-        _opcode = op_offset;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "end")
-    {
-        _opcode = op_end;
-        _intValue = valeurLow.toInt() + 1;
-    }
-    else if (opcode == "loopstart")
-    {
-        _opcode = op_loop_start;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "loopend")
-    {
-        _opcode = op_loop_end;
+        if (!defaultPath.isEmpty())
+            _strValue = defaultPath + "/" + _strValue;
+        break;
+    case op_key: case op_keyMin: case op_keyMax: case op_rootKey: case op_fil_keycenter:
+        _intValue = KeyNameManager::getInstance()->getKeyNum(valeurLow, true);
+        break;
+    case op_velMin: case op_velMax: case op_chanMin: case op_chanMax:
+    case op_exclusiveClass: case op_off_by: case op_tuningFine: case op_tuningCoarse:
+    case op_offset: case op_loop_start: case op_tuningScale:
+    case op_vibLFOtoTon: case op_modEnvToTon: case op_modEnvToFilter: case op_modLFOtoFilter:
+    case op_fil_veltrack: case op_fil_keytrack:
+        _intValue = valeurLow.toInt();
+        break;
+    case op_end: case op_loop_end:
         _intValue = valeurLow.toInt() + 1;
-    }
-    else if (opcode == "loopmode")
-    {
-        _opcode = op_loop_mode;
-        _strValue = valeurLow;
-    }
-    else if (opcode == "pan")
-    {
-        _opcode = op_pan;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "width")
-    {
-        _opcode = op_width;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "position")
-    {
-        _opcode = op_position;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "volume")
-    {
-        _opcode = op_volume;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchkeytrack")
-    {
-        _opcode = op_tuningScale;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "ampegdelay")
-    {
-        _opcode = op_ampeg_delay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampegattack")
-    {
-        _opcode = op_ampeg_attack;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampeghold")
-    {
-        _opcode = op_ampeg_hold;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampegdecay")
-    {
-        _opcode = op_ampeg_decay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampegsustain")
-    {
-        _opcode = op_ampeg_sustain;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampegrelease")
-    {
-        _opcode = op_ampeg_release;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampegholdcc133")
-    {
-        _opcode = op_noteToVolEnvHold;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampegdecaycc133")
-    {
-        _opcode = op_noteToVolEnvDecay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "effect1")
-    {
-        _opcode = op_reverb;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "effect2")
-    {
-        _opcode = op_chorus;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filtype")
-    {
-        _opcode = op_filterType;
-        _strValue = valeurLow;
-    }
-    else if (opcode == "cutoff")
-    {
-        _opcode = op_filterFreq;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "resonance")
-    {
-        _opcode = op_filterQ;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchlfodelay")
-    {
-        _opcode = op_vibLFOdelay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchlfofreq")
-    {
-        _opcode = op_vibLFOfreq;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchlfodepth")
-    {
-        _opcode = op_vibLFOtoTon;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "pitchegdelay")
-    {
-        _opcode = op_pitcheg_delay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchegattack")
-    {
-        _opcode = op_pitcheg_attack;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitcheghold")
-    {
-        _opcode = op_pitcheg_hold;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchegdecay")
-    {
-        _opcode = op_pitcheg_decay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchegsustain")
-    {
-        _opcode = op_pitcheg_sustain;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchegrelease")
-    {
-        _opcode = op_pitcheg_release;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchegdepth")
-    {
-        _opcode = op_modEnvToTon;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "pitchegholdcc133")
-    {
-        _opcode = op_noteToModEnvHold;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "pitchegdecaycc133")
-    {
-        _opcode = op_noteToModEnvDecay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "amplfodelay")
-    {
-        _opcode = op_modLFOdelay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "amplfofreq")
-    {
-        _opcode = op_modLFOfreq;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "amplfodepth")
-    {
-        _opcode = op_modLFOtoVolume;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampveltrack")
-    {
-        _opcode = op_amp_veltrack;
+        break;
+    case op_amp_veltrack:
         _intValue = valeurLow.toDouble();
+        break;
+    case op_loop_mode: case op_filterType:
+        _strValue = valeurLow;
+        break;
+    case op_delay: case op_pan: case op_width: case op_position: case op_volume:
+    case op_reverb: case op_chorus: case op_filterFreq: case op_filterQ:
+    case op_amp_velcurve_1: case op_amp_velcurve_127:
+    case op_ampeg_delay: case op_ampeg_attack: case op_ampeg_hold: case op_ampeg_decay:
+    case op_ampeg_sustain: case op_ampeg_release: case op_noteToVolEnvHold: case op_noteToVolEnvDecay:
+    case op_modLFOdelay: case op_modLFOfreq: case op_modLFOtoVolume:
+    case op_pitcheg_delay: case op_pitcheg_attack: case op_pitcheg_hold: case op_pitcheg_decay:
+    case op_pitcheg_sustain: case op_pitcheg_release: case op_noteToModEnvHold: case op_noteToModEnvDecay:
+    case op_vibLFOdelay: case op_vibLFOfreq:
+    case op_fileg_delay: case op_fileg_attack: case op_fileg_hold: case op_fileg_decay:
+    case op_fileg_sustain: case op_fileg_release: case op_fileg_holdcc133: case op_fileg_decaycc133:
+    case op_filLFOdelay: case op_filLFOfreq:
+        _dblValue = valeurLow.toDouble();
+        break;
+    case op_unknown:
+        // No warning for "trigger=attack" (default behaviour)
+        if (opcode.remove('_') != "trigger" || valeur != "attack")
+            qWarning() << "opcode not supported: " + opcode + " (" + valeur + ")";
+        break;
     }
-    else if (opcode == "ampvelcurve1")
-    {
-        _opcode = op_amp_velcurve_1;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "ampvelcurve127")
-    {
-        _opcode = op_amp_velcurve_127;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegdelay")
-    {
-        _opcode = op_fileg_delay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegattack")
-    {
-        _opcode = op_fileg_attack;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "fileghold")
-    {
-        _opcode = op_fileg_hold;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegdecay")
-    {
-        _opcode = op_fileg_decay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegsustain")
-    {
-        _opcode = op_fileg_sustain;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegrelease")
-    {
-        _opcode = op_fileg_release;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegdepth")
-    {
-        _opcode = op_modEnvToFilter;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "filegholdcc133")
-    {
-        _opcode = op_fileg_holdcc133;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "filegdecaycc133")
-    {
-        _opcode = op_fileg_decaycc133;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "fillfodelay")
-    {
-        _opcode = op_filLFOdelay;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "fillfofreq")
-    {
-        _opcode = op_filLFOfreq;
-        _dblValue = valeurLow.toDouble();
-    }
-    else if (opcode == "fillfodepth")
-    {
-        _opcode = op_modLFOtoFilter;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "lochan")
-    {
-        _opcode = op_chanMin;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "hichan")
-    {
-        _opcode = op_chanMax;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "filveltrack")
-    {
-        _opcode = op_fil_veltrack;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "filkeytrack")
-    {
-        _opcode = op_fil_keytrack;
-        _intValue = valeurLow.toInt();
-    }
-    else if (opcode == "filkeycenter")
-    {
-        _opcode = op_fil_keycenter;
-        _intValue = ContextManager::keyName()->getKeyNum(valeurLow, true);
-    }
-    else if (opcode == "trigger" && valeur == "attack")
-    {
-        // Nothing to do, no warning
-    }
-    else
-        qWarning() << "opcode not supported: " + opcode + " (" + valeur + ")";
+}
+
+SfzParameter::OpCode SfzParameter::getOpCode(const QString &opcode)
+{
+    // Opcodes are compared without the underscores
+    char name[32];
+    int length = 0;
+    for (int i = 0; i < opcode.size(); i++)
+    {
+        char c = opcode[i].toLatin1();
+        if (c == '_')
+            continue;
+        if (length >= (int)sizeof(name) || c <= 0)
+            return op_unknown;
+        name[length++] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+    }
+    return opCodes().value(QByteArray::fromRawData(name, length), op_unknown);
+}
+
+const QHash<QByteArray, SfzParameter::OpCode> &SfzParameter::opCodes()
+{
+    static const QHash<QByteArray, OpCode> s_opCodes = {
+        {"sample", op_sample},
+        {"key", op_key},
+        {"lokey", op_keyMin},
+        {"hikey", op_keyMax},
+        {"lovel", op_velMin},
+        {"hivel", op_velMax},
+        {"lochan", op_chanMin},
+        {"hichan", op_chanMax},
+        {"pitchkeycenter", op_rootKey},
+        {"group", op_exclusiveClass},
+        {"offby", op_off_by},
+        {"tune", op_tuningFine},
+        {"transpose", op_tuningCoarse},
+        {"delay", op_delay},
+        {"offset", op_offset},
+        {"end", op_end},
+        {"loopstart", op_loop_start},
+        {"loopend", op_loop_end},
+        {"loopmode", op_loop_mode},
+        {"volume", op_volume},
+        {"pan", op_pan},
+        {"width", op_width},
+        {"position", op_position},
+        {"pitchkeytrack", op_tuningScale},
+        {"effect1", op_reverb},
+        {"effect2", op_chorus},
+        {"filtype", op_filterType},
+        {"cutoff", op_filterFreq},
+        {"resonance", op_filterQ},
+        {"filveltrack", op_fil_veltrack},
+        {"filkeytrack", op_fil_keytrack},
+        {"filkeycenter", op_fil_keycenter},
+        {"ampveltrack", op_amp_veltrack},
+        {"ampvelcurve1", op_amp_velcurve_1},
+        {"ampvelcurve127", op_amp_velcurve_127},
+        {"ampegdelay", op_ampeg_delay},
+        {"ampegattack", op_ampeg_attack},
+        {"ampeghold", op_ampeg_hold},
+        {"ampegdecay", op_ampeg_decay},
+        {"ampegsustain", op_ampeg_sustain},
+        {"ampegrelease", op_ampeg_release},
+        {"ampegholdcc133", op_noteToVolEnvHold},
+        {"ampegdecaycc133", op_noteToVolEnvDecay},
+        {"amplfodelay", op_modLFOdelay},
+        {"amplfofreq", op_modLFOfreq},
+        {"amplfodepth", op_modLFOtoVolume},
+        {"pitchegdelay", op_pitcheg_delay},
+        {"pitchegattack", op_pitcheg_attack},
+        {"pitcheghold", op_pitcheg_hold},
+        {"pitchegdecay", op_pitcheg_decay},
+        {"pitchegsustain", op_pitcheg_sustain},
+        {"pitchegrelease", op_pitcheg_release},
+        {"pitchegholdcc133", op_noteToModEnvHold},
+        {"pitchegdecaycc133", op_noteToModEnvDecay},
+        {"pitchegdepth", op_modEnvToTon},
+        {"pitchlfodelay", op_vibLFOdelay},
+        {"pitchlfofreq", op_vibLFOfreq},
+        {"pitchlfodepth", op_vibLFOtoTon},
+        {"filegdelay", op_fileg_delay},
+        {"filegattack", op_fileg_attack},
+        {"fileghold", op_fileg_hold},
+        {"filegdecay", op_fileg_decay},
+        {"filegsustain", op_fileg_sustain},
+        {"filegrelease", op_fileg_release},
+        {"filegdepth", op_modEnvToFilter},
+        {"filegholdcc133", op_fileg_holdcc133},
+        {"filegdecaycc133", op_fileg_decaycc133},
+        {"fillfodelay", op_filLFOdelay},
+        {"fillfofreq", op_filLFOfreq},
+        {"fillfodepth", op_modLFOtoFilter}
+    };
+    return s_opCodes;
 }
@@ -26,6 +26,7 @@
 #define SFZPARAMETER_H
 
 #include <QString>
+#include <QHash>
 
 class SfzParameter
 {
@@ -119,7 +120,8 @@ public:
         op_modLFOtoFilter
     };
 
-    SfzParameter(QString opcode, QString valeur);
+    // The default path prefixes the sample paths
+    SfzParameter(QString opcode, QString valeur, QString defaultPath = "");
     SfzParameter(OpCode opcode, int valeur) :
         _opcode(opcode),
         _intValue(valeur),
@@ -143,8 +145,12 @@ public:
     void    setIntValue(int value)       { _intValue = value; }
     void    setDoubleValue(double value) { _dblValue = value; }
 
-    static QString DEFAULT_PATH;
+    // Opcode corresponding to a name (case insensitive, underscores being ignored)
+    static OpCode getOpCode(const QString &opcode);
+
 private:
+    static const QHash<QByteArray, OpCode> &opCodes();
+
     OpCode  _opcode;
     int     _intValue;
     double  _dblValue;
@@ -156,11 +156,11 @@ void SfzParameterGroup::adjustVolume(double offset)
         _regionList[i].adjustVolume(offset);
 }
 
-void SfzParameterGroup::adjustCorrection(QString path)
+void SfzParameterGroup::adjustCorrection(QString path, SfzSampleIndex &sampleIndex)
 {
     int defaultCorrection = _paramGlobaux.getIntValue(SfzParameter::op_tuningFine);
     for (int i = 0; i < _regionList.size(); i++)
-        _regionList[i].adjustCorrection(path, defaultCorrection);
+        _regionList[i].adjustCorrection(path, defaultCorrection, sampleIndex);
 }
 
 void SfzParameterGroup::adjustModulationVolume()
@@ -191,6 +191,15 @@ void SfzParameterGroup::checkSampleValid(QString path)
             _regionList.removeAt(i);
 }
 
+QStringList SfzParameterGroup::getSamplePaths(QString path)
+{
+    QStringList paths;
+    for (int i = 0; i < _regionList.size(); i++)
+        if (_regionList.at(i).isDefined(SfzParameter::op_sample))
+            paths << path + "/" + _regionList.at(i).getStrValue(SfzParameter::op_sample);
+    return paths;
+}
+
 void SfzParameterGroup::checkFilter()
 {
     _paramGlobaux.checkFilter();
@@ -219,7 +228,7 @@ double SfzParameterGroup::getAmpliMax()
     return ampliMax;
 }
 
-void SfzParameterGroup::decode(SoundfontManager * sf2, EltID idInst, QString pathSfz)
+void SfzParameterGroup::decode(SoundfontManager * sf2, EltID idInst, QString pathSfz, SfzSampleIndex &sampleIndex)
 {
     // Fill the parameters of the global division
     _paramGlobaux.decode(sf2, idInst);
@@ -233,7 +242,7 @@ void SfzParameterGroup::decode(SoundfontManager * sf2, EltID idInst, QString pat
     for (int i = 0; i < _regionList.size(); i++)
     {
         // Create samples if needed and get their index
-        QList<int> listeIndexSmpl = _regionList.at(i).getSampleIndex(sf2, idInst, pathSfz);
+        QList<int> listeIndexSmpl = _regionList.at(i).getSampleIndex(sf2, idInst, pathSfz, sampleIndex);
 
         // Process possible offsets
         if (!listeIndexSmpl.isEmpty())
@@ -32,17 +32,17 @@ class SfzParameterGroup
 public:
     SfzParameterGroup() {}
     void newGroup() { _regionList << SfzParameterRegion(); }
-    void addParam(QString opcode, QString valeur)
+    void addParam(QString opcode, QString valeur, QString defaultPath)
     {
         if (_regionList.size() == 0)
         {
             if (opcode == "group_label")
                 _label = valeur;
             else
-                _paramGlobaux << SfzParameter(opcode, valeur);
+                _paramGlobaux << SfzParameter(opcode, valeur, defaultPath);
         }
         else
-            _regionList.last() << SfzParameter(opcode, valeur);
+            _regionList.last() << SfzParameter(opcode, valeur, defaultPath);
     }
     void moveOpcodesInGlobal(SfzParameterRegion &globalZone);
     void moveKeynumInSamples(SfzParameter::OpCode opCodeKeynum, SfzParameter::OpCode opCodeBase);
@@ -50,9 +50,10 @@ public:
     void moveModInSamples();
     void moveModInSamples(QList<SfzParameter::OpCode> opCodeList);
     void checkSampleValid(QString path);
+    QStringList getSamplePaths(QString path);
     void checkFilter();
     void checkKeyTrackedFilter();
-    void adjustCorrection(QString path);
+    void adjustCorrection(QString path, SfzSampleIndex &sampleIndex);
     void adjustModulationVolume();
     bool isChannel10();
     double getAmpliMax();
@@ -60,7 +61,7 @@ public:
     QString getLabel() { return _label; }
 
     // Decode
-    void decode(SoundfontManager * sf2, EltID idInst, QString pathSfz);
+    void decode(SoundfontManager * sf2, EltID idInst, QString pathSfz, SfzSampleIndex &sampleIndex);
 
 private:
     static double limit(double value, double min, double max);
@@ -24,8 +24,10 @@
 
 #include "sfzparameterregion.h"
 #include "soundfontmanager.h"
+#include "sfzsampleindex.h"
+#include "sound.h"
 
-QList<int> SfzParameterRegion::getSampleIndex(SoundfontManager *sf2, EltID idElt, QString pathSfz) const
+QList<int> SfzParameterRegion::getSampleIndex(SoundfontManager *sf2, EltID idElt, QString pathSfz, SfzSampleIndex &index) const
 {
     QList<int> sampleIndex;
 
@@ -37,38 +39,36 @@ QList<int> SfzParameterRegion::getSampleIndex(SoundfontManager *sf2, EltID idElt
     if (indexOpSample == -1)
         return sampleIndex;
 
-    // Build the file path
+    // Build the file path (the result is kept for the next regions using the same sample)
     QString filePath =  _listeParam.at(indexOpSample).getStringValue();
-    QString fileName = pathSfz + "/" + filePath;
-    if (!QFile(fileName).exists())
+    QString key = pathSfz + "/" + filePath;
+    QString fileName;
+    if (index.resolvedPaths.contains(key))
+        fileName = index.resolvedPaths[key];
+    else
     {
-        QStringList list = getFullPath(pathSfz, filePath.split("/", Qt::SkipEmptyParts));
-        if (!list.isEmpty())
-            fileName = list.first();
-        else
-            return sampleIndex;
+        fileName = key;
+        if (!QFile(fileName).exists())
+        {
+            QStringList list = getFullPath(pathSfz, filePath.split("/", Qt::SkipEmptyParts));
+            fileName = list.isEmpty() ? "" : list.first();
+        }
+        index.resolvedPaths[key] = fileName;
     }
+    if (fileName.isEmpty())
+        return sampleIndex;
 
     // Sample already loaded?
     idElt.typeElement = elementSmpl;
-    QStringList names;
-    foreach (int i, sf2->getSiblings(idElt))
-    {
-        idElt.indexElt = i;
-        if (sf2->getQstr(idElt, champ_filenameForData) == fileName)
-            sampleIndex << i;
-        names << sf2->getQstr(idElt, champ_name);
-    }
+    sampleIndex = index.samplesByPath.value(fileName);
     if (!sampleIndex.isEmpty())
         return sampleIndex;
 
     // Gather sample information
-    Sound son;
-    if (!son.setFileName(fileName, false))
-    {
+    Sound * son = index.getSound(fileName);
+    if (son == nullptr)
         return sampleIndex;
-    }
-    int nChannels = son.getUInt32(champ_wChannels);
+    int nChannels = son->getUInt32(champ_wChannels);
     QString nom = QFileInfo(fileName).completeBaseName();
     QString nom2 = nom;
 
@@ -76,8 +76,8 @@ QList<int> SfzParameterRegion::getSampleIndex(SoundfontManager *sf2, EltID idElt
     int suffixNumber = 0;
     if (nChannels == 2)
     {
-        while ((names.contains(getName(nom, 20, suffixNumber, "L"), Qt::CaseInsensitive) ||
-                names.contains(getName(nom, 20, suffixNumber, "R"), Qt::CaseInsensitive)) &&
+        while ((index.lowerCaseNames.contains(getName(nom, 20, suffixNumber, "L").toLower()) ||
+                index.lowerCaseNames.contains(getName(nom, 20, suffixNumber, "R").toLower())) &&
                suffixNumber < 100)
         {
             suffixNumber++;
@@ -87,7 +87,7 @@ QList<int> SfzParameterRegion::getSampleIndex(SoundfontManager *sf2, EltID idElt
     }
     else
     {
-        while (names.contains(getName(nom, 20, suffixNumber), Qt::CaseInsensitive) && suffixNumber < 100)
+        while (index.lowerCaseNames.contains(getName(nom, 20, suffixNumber).toLower()) && suffixNumber < 100)
         {
             suffixNumber++;
         }
@@ -130,28 +130,34 @@ QList<int> SfzParameterRegion::getSampleIndex(SoundfontManager *sf2, EltID idElt
             sf2->set(idElt, champ_sfSampleType, val);
         }
         sf2->set(idElt, champ_filenameForData, fileName);
-        val.dwValue = son.getUInt32(champ_dwStart16);
+        val.dwValue = son->getUInt32(champ_dwStart16);
         sf2->set(idElt, champ_dwStart16, val);
-        val.dwValue = son.getUInt32(champ_dwStart24);
+        val.dwValue = son->getUInt32(champ_dwStart24);
         sf2->set(idElt, champ_dwStart24, val);
         val.wValue = numChannel;
         sf2->set(idElt, champ_wChannel, val);
-        val.dwValue = son.getUInt32(champ_dwLength);
+        val.dwValue = son->getUInt32(champ_dwLength);
         sf2->set(idElt, champ_dwLength, val);
-        val.dwValue = son.getUInt32(champ_dwSampleRate);
+        val.dwValue = son->getUInt32(champ_dwSampleRate);
         sf2->set(idElt, champ_dwSampleRate, val);
-        val.dwValue = son.getUInt32(champ_dwStartLoop);
+        val.dwValue = son->getUInt32(champ_dwStartLoop);
         sf2->set(idElt, champ_dwStartLoop, val);
-        val.dwValue = son.getUInt32(champ_dwEndLoop);
+        val.dwValue = son->getUInt32(champ_dwEndLoop);
         sf2->set(idElt, champ_dwEndLoop, val);
-        val.bValue = (quint8)son.getUInt32(champ_byOriginalPitch);
+        val.bValue = (quint8)son->getUInt32(champ_byOriginalPitch);
         sf2->set(idElt, champ_byOriginalPitch, val);
-        val.cValue = (char)son.getInt32(champ_chPitchCorrection);
+        val.cValue = (char)son->getInt32(champ_chPitchCorrection);
         sf2->set(idElt, champ_chPitchCorrection, val);
-        val.wValue = son.getUInt32(champ_bpsFile);
+        val.wValue = son->getUInt32(champ_bpsFile);
         sf2->set(idElt, champ_bpsFile, val);
     }
 
+    // Update the index
+    index.samplesByPath[fileName] = sampleIndex;
+    index.lowerCaseNames << nom.toLower();
+    if (nChannels == 2)
+        index.lowerCaseNames << nom2.toLower();
+
     return sampleIndex;
 }
 
@@ -170,14 +176,12 @@ void SfzParameterRegion::adaptOffsets(int startLoop, int endLoop, int length)
         _listeParam << SfzParameter("loop_mode", "loop_continuous");
 }
 
-void SfzParameterRegion::adjustCorrection(QString path, int defaultCorrection)
+void SfzParameterRegion::adjustCorrection(QString path, int defaultCorrection, SfzSampleIndex &sampleIndex)
 {
     QString sample = getStrValue(SfzParameter::op_sample);
     if (!sample.isEmpty())
     {
-        Sound son;
-        son.setFileName(path + "/" + sample);
-        int correctionSample = son.getInt32(champ_chPitchCorrection);
+        int correctionSample = sampleIndex.getCorrection(path + "/" + sample);
         if (correctionSample != 0)
             adjustCorrection(correctionSample, defaultCorrection);
     }
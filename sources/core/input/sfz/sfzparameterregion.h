@@ -28,6 +28,7 @@
 #include "sfzparameter.h"
 #include "basetypes.h"
 class SoundfontManager;
+class SfzSampleIndex;
 
 class SfzParameterRegion
 {
@@ -39,9 +40,9 @@ public:
 
     // Decode
     void decode(SoundfontManager * sf2, EltID idElt);
-    QList<int> getSampleIndex(SoundfontManager * sf2, EltID idElt, QString pathSfz) const;
+    QList<int> getSampleIndex(SoundfontManager * sf2, EltID idElt, QString pathSfz, SfzSampleIndex &sampleIndex) const;
     void adaptOffsets(int startLoop, int endLoop, int length);
-    void adjustCorrection(QString path, int defaultCorrection);
+    void adjustCorrection(QString path, int defaultCorrection, SfzSampleIndex &sampleIndex);
     bool sampleValid(QString path);
     void checkFilter();
     void checkKeyTrackedFilter(bool remove);
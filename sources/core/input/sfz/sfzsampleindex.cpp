@@ -0,0 +1,108 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "sfzsampleindex.h"
+#include "soundfontmanager.h"
+#include "sound.h"
+#include <QRunnable>
+#include <QThreadPool>
+
+class RunnableSfzProbe: public QRunnable
+{
+public:
+    RunnableSfzProbe(SfzSampleIndex * index, QString filePath) : QRunnable(),
+        _index(index),
+        _filePath(filePath)
+    {}
+
+    void run() override
+    {
+        _index->probeFile(_filePath);
+    }
+
+private:
+    SfzSampleIndex * _index;
+    QString _filePath;
+};
+
+SfzSampleIndex::~SfzSampleIndex()
+{
+    qDeleteAll(_sounds);
+}
+
+void SfzSampleIndex::probe(QStringList filePaths)
+{
+    // Dedicated pool, the import itself may run in the global one
+    QThreadPool pool;
+    filePaths.removeDuplicates();
+    foreach (QString filePath, filePaths)
+        if (!_corrections.contains(filePath))
+            pool.start(new RunnableSfzProbe(this, filePath));
+    pool.waitForDone();
+}
+
+void SfzSampleIndex::probeFile(QString filePath)
+{
+    // Information about the sample and pitch correction
+    Sound * sound = new Sound();
+    bool isOk = sound->setFileName(filePath, false);
+    int correction = sound->getInt32(champ_chPitchCorrection);
+    if (!isOk)
+    {
+        delete sound;
+        sound = nullptr;
+    }
+
+    QMutexLocker locker(&_mutex);
+    _sounds[filePath] = sound;
+    _corrections[filePath] = correction;
+}
+
+Sound * SfzSampleIndex::getSound(QString filePath)
+{
+    if (!_corrections.contains(filePath))
+        probeFile(filePath);
+    return _sounds.value(filePath, nullptr);
+}
+
+int SfzSampleIndex::getCorrection(QString filePath)
+{
+    if (!_corrections.contains(filePath))
+        probeFile(filePath);
+    return _corrections.value(filePath, 0);
+}
+
+void SfzSampleIndex::load(SoundfontManager * sf2, int indexSf2)
+{
+    samplesByPath.clear();
+    lowerCaseNames.clear();
+
+    EltID idSmpl(elementSmpl, indexSf2);
+    foreach (int i, sf2->getSiblings(idSmpl))
+    {
+        idSmpl.indexElt = i;
+        samplesByPath[sf2->getQstr(idSmpl, champ_filenameForData)] << i;
+        lowerCaseNames << sf2->getQstr(idSmpl, champ_name).toLower();
+    }
+}
@@ -0,0 +1,68 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef SFZSAMPLEINDEX_H
+#define SFZSAMPLEINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QStringList>
+class SoundfontManager;
+class Sound;
+
+// Samples of a soundfont indexed by file path and by name, shared by all regions during an import
+// The sample files are probed once, in parallel
+class SfzSampleIndex
+{
+public:
+    SfzSampleIndex() {}
+    ~SfzSampleIndex();
+
+    // Read the header of the files, in parallel
+    void probe(QStringList filePaths);
+
+    // Result of the probe (done now if the file has not been probed yet)
+    Sound * getSound(QString filePath); // Null if the file cannot be read
+    int getCorrection(QString filePath);
+
+    // Index the samples already in a soundfont
+    void load(SoundfontManager * sf2, int indexSf2);
+
+    QHash<QString, QString> resolvedPaths; // Path in the sfz => full path of the file (empty if not found)
+    QHash<QString, QList<int> > samplesByPath; // Full path of the file => sample indexes
+    QSet<QString> lowerCaseNames;
+
+private:
+    Q_DISABLE_COPY(SfzSampleIndex)
+    friend class RunnableSfzProbe;
+
+    void probeFile(QString filePath);
+
+    QMutex _mutex;
+    QHash<QString, Sound *> _sounds;
+    QHash<QString, int> _corrections;
+};
+
+#endif // SFZSAMPLEINDEX_H
@@ -23,20 +23,30 @@
 ***************************************************************************/
 
 #include "keynamemanager.h"
-#include "confmanager.h"
+#include <QObject>
 
+KeyNameManager * KeyNameManager::s_instance = nullptr;
 
-KeyNameManager::KeyNameManager(ConfManager * configuration) :
-    _configuration(configuration)
+KeyNameManager * KeyNameManager::getInstance()
 {
-    _nameMiddleC = static_cast<NameMiddleC>(
-                _configuration->getValue(ConfManager::SECTION_DISPLAY, "name_middle_c", 0).toInt());
+    if (s_instance == nullptr)
+        s_instance = new KeyNameManager();
+    return s_instance;
 }
 
+void KeyNameManager::kill()
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+KeyNameManager::KeyNameManager() :
+    _nameMiddleC(MIDDLE_C_60)
+{}
+
 void KeyNameManager::setMiddleKey(NameMiddleC name)
 {
     _nameMiddleC = name;
-    _configuration->setValue(ConfManager::SECTION_DISPLAY, "name_middle_c", static_cast<int>(_nameMiddleC));
 }
 
 QString KeyNameManager::getKeyName(unsigned int keyNum, bool forceTexte, bool with0, bool forceC4, bool noOctave)
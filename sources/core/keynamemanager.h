@@ -26,8 +26,8 @@
 #define KEYNAMEMANAGER_H
 
 #include <QString>
-class ConfManager;
 
+// Way to name the keys, the middle C being configured by the application (numbers by default)
 class KeyNameManager
 {
 public:
@@ -42,7 +42,8 @@ public:
         MIDDLE_C_C5_WITH_FLATS
     };
 
-    KeyNameManager(ConfManager * configuration);
+    static KeyNameManager * getInstance();
+    static void kill();
 
     /// Set the name of the middle key C
     void setMiddleKey(NameMiddleC name);
@@ -64,7 +65,9 @@ public:
     int getKeyNum(QString keyName, bool forceC4 = false);
 
 private:
-    ConfManager * _configuration;
+    KeyNameManager();
+    static KeyNameManager * s_instance;
+
     NameMiddleC _nameMiddleC;
 };
 
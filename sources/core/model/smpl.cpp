@@ -26,6 +26,7 @@
 #include "utils.h"
 
 Smpl::Smpl(int row, TreeItem *parent, EltID id) : TreeItem(id, parent),
+    _sound(new Sound()),
     _row(row)
 {
 
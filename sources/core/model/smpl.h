@@ -28,6 +28,7 @@
 #include "basetypes.h"
 #include "sound.h"
 #include "treeitem.h"
+#include <QSharedPointer>
 class Soundfont;
 
 class Smpl: public TreeItem
@@ -40,7 +41,7 @@ public:
     void setName(QString name);
     QString getName() { return _name; }
 
-    Sound _sound;
+    QSharedPointer<Sound> _sound; // Kept alive by the threads using it, even if the sample is deleted
     quint16 _wSampleLink;
     SFSampleLink _sfSampleType;
 
@@ -65,6 +65,7 @@ Soundfont::Soundfont(EltID id) :
     _ISFT = "";
     _fileNameForData = "";
     _fileNameInitial = "";
+    _fileNameTemporary = "";
     _numEdition = 0;
     _nameSort = "";
 }
@@ -72,11 +73,8 @@ Soundfont::Soundfont(EltID id) :
 Soundfont::~Soundfont()
 {
     // Possibly delete a temporary file associated to the soundfont
-    if (!_fileNameForData.isEmpty() && _fileNameForData != _fileNameInitial)
-    {
-        // Delete the temporary file
-        QFile::remove(_fileNameForData);
-    }
+    if (!_fileNameTemporary.isEmpty())
+        QFile::remove(_fileNameTemporary);
 
     // Delete all presets
     for (int i = _prst.indexCount() - 1; i >= 0; i--)
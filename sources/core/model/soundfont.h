@@ -78,6 +78,7 @@ public:
 
     QString _fileNameInitial; // File that is initially opened, updated after each save
     QString _fileNameForData; // sf2 file (_fileNameInitial or extraction of the initial file). The sounds are read from this file
+    QString _fileNameTemporary; // Extraction of the initial file created when loading, if any, to be deleted with the soundfont
 
     // Other
     int _numEdition;  // editing number that is saved
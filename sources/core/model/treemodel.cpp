@@ -27,7 +27,9 @@
 #include "division.h"
 
 TreeModel::TreeModel(TreeItem * rootItem) : QAbstractItemModel(),
-    _rootItem(rootItem)
+    _rootItem(rootItem),
+    _batchCount(0),
+    _isResetting(false)
 {
 
 }
@@ -131,6 +133,12 @@ QModelIndex TreeModel::parent(const QModelIndex &index) const
 
 void TreeModel::elementBeingAdded(EltID id)
 {
+    if (_batchCount > 0)
+    {
+        structureChangedInBatch();
+        return;
+    }
+
     int position;
     QModelIndex index = getParentIndexWithPosition(id, position);
     emit(saveExpandedState());
@@ -139,12 +147,18 @@ void TreeModel::elementBeingAdded(EltID id)
 
 void TreeModel::endOfAddition()
 {
+    if (_batchCount > 0)
+        return;
+
     emit(endInsertRows());
     emit(restoreExpandedState());
 }
 
 void TreeModel::elementUpdated(EltID id)
 {
+    if (_isResetting)
+        return; // Everything will be updated at the end of the batch
+
     int position;
     QModelIndex index = getParentIndexWithPosition(id, position);
     index = this->index(position, 0, index);
@@ -188,6 +202,12 @@ void TreeModel::elementUpdated(EltID id)
 
 void TreeModel::elementBeingDeleted(EltID id, bool storeExpandedState)
 {
+    if (_batchCount > 0)
+    {
+        structureChangedInBatch();
+        return;
+    }
+
     int position;
     QModelIndex index = getParentIndexWithPosition(id, position);
 
@@ -198,18 +218,54 @@ void TreeModel::elementBeingDeleted(EltID id, bool storeExpandedState)
 
 void TreeModel::endOfDeletion()
 {
+    if (_batchCount > 0)
+        return;
+
     emit(endRemoveRows());
     emit(restoreExpandedState());
 }
 
 void TreeModel::visibilityChanged(EltID id)
 {
+    if (_isResetting)
+        return;
+
     int position;
     QModelIndex indexParent = getParentIndexWithPosition(id, position);
     QModelIndex index = this->index(position, 0, indexParent);
     emit(dataChanged(index, index));
 }
 
+void TreeModel::beginBatch()
+{
+    _batchCount++;
+}
+
+void TreeModel::endBatch()
+{
+    if (_batchCount == 0)
+        return;
+
+    // The views are updated once, if the structure changed
+    if (--_batchCount == 0 && _isResetting)
+    {
+        _isResetting = false;
+        endResetModel();
+        emit(restoreExpandedState());
+    }
+}
+
+void TreeModel::structureChangedInBatch()
+{
+    // The first change of the structure starts a reset of the model
+    if (!_isResetting)
+    {
+        _isResetting = true;
+        emit(saveExpandedState());
+        beginResetModel();
+    }
+}
+
 QModelIndex TreeModel::getParentIndexWithPosition(EltID id, int &position)
 {
     // Find the corresponding parent index of an id
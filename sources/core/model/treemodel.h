@@ -54,13 +54,22 @@ public:
     void endOfDeletion();
     void visibilityChanged(EltID id);
 
+    /// Batch of changes: the structure changes are not notified one by one,
+    /// the model is reset once at the end of the batch instead
+    void beginBatch();
+    void endBatch();
+
 signals:
     void saveExpandedState();
     void restoreExpandedState();
 
 private:
     QModelIndex getParentIndexWithPosition(EltID id, int &position);
+    void structureChangedInBatch();
+
     TreeItem * _rootItem;
+    int _batchCount;
+    bool _isResetting;
 };
 
 #endif // TREEMODEL_H
@@ -25,10 +25,11 @@
 #include "outputsf2.h"
 #include "sf2indexconverter.h"
 #include "soundfontmanager.h"
-#include "contextmanager.h"
+#include "utils.h"
 #include <QFile>
 #include <QFileInfo>
-#include "utils.h"
+
+const int OutputSf2::SAMPLE_BLOCK_SIZE = 4194304; // 4 MB
 
 OutputSf2::OutputSf2() : AbstractOutput() {}
 
@@ -320,20 +321,24 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         return;
     }
 
+    // The header and the INFO part are first built in memory
+    QByteArray data;
+    data.reserve(taille_info + 20);
+
     // entête
-    fi.write("RIFF", 4);
+    data.append("RIFF", 4);
 
     // taille du fichier -8 octets
-    fi.write((char *)&taille_fichier, 4);
-    fi.write("sfbk", 4);
+    data.append((char *)&taille_fichier, 4);
+    data.append("sfbk", 4);
 
     /////////////////////////////////////// BLOC INFO ///////////////////////////////////////
-    fi.write("LIST", 4);
-    fi.write((char *)&taille_info, 4);
-    fi.write("INFO", 4);
+    data.append("LIST", 4);
+    data.append((char *)&taille_info, 4);
+    data.append("INFO", 4);
 
-    fi.write("ifil", 4); // version, champ obligatoire
-    dwTmp = 4; fi.write((char *)&dwTmp, 4);
+    data.append("ifil", 4); // version, champ obligatoire
+    dwTmp = 4; data.append((char *)&dwTmp, 4);
     id.typeElement = elementSf2;
 
     if (sm->get(id, champ_wBpsSave).wValue == 24)
@@ -346,58 +351,47 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         sfVersionTmp.wMajor = 2;
         sfVersionTmp.wMinor = 1;
     }
-    fi.write((char *)&sfVersionTmp, 4);
+    data.append((char *)&sfVersionTmp, 4);
 
-    fi.write("isng", 4); // wavetable sound engine, champ obligatoire
+    data.append("isng", 4); // wavetable sound engine, champ obligatoire
     dwTmp = sm->getQstr(id, champ_ISNG).length();
     if (dwTmp > 255) dwTmp = 255;
     dwTmp2 = dwTmp + 2 - (dwTmp)%2;
     if (dwTmp != 0)
     {
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_ISNG).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_ISNG).toLatin1(), dwTmp2);
     }
     else
     {
         dwTmp2 = 8;
-        fi.write((char *)&dwTmp2, 4);
-        fi.write("Generic", 7);
-        charTmp = '\0';
-        fi.write(&charTmp, 1);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, "Generic", dwTmp2);
     }
-    fi.write("INAM", 4); // nom du sf2, champ obligatoire
+    data.append("INAM", 4); // nom du sf2, champ obligatoire
     dwTmp = sm->getQstr(id, champ_name).length();
     if (dwTmp > 255) dwTmp = 255;
     dwTmp2 = dwTmp + 2 - dwTmp % 2;
-    fi.write((char *)&dwTmp2, 4);
-    fi.write(sm->getQstr(id, champ_name).toLatin1());
-    charTmp = '\0';
-    for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-        fi.write(&charTmp, 1);
+    data.append((char *)&dwTmp2, 4);
+    appendText(data, sm->getQstr(id, champ_name).toLatin1(), dwTmp2);
 
     dwTmp = sm->getQstr(id, champ_IROM).length(); // identification d'une table d'onde, champ optionnel
     if (dwTmp > 0)
     {
         if (dwTmp > 255) dwTmp = 255;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("irom", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_IROM).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("irom", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_IROM).toLatin1(), dwTmp2);
     }
 
     sfVersionTmp = sm->get(id, champ_IVER).sfVerValue; // révision de la table d'onde, champ optionnel
     if (sfVersionTmp.wMinor != 0 || sfVersionTmp.wMajor != 0)
     {
-        fi.write("iver", 4);
+        data.append("iver", 4);
         dwTmp = 4;
-        fi.write((char *)&dwTmp, 4);
-        fi.write((char *)&sfVersionTmp, 4);
+        data.append((char *)&dwTmp, 4);
+        data.append((char *)&sfVersionTmp, 4);
     }
 
     dwTmp = sm->getQstr(id, champ_ICRD).length(); // date de création du sf2, champ optionnel
@@ -405,12 +399,9 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     {
         if (dwTmp > 255) dwTmp = 255;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("ICRD", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_ICRD).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("ICRD", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_ICRD).toLatin1(), dwTmp2);
     }
 
     dwTmp = sm->getQstr(id, champ_IENG).length(); // responsable de la création du sf2, champ optionnel
@@ -418,12 +409,9 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     {
         if (dwTmp > 255) dwTmp = 255;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("IENG", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_IENG).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("IENG", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_IENG).toLatin1(), dwTmp2);
     }
 
     dwTmp = sm->getQstr(id, champ_IPRD).length(); // produit de destination, champ optionnel
@@ -431,12 +419,9 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     {
         if (dwTmp > 255) dwTmp = 255;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("IPRD", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_IPRD).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("IPRD", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_IPRD).toLatin1(), dwTmp2);
     }
 
     dwTmp = sm->getQstr(id, champ_ICOP).length(); // copyright, champ optionnel
@@ -444,12 +429,9 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     {
         if (dwTmp > 255) dwTmp = 255;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("ICOP", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_ICOP).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("ICOP", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_ICOP).toLatin1(), dwTmp2);
     }
 
     dwTmp = sm->getQstr(id, champ_ICMT).length(); // commentaires, champ optionnel
@@ -464,12 +446,9 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         dwTmp = commentData.length();
         if (dwTmp > 65536) dwTmp = 65536;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("ICMT", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(commentData);
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("ICMT", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, commentData, dwTmp2);
     }
 
     dwTmp = sm->getQstr(id, champ_ISFT).length(); // outil d'édition sf2, champ optionnel
@@ -477,41 +456,55 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     {
         if (dwTmp > 255) dwTmp = 255;
         dwTmp2 = dwTmp + 2 - dwTmp % 2;
-        fi.write("ISFT", 4);
-        fi.write((char *)&dwTmp2, 4);
-        fi.write(sm->getQstr(id, champ_ISFT).toLatin1());
-        charTmp = '\0';
-        for (quint32 i = 0; i < dwTmp2 - dwTmp; i++)
-            fi.write(&charTmp, 1);
+        data.append("ISFT", 4);
+        data.append((char *)&dwTmp2, 4);
+        appendText(data, sm->getQstr(id, champ_ISFT).toLatin1(), dwTmp2);
     }
 
     /////////////////////////////////////// BLOC SDTA ///////////////////////////////////////
 
-    fi.write("LIST", 4);
+    data.append("LIST", 4);
     dwTmp = taille_smpl + taille_sm24;
-    fi.write((char *)&dwTmp, 4);
-    fi.write("sdta", 4);
-    fi.write("smpl", 4);
+    data.append((char *)&dwTmp, 4);
+    data.append("sdta", 4);
+    data.append("smpl", 4);
     taille_smpl -= 12;
-    fi.write((char *)&taille_smpl, 4);
+    data.append((char *)&taille_smpl, 4);
+
+    // Samples are then converted in a buffer that is written in large blocks
+    writeBlock(fi, data, true);
+    data.reserve(SAMPLE_BLOCK_SIZE);
+
+    // Samples not edited since they have been read from a sf2 are copied without being decoded
     id2.typeElement = elementSmpl;
+    QMap<QString, QFile *> sourceFiles;
+    QMap<int, RawSampleSource> rawSources = getRawSources(sm, id2, fileName, sourceFiles);
+
     dwTmp2 = 10 * 4 + taille_info;
     QVector<float> fData;
-    QByteArray baData;
     foreach (int i, sm->getSiblings(id2))
     {
-        // Copy each sample
+        // Copy each sample, followed by 46 null sample points
         id2.indexElt = i;
-        dwTmp = 2 * sm->get(id2, champ_dwLength).dwValue;
-        fData = sm->getData(id2);
-        convertTo16bit(fData, baData);
-        fi.write(baData.constData(), dwTmp);
-
-        // Add 46 null sample points
-        charTmp = '\0';
-        for (int i = 0; i < 46 * 2; i++)
-            fi.write(&charTmp, 1);
-        dwTmp += 92;
+        dwTmp = sm->get(id2, champ_dwLength).dwValue;
+        if (rawSources.contains(i))
+        {
+            if (!copyRawData(rawSources[i].file, rawSources[i].start16, 2 * dwTmp, data))
+            {
+                qDeleteAll(sourceFiles);
+                success = false;
+                error = tr("Cannot read file \"%1\"").arg(rawSources[i].file->fileName());
+                return;
+            }
+            data.append(2 * 46, '\0');
+        }
+        else
+        {
+            fData = sm->getData(id2);
+            convertTo16bit(fData, dwTmp, data);
+        }
+        writeBlock(fi, data, false);
+        dwTmp = 2 * (dwTmp + 46);
 
         // Mise à jour des champs fileName, dwStart
         if (sm->get(id2, champ_dwStart16).dwValue != dwTmp2)
@@ -528,23 +521,37 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     if (sm->get(id, champ_wBpsSave).wValue == 24)
     {
         // Ajout données 24 bits
-        fi.write("sm24", 4);
+        data.append("sm24", 4);
         taille_sm24 -= 8;
-        fi.write((char *)&taille_sm24, 4);
+        data.append((char *)&taille_sm24, 4);
         dwTmp2 = 12 * 4 + taille_info + taille_smpl;
         foreach (int i, sm->getSiblings(id2))
         {
-            // copie de chaque sample
+            // Copy each sample, followed by 46 null sample points
             id2.indexElt = i;
             dwTmp = sm->get(id2, champ_dwLength).dwValue;
-            fData = sm->getData(id2);
-            convertTo24bit(fData, baData);
-            fi.write(baData.constData(), dwTmp);
-
-            // Add 46 null sample points
-            charTmp = '\0';
-            for (quint32 i = 0; i < 46; i++)
-                fi.write(&charTmp, 1);
+            if (rawSources.contains(i))
+            {
+                if (rawSources[i].is24bit)
+                {
+                    if (!copyRawData(rawSources[i].file, rawSources[i].start24, dwTmp, data))
+                    {
+                        qDeleteAll(sourceFiles);
+                        success = false;
+                        error = tr("Cannot read file \"%1\"").arg(rawSources[i].file->fileName());
+                        return;
+                    }
+                }
+                else
+                    data.append(dwTmp, '\0'); // The 8 extra bits of a 16-bit sample are null
+                data.append(46, '\0');
+            }
+            else
+            {
+                fData = sm->getData(id2);
+                convertTo24bit(fData, dwTmp, data);
+            }
+            writeBlock(fi, data, false);
             dwTmp += 46;
 
             // Mise à jour du champ dwStart24
@@ -558,11 +565,11 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
         // 0 de fin
         if (dwTmp2 % 2)
-        {
-            charTmp = '\0';
-            fi.write(&charTmp, sizeof(char));
-        }
+            data.append('\0');
     }
+    fData.clear();
+    writeBlock(fi, data, true);
+    qDeleteAll(sourceFiles);
 
     // Mise à jour wBpsFile
     if (sm->get(id, champ_wBpsSave).wValue == 24)
@@ -592,12 +599,16 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
     /////////////////////////////////////// BLOC PDTA ///////////////////////////////////////
 
+    // All sub-chunks are built in a single contiguous buffer, written at the end
+    data.clear();
+    data.reserve(taille_pdta + 8);
+
     int nBag, nMod, nGen;
-    fi.write("LIST", 4);
-    fi.write((char *)&taille_pdta, 4);
-    fi.write("pdta", 4);
-    fi.write("phdr", 4);
-    fi.write((char *)&taille_phdr, 4);
+    data.append("LIST", 4);
+    data.append((char *)&taille_pdta, 4);
+    data.append("pdta", 4);
+    data.append("phdr", 4);
+    data.append((char *)&taille_phdr, 4);
 
     // un bloc phdr par preset
     id.typeElement = elementPrst;
@@ -608,58 +619,45 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         id.indexElt = i;
         id2.indexElt = i;
         // Name
-        dwTmp = sm->getQstr(id, champ_name).length();
-        if (dwTmp > 20) dwTmp = 20;
-        if (dwTmp != 0)
-        {
-            fi.write(sm->getQstr(id, champ_name).toLatin1());
-            charTmp = '\0';
-            for (quint32 i = 0; i < 20-dwTmp; i++)
-                fi.write(&charTmp, 1);
-        }
-        else
+        if (sm->getQstr(id, champ_name).isEmpty())
         {
             dwTmp = sprintf(tcharTmp, "preset %d", i+1);
-            fi.write(tcharTmp, dwTmp);
-            charTmp = '\0';
-            for (quint32 i = 0; i < 20-dwTmp; i++)
-                fi.write(&charTmp, 1);
+            appendText(data, QByteArray(tcharTmp, dwTmp), 20);
         }
+        else
+            appendText(data, sm->getQstr(id, champ_name).toLatin1(), 20);
+
         // wPreset
         wTmp = sm->get(id, champ_wPreset).wValue;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         // wBank
         wTmp = sm->get(id, champ_wBank).wValue;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         // wPresetBagNdx
         wTmp = nBag;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         nBag++; // bag global
         nBag += sm->getSiblings(id2).count();
 
         // dwLibrary
         dwTmp = sm->get(id, champ_dwLibrary).dwValue;
-        fi.write((char *)&wTmp, 4);
+        data.append((char *)&dwTmp, 4);
         // dwGenre
         dwTmp = sm->get(id, champ_dwGenre).dwValue;
-        fi.write((char *)&wTmp, 4);
+        data.append((char *)&dwTmp, 4);
         // dwMorphology
         dwTmp = sm->get(id, champ_dwMorphology).dwValue;
-        fi.write((char *)&wTmp, 4);
+        data.append((char *)&dwTmp, 4);
     }
     // phdr de fin (38 byte)
-    fi.write("EOP", 3);
-    charTmp = '\0';
-    for (quint32 i = 0; i < 21; i++)
-        fi.write(&charTmp, 1);
+    appendText(data, "EOP", 24);
     // index bag de fin
     wTmp = nBag;
-    fi.write((char *)&wTmp, 2);
-    for (quint32 i = 0; i < 12; i++)
-        fi.write(&charTmp, 1);
+    data.append((char *)&wTmp, 2);
+    data.append(12, '\0');
 
-    fi.write("pbag", 4);
-    fi.write((char*)&taille_pbag, 4);
+    data.append("pbag", 4);
+    data.append((char*)&taille_pbag, 4);
     id.typeElement = elementPrst;
     id2.typeElement = elementPrstInst;
     nGen = 0;
@@ -674,11 +672,11 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
         // bag global
         wTmp = nGen;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         id2.typeElement = elementPrstGen;
         nGen += sm->getSiblings(id2).count();
         wTmp = nMod;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         id2.typeElement = elementPrstMod;
         nMod += sm->getSiblings(id2).count();
 
@@ -688,12 +686,12 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         {
             id2.indexElt2 = j;
             wTmp = nGen;
-            fi.write((char *)&wTmp, 2);
+            data.append((char *)&wTmp, 2);
             id3.typeElement = elementPrstInstGen;
             id3.indexElt2 = j;
             nGen += sm->getSiblings(id3).count();
             wTmp = nMod;
-            fi.write((char *)&wTmp, 2);
+            data.append((char *)&wTmp, 2);
             id3.typeElement = elementPrstInstMod;
             nMod += sm->getSiblings(id3).count();
         }
@@ -701,15 +699,14 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
     // bag de fin
     wTmp = nGen;
-    fi.write((char *)&wTmp, 2);
+    data.append((char *)&wTmp, 2);
     wTmp = nMod;
-    fi.write((char *)&wTmp, 2);
+    data.append((char *)&wTmp, 2);
 
-    fi.write("pmod", 4);
-    fi.write((char *)&taille_pmod, 4);
+    data.append("pmod", 4);
+    data.append((char *)&taille_pmod, 4);
     id.typeElement = elementPrst;
     id2.typeElement = elementPrstInst;
-    SFModulator sfTmp;
 
     // pour chaque preset
     foreach (int i, sm->getSiblings(id))
@@ -720,72 +717,24 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
         // mods du bag global
         id3.typeElement = elementPrstMod;
-        Sf2IndexConverter converterMod(id3);
-        foreach (int k, sm->getSiblings(id3))
-        {
-            id3.indexMod = k;
-
-            // écriture
-            sfTmp = sm->get(id3, champ_sfModSrcOper).sfModValue;
-            byTmp = sfTmp.Index + sfTmp.CC * 128;
-            fi.write((char *)&byTmp, 1);
-            byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-            fi.write((char *)&byTmp, 1);
-            wTmp = converterMod.getIndexOf(sm->get(id3, champ_sfModDestOper).wValue, true);
-            fi.write((char *)&wTmp, 2);
-            wTmp = sm->get(id3, champ_modAmount).wValue;
-            fi.write((char *)&wTmp, 2);
-            sfTmp = sm->get(id3, champ_sfModAmtSrcOper).sfModValue;
-            byTmp = sfTmp.Index + sfTmp.CC * 128;
-            fi.write((char *)&byTmp, 1);
-            byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-            fi.write((char *)&byTmp, 1);
-            wTmp = sm->get(id3, champ_sfModTransOper).wValue == 2 ? absolute_value : linear;
-            fi.write((char *)&wTmp, 2);
-        }
+        appendMods(data, sm, id3);
 
         // pour chaque instrument associé
         foreach (int j, sm->getSiblings(id2))
         {
+            // mods associés aux instruments
             id2.indexElt2 = j;
             id3.indexElt2 = j;
             id3.typeElement = elementPrstInstMod;
-            Sf2IndexConverter converterMod2(id3);
-
-            // mods associés aux instruments
-            foreach (int k, sm->getSiblings(id3))
-            {
-                id3.indexMod = k;
-
-                // écriture
-                sfTmp = sm->get(id3, champ_sfModSrcOper).sfModValue;
-                byTmp = sfTmp.Index + sfTmp.CC * 128;
-                fi.write((char *)&byTmp, 1);
-                byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-                fi.write((char *)&byTmp, 1);
-                wTmp = converterMod2.getIndexOf(sm->get(id3, champ_sfModDestOper).wValue, true);
-                fi.write((char *)&wTmp, 2);
-                wTmp = sm->get(id3, champ_modAmount).wValue;
-                fi.write((char *)&wTmp, 2);
-                sfTmp = sm->get(id3, champ_sfModAmtSrcOper).sfModValue;
-                byTmp = sfTmp.Index + sfTmp.CC * 128;
-                fi.write((char *)&byTmp, 1);
-                byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-                fi.write((char *)&byTmp, 1);
-                wTmp = sm->get(id3, champ_sfModTransOper).wValue == 2 ? absolute_value : linear;
-                fi.write((char *)&wTmp, 2);
-            }
+            appendMods(data, sm, id3);
         }
     }
 
     // mod de fin
-    charTmp = '\0';
-    for (quint32 i = 0; i < 10; i++)
-        fi.write(&charTmp, 1);
+    data.append(10, '\0');
 
-    AttributeValue genTmp;
-    fi.write("pgen", 4);
-    fi.write((char *)&taille_pgen, 4);
+    data.append("pgen", 4);
+    data.append((char *)&taille_pgen, 4);
     id.typeElement = elementPrst;
     id2.typeElement = elementPrstInst;
     Sf2IndexConverter converterInst(EltID(elementInst, id.indexSf2));
@@ -796,101 +745,32 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         id.indexElt = i;
         id2.indexElt = i;
         id3.indexElt = i;
-        id3.typeElement = elementPrstGen;
 
         // gens du bag global
-        // - 1er gen : keyrange si présent
-        // - 2ème gen : velocity si présent
-        if (sm->isSet(id, champ_keyRange))
-        {
-            wTmp = champ_keyRange;
-            fi.write((char *)&wTmp, 2);
-            genTmp = sm->get(id, champ_keyRange);
-            if (genTmp.rValue.byLo > 127)
-                genTmp.rValue.byLo = 127;
-            if (genTmp.rValue.byHi > 127)
-                genTmp.rValue.byHi = 127;
-            fi.write((char *)&genTmp, 2);
-        }
-        if (sm->isSet(id, champ_velRange))
-        {
-            wTmp = champ_velRange;
-            fi.write((char *)&wTmp, 2);
-            genTmp = sm->get(id, champ_velRange);
-            if (genTmp.rValue.byLo > 127)
-                genTmp.rValue.byLo = 127;
-            if (genTmp.rValue.byHi > 127)
-                genTmp.rValue.byHi = 127;
-            fi.write((char *)&genTmp, 2);
-        }
-        foreach (int k, sm->getSiblings(id3))
-        {
-            if (k != champ_keyRange && k != champ_velRange && k != champ_instrument)
-            {
-                wTmp = k;
-                fi.write((char *)&wTmp, 2);
-                genTmp = sm->get(id, (AttributeType)k);
-                fi.write((char *)&genTmp, 2);
-            }
-        }
-        id3.typeElement = elementPrstInstGen;
+        id3.typeElement = elementPrstGen;
+        appendGens(data, sm, id, id3, champ_instrument);
 
         // pour chaque instrument associé
+        id3.typeElement = elementPrstInstGen;
         foreach (int j, sm->getSiblings(id2))
         {
             id2.indexElt2 = j;
             id3.indexElt2 = j;
 
-            // gens associés aux instruments
-            // - 1er gen : keyrange si présent
-            // - 2ème gen : velocity si présent
-            // - dernier gen : sample_ID
-            if (sm->isSet(id2, champ_keyRange))
-            {
-                wTmp = champ_keyRange;
-                fi.write((char *)&wTmp, 2);
-                genTmp = sm->get(id2, champ_keyRange);
-                if (genTmp.rValue.byLo > 127)
-                    genTmp.rValue.byLo = 127;
-                if (genTmp.rValue.byHi > 127)
-                    genTmp.rValue.byHi = 127;
-                fi.write((char *)&genTmp, 2);
-            }
-            if (sm->isSet(id2, champ_velRange))
-            {
-                wTmp = champ_velRange;
-                fi.write((char *)&wTmp, 2);
-                genTmp = sm->get(id2, champ_velRange);
-                if (genTmp.rValue.byLo > 127)
-                    genTmp.rValue.byLo = 127;
-                if (genTmp.rValue.byHi > 127)
-                    genTmp.rValue.byHi = 127;
-                fi.write((char *)&genTmp, 2);
-            }
-            foreach (int k, sm->getSiblings(id3))
-            {
-                if (k != champ_keyRange && k != champ_velRange && k != champ_instrument)
-                {
-                    wTmp = k;
-                    fi.write((char *)&wTmp, 2);
-                    genTmp = sm->get(id2, (AttributeType)k);
-                    fi.write((char *)&genTmp, 2);
-                }
-            }
+            // gens associés aux instruments, le dernier étant l'index de l'instrument
+            appendGens(data, sm, id2, id3, champ_instrument);
             wTmp = champ_instrument;
-            fi.write((char *)&wTmp, 2);
-            genTmp.wValue = converterInst.getIndexOf(sm->get(id2, champ_instrument).wValue, false);
-            fi.write((char *)&genTmp, 2);
+            data.append((char *)&wTmp, 2);
+            wTmp = converterInst.getIndexOf(sm->get(id2, champ_instrument).wValue, false);
+            data.append((char *)&wTmp, 2);
         }
     }
 
     // gen de fin
-    charTmp = '\0';
-    for (quint32 i = 0; i < 4; i++)
-        fi.write(&charTmp, 1);
+    data.append(4, '\0');
 
-    fi.write("inst", 4);
-    fi.write((char *)&taille_inst, 4);
+    data.append("inst", 4);
+    data.append((char *)&taille_inst, 4);
 
     // un bloc inst par instrument
     id.typeElement = elementInst;
@@ -902,43 +782,30 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         id2.indexElt = i;
 
         // Name
-        dwTmp = sm->getQstr(id, champ_name).length();
-        if (dwTmp > 20) dwTmp = 20;
-        if (dwTmp != 0)
-        {
-            fi.write(sm->getQstr(id, champ_name).toLatin1());
-            charTmp = '\0';
-            for (quint32 iteration = 0; iteration < 20-dwTmp; iteration++)
-                fi.write(&charTmp, 1);
-        }
-        else
+        if (sm->getQstr(id, champ_name).isEmpty())
         {
             dwTmp = sprintf(tcharTmp, "instrument %d", i+1);
-            fi.write(tcharTmp, dwTmp);
-            charTmp = '\0';
-            for (quint32 iteration = 0; iteration < 20-dwTmp; iteration++)
-                fi.write(&charTmp, 1);
+            appendText(data, QByteArray(tcharTmp, dwTmp), 20);
         }
+        else
+            appendText(data, sm->getQstr(id, champ_name).toLatin1(), 20);
 
         // wInstBagNdx
         wTmp = nBag;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         nBag++; // bag global
         nBag += sm->getSiblings(id2).count(); // un bag par sample lié
     }
 
     // inst de fin
-    fi.write("EOI", 3);
-    charTmp = '\0';
-    for (quint32 iteration = 0; iteration < 17; iteration++)
-        fi.write(&charTmp, 1);
+    appendText(data, "EOI", 20);
 
     // index bag de fin
     wTmp = nBag;
-    fi.write((char *)&wTmp, 2);
+    data.append((char *)&wTmp, 2);
 
-    fi.write("ibag", 4);
-    fi.write((char *)&taille_ibag, 4);
+    data.append("ibag", 4);
+    data.append((char *)&taille_ibag, 4);
     id.typeElement = elementInst;
     id2.typeElement = elementInstSmpl;
     nGen = 0;
@@ -953,11 +820,11 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
         // bag global
         wTmp = nGen;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         id2.typeElement = elementInstGen;
         nGen += sm->getSiblings(id2).count();
         wTmp = nMod;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         id2.typeElement = elementInstMod;
         nMod += sm->getSiblings(id2).count();
 
@@ -967,12 +834,12 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         {
             id2.indexElt2 = j;
             wTmp = nGen;
-            fi.write((char *)&wTmp, 2);
+            data.append((char *)&wTmp, 2);
             id3.typeElement = elementInstSmplGen;
             id3.indexElt2 = j;
             nGen += sm->getSiblings(id3).count();
             wTmp = nMod;
-            fi.write((char *)&wTmp, 2);
+            data.append((char *)&wTmp, 2);
             id3.typeElement = elementInstSmplMod;
             nMod += sm->getSiblings(id3).count();
         }
@@ -980,12 +847,12 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
     // bag de fin
     wTmp = nGen;
-    fi.write((char *)&wTmp, 2);
+    data.append((char *)&wTmp, 2);
     wTmp = nMod;
-    fi.write((char *)&wTmp, 2);
+    data.append((char *)&wTmp, 2);
 
-    fi.write("imod", 4);
-    fi.write((char *)&taille_imod, 4);
+    data.append("imod", 4);
+    data.append((char *)&taille_imod, 4);
     id.typeElement = elementInst;
     id2.typeElement = elementInstSmpl;
 
@@ -998,71 +865,24 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
 
         // mods du bag global
         id3.typeElement = elementInstMod;
-        Sf2IndexConverter converterMod(id3);
-        foreach (int k, sm->getSiblings(id3))
-        {
-            id3.indexMod = k;
-
-            // écriture
-            sfTmp = sm->get(id3, champ_sfModSrcOper).sfModValue;
-            byTmp = sfTmp.Index + sfTmp.CC * 128;
-            fi.write((char *)&byTmp, 1);
-            byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-            fi.write((char *)&byTmp, 1);
-            wTmp = converterMod.getIndexOf(sm->get(id3, champ_sfModDestOper).wValue, true);
-            fi.write((char *)&wTmp, 2);
-            wTmp = sm->get(id3, champ_modAmount).wValue;
-            fi.write((char *)&wTmp, 2);
-            sfTmp = sm->get(id3, champ_sfModAmtSrcOper).sfModValue;
-            byTmp = sfTmp.Index + sfTmp.CC * 128;
-            fi.write((char *)&byTmp, 1);
-            byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-            fi.write((char *)&byTmp, 1);
-            wTmp = sm->get(id3, champ_sfModTransOper).wValue == 2 ? absolute_value : linear;
-            fi.write((char *)&wTmp, 2);
-        }
+        appendMods(data, sm, id3);
 
         // pour chaque sample associé
         foreach (int j, sm->getSiblings(id2))
         {
+            // mods associés aux samples
             id2.indexElt2 = j;
             id3.indexElt2 = j;
             id3.typeElement = elementInstSmplMod;
-            Sf2IndexConverter converterMod2(id3);
-
-            // mods associés aux samples
-            foreach (int k, sm->getSiblings(id3))
-            {
-                id3.indexMod = k;
-
-                // écriture
-                sfTmp = sm->get(id3, champ_sfModSrcOper).sfModValue;
-                byTmp = sfTmp.Index + sfTmp.CC * 128;
-                fi.write((char *)&byTmp, 1);
-                byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-                fi.write((char *)&byTmp, 1);
-                wTmp = converterMod2.getIndexOf(sm->get(id3, champ_sfModDestOper).wValue, true);
-                fi.write((char *)&wTmp, 2);
-                wTmp = sm->get(id3, champ_modAmount).wValue;
-                fi.write((char *)&wTmp, 2);
-                sfTmp = sm->get(id3, champ_sfModAmtSrcOper).sfModValue;
-                byTmp = sfTmp.Index + sfTmp.CC * 128;
-                fi.write((char *)&byTmp, 1);
-                byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
-                fi.write((char *)&byTmp, 1);
-                wTmp = sm->get(id3, champ_sfModTransOper).wValue == 2 ? absolute_value : linear;
-                fi.write((char *)&wTmp, 2);
-            }
+            appendMods(data, sm, id3);
         }
     }
 
     // mod de fin
-    charTmp = '\0';
-    for (quint32 iteration = 0; iteration < 10; iteration++)
-        fi.write(&charTmp, 1);
+    data.append(10, '\0');
 
-    fi.write("igen", 4);
-    fi.write((char *)&taille_igen, 4);
+    data.append("igen", 4);
+    data.append((char *)&taille_igen, 4);
     id.typeElement = elementInst;
     id2.typeElement = elementInstSmpl;
     Sf2IndexConverter converterSmpl(EltID(elementSmpl, id.indexSf2));
@@ -1073,164 +893,83 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
         id.indexElt = i;
         id2.indexElt = i;
         id3.indexElt = i;
-        id3.typeElement = elementInstGen;
 
         // gens du bag global
-        // - 1er gen : keyrange si présent
-        // - 2ème gen : velocity si présent
-        if (sm->isSet(id, champ_keyRange))
-        {
-            wTmp = champ_keyRange;
-            fi.write((char *)&wTmp, 2);
-            genTmp = sm->get(id, champ_keyRange);
-            if (genTmp.rValue.byLo > 127)
-                genTmp.rValue.byLo = 127;
-            if (genTmp.rValue.byHi > 127)
-                genTmp.rValue.byHi = 127;
-            fi.write((char *)&genTmp, 2);
-        }
-        if (sm->isSet(id, champ_velRange))
-        {
-            wTmp = champ_velRange;
-            fi.write((char *)&wTmp, 2);
-            genTmp = sm->get(id, champ_velRange);
-            if (genTmp.rValue.byLo > 127)
-                genTmp.rValue.byLo = 127;
-            if (genTmp.rValue.byHi > 127)
-                genTmp.rValue.byHi = 127;
-            fi.write((char *)&genTmp, 2);
-        }
-        foreach (int k, sm->getSiblings(id3))
-        {
-            if (k != champ_keyRange && k != champ_velRange && k != champ_sampleID)
-            {
-                wTmp = k;
-                fi.write((char *)&wTmp, 2);
-                genTmp = sm->get(id, (AttributeType)k);
-                fi.write((char *)&genTmp, 2);
-            }
-        }
-        id3.typeElement = elementInstSmplGen;
+        id3.typeElement = elementInstGen;
+        appendGens(data, sm, id, id3, champ_sampleID);
 
         // pour chaque sample associé
+        id3.typeElement = elementInstSmplGen;
         foreach (int j, sm->getSiblings(id2))
         {
             id2.indexElt2 = j;
             id3.indexElt2 = j;
 
-            // gens associés aux samples
-            // - 1er gen : keyrange si présent
-            // - 2ème gen : velocity si présent
-            // - dernier gen : sample_ID
-            if (sm->isSet(id2, champ_keyRange))
-            {
-                wTmp = champ_keyRange;
-                fi.write((char *)&wTmp, 2);
-                genTmp = sm->get(id2, champ_keyRange);
-                if (genTmp.rValue.byLo > 127)
-                    genTmp.rValue.byLo = 127;
-                if (genTmp.rValue.byHi > 127)
-                    genTmp.rValue.byHi = 127;
-                fi.write((char *)&genTmp, 2);
-            }
-            if (sm->isSet(id2, champ_velRange))
-            {
-                wTmp = champ_velRange;
-                fi.write((char *)&wTmp, 2);
-                genTmp = sm->get(id2, champ_velRange);
-                if (genTmp.rValue.byLo > 127)
-                    genTmp.rValue.byLo = 127;
-                if (genTmp.rValue.byHi > 127)
-                    genTmp.rValue.byHi = 127;
-                fi.write((char *)&genTmp, 2);
-            }
-            foreach (int k, sm->getSiblings(id3))
-            {
-                if (k != champ_keyRange && k != champ_velRange && k != champ_sampleID)
-                {
-                    wTmp = k;
-                    fi.write((char *)&wTmp, 2);
-                    genTmp = sm->get(id2, (AttributeType)k);
-                    fi.write((char *)&genTmp, 2);
-                }
-            }
+            // gens associés aux samples, le dernier étant l'index du sample
+            appendGens(data, sm, id2, id3, champ_sampleID);
             wTmp = champ_sampleID;
-            fi.write((char *)&wTmp, 2);
-            genTmp.wValue = converterSmpl.getIndexOf(sm->get(id2, champ_sampleID).wValue, false);
-            fi.write((char *)&genTmp, 2);
+            data.append((char *)&wTmp, 2);
+            wTmp = converterSmpl.getIndexOf(sm->get(id2, champ_sampleID).wValue, false);
+            data.append((char *)&wTmp, 2);
         }
     }
 
     // gen de fin
-    charTmp = '\0';
-    for (quint32 iteration = 0; iteration < 4; iteration++)
-        fi.write(&charTmp, 1);
+    data.append(4, '\0');
 
-    fi.write("shdr", 4);
-    fi.write((char *)&taille_shdr, 4);
+    data.append("shdr", 4);
+    data.append((char *)&taille_shdr, 4);
 
     // un bloc shdr par sample
     id.typeElement = elementSmpl;
-    nBag = 0;
     dwTmp2 = 0;
     foreach (int i, sm->getSiblings(id))
     {
         id.indexElt = i;
 
         // Name
-        dwTmp = sm->getQstr(id, champ_name).length();
-        if (dwTmp > 20) dwTmp = 20;
-        if (dwTmp != 0)
-        {
-            fi.write(sm->getQstr(id, champ_name).toLatin1());
-            charTmp = '\0';
-            for (quint32 iteration = 0; iteration < 20 - dwTmp; iteration++)
-                fi.write(&charTmp, 1);
-        }
-        else
+        if (sm->getQstr(id, champ_name).isEmpty())
         {
             dwTmp = sprintf(tcharTmp, "sample %d", i+1);
-            fi.write(tcharTmp, dwTmp);
-            charTmp = '\0';
-            for (quint32 iteration = 0; iteration < 20 - dwTmp; iteration++)
-                fi.write(&charTmp, 1);
+            appendText(data, QByteArray(tcharTmp, dwTmp), 20);
         }
+        else
+            appendText(data, sm->getQstr(id, champ_name).toLatin1(), 20);
+
         // dwStart, dwEnd, dwStartLoop, dwEndLoop
-        fi.write((char *)&dwTmp2, 4);
+        data.append((char *)&dwTmp2, 4);
         dwTmp = dwTmp2 + sm->get(id, champ_dwLength).dwValue;
-        fi.write((char *)&dwTmp, 4);
+        data.append((char *)&dwTmp, 4);
         dwTmp = dwTmp2 + sm->get(id, champ_dwStartLoop).dwValue;
-        fi.write((char *)&dwTmp, 4);
+        data.append((char *)&dwTmp, 4);
         dwTmp = dwTmp2 + sm->get(id, champ_dwEndLoop).dwValue;
-        fi.write((char *)&dwTmp, 4);
+        data.append((char *)&dwTmp, 4);
 
         // on avance
         dwTmp2 += sm->get(id, champ_dwLength).dwValue + 46; // 46 zeros
 
         // dwSampleRate
         dwTmp = sm->get(id, champ_dwSampleRate).dwValue;
-        fi.write((char *)&dwTmp, 4);
+        data.append((char *)&dwTmp, 4);
         // byOriginalPitch
         byTmp = sm->get(id, champ_byOriginalPitch).bValue;
-        fi.write((char *)&byTmp, 1);
+        data.append((char *)&byTmp, 1);
         // chPitchCorrection
         charTmp = sm->get(id, champ_chPitchCorrection).cValue;
-        fi.write((char *)&charTmp, sizeof(char));
+        data.append(charTmp);
         // wSampleLink
         wTmp = converterSmpl.getIndexOf(sm->get(id, champ_wSampleLink).wValue, false);
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
         // sfSampleType
         wTmp = sm->get(id, champ_sfSampleType).sfLinkValue;
-        fi.write((char *)&wTmp, 2);
+        data.append((char *)&wTmp, 2);
     }
 
     // shdr de fin
-    fi.write("EOS", 3);
-    charTmp = '\0';
-    for (quint32 iteration = 0; iteration < 43; iteration++)
-        fi.write(&charTmp, 1);
+    appendText(data, "EOS", 46);
 
-    // Fermeture du fichier
+    // Ecriture du bloc pdta et fermeture du fichier
+    writeBlock(fi, data, true);
     fi.close();
 
     // Sauvegarde de fileName, wBpsInit
@@ -1243,26 +982,178 @@ void OutputSf2::save(QString fileName, SoundfontManager * sm, bool &success, QSt
     error = "";
 }
 
-void OutputSf2::convertTo16bit(QVector<float> dataSrc, QByteArray &dataDest)
+void OutputSf2::appendText(QByteArray &data, const QByteArray &text, int length)
 {
-    const float * data = dataSrc.constData();
-    int length = dataSrc.size();
+    // Text truncated or completed with '\0' so that exactly "length" bytes are written
+    int textLength = qMin(text.length(), length);
+    data.append(text.constData(), textLength);
+    data.append(length - textLength, '\0');
+}
+
+void OutputSf2::appendMods(QByteArray &data, SoundfontManager * sm, EltID idMod)
+{
+    quint8 byTmp;
+    quint16 wTmp;
+    SFModulator sfTmp;
+    Sf2IndexConverter converterMod(idMod);
+    foreach (int k, sm->getSiblings(idMod))
+    {
+        idMod.indexMod = k;
+
+        // One record of 10 bytes per modulator
+        sfTmp = sm->get(idMod, champ_sfModSrcOper).sfModValue;
+        byTmp = sfTmp.Index + sfTmp.CC * 128;
+        data.append((char *)&byTmp, 1);
+        byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
+        data.append((char *)&byTmp, 1);
+        wTmp = converterMod.getIndexOf(sm->get(idMod, champ_sfModDestOper).wValue, true);
+        data.append((char *)&wTmp, 2);
+        wTmp = sm->get(idMod, champ_modAmount).wValue;
+        data.append((char *)&wTmp, 2);
+        sfTmp = sm->get(idMod, champ_sfModAmtSrcOper).sfModValue;
+        byTmp = sfTmp.Index + sfTmp.CC * 128;
+        data.append((char *)&byTmp, 1);
+        byTmp = sfTmp.isDescending + 2 * sfTmp.isBipolar + 4 * sfTmp.Type;
+        data.append((char *)&byTmp, 1);
+        wTmp = sm->get(idMod, champ_sfModTransOper).wValue == 2 ? absolute_value : linear;
+        data.append((char *)&wTmp, 2);
+    }
+}
 
-    dataDest.resize(2 * length);
-    qint16 * data16 = reinterpret_cast<qint16 *>(dataDest.data());
+void OutputSf2::appendGens(QByteArray &data, SoundfontManager * sm, EltID id, EltID idGen, AttributeType indexAttribute)
+{
+    // Order of the generators:
+    // - 1er gen : keyrange si présent
+    // - 2ème gen : velocity si présent
+    // - the index of the instrument or sample is written afterwards for a division
+    quint16 wTmp;
+    AttributeValue genTmp;
+    if (sm->isSet(id, champ_keyRange))
+    {
+        wTmp = champ_keyRange;
+        data.append((char *)&wTmp, 2);
+        genTmp = sm->get(id, champ_keyRange);
+        if (genTmp.rValue.byLo > 127)
+            genTmp.rValue.byLo = 127;
+        if (genTmp.rValue.byHi > 127)
+            genTmp.rValue.byHi = 127;
+        data.append((char *)&genTmp, 2);
+    }
+    if (sm->isSet(id, champ_velRange))
+    {
+        wTmp = champ_velRange;
+        data.append((char *)&wTmp, 2);
+        genTmp = sm->get(id, champ_velRange);
+        if (genTmp.rValue.byLo > 127)
+            genTmp.rValue.byLo = 127;
+        if (genTmp.rValue.byHi > 127)
+            genTmp.rValue.byHi = 127;
+        data.append((char *)&genTmp, 2);
+    }
+    foreach (int k, sm->getSiblings(idGen))
+    {
+        if (k != champ_keyRange && k != champ_velRange && k != indexAttribute)
+        {
+            wTmp = k;
+            data.append((char *)&wTmp, 2);
+            genTmp = sm->get(id, (AttributeType)k);
+            data.append((char *)&genTmp, 2);
+        }
+    }
+}
 
-    for (int i = 0; i < length; i++)
-        data16[i] = (Utils::floatToInt24(data[i]) >> 8);
+QMap<int, OutputSf2::RawSampleSource> OutputSf2::getRawSources(SoundfontManager * sm, EltID idSmpl, QString fileName,
+                                                                QMap<QString, QFile *> &openedFiles)
+{
+    QMap<int, RawSampleSource> rawSources;
+    foreach (int i, sm->getSiblings(idSmpl))
+    {
+        idSmpl.indexElt = i;
+
+        // The data must be exactly the content of a sf2 file, different from the file being written
+        QSharedPointer<Sound> sound = sm->getSound(idSmpl);
+        if (sound.isNull() || sound->isDataModified())
+            continue;
+        QString sourceFileName = sound->getFileName();
+        if (sourceFileName == fileName || QFileInfo(sourceFileName).suffix().toLower() != "sf2")
+            continue;
+
+        RawSampleSource rawSource;
+        rawSource.start16 = sound->getUInt32(champ_dwStart16);
+        rawSource.start24 = sound->getUInt32(champ_dwStart24);
+        rawSource.is24bit = (sound->getUInt32(champ_bpsFile) >= 24);
+
+        // Open the source file once
+        if (!openedFiles.contains(sourceFileName))
+        {
+            QFile * file = new QFile(sourceFileName);
+            if (!file->open(QIODevice::ReadOnly))
+            {
+                // The sample will be decoded again
+                delete file;
+                continue;
+            }
+            openedFiles[sourceFileName] = file;
+        }
+        rawSource.file = openedFiles[sourceFileName];
+
+        // Check that the file is big enough, otherwise the sample is decoded as before
+        quint32 length = sound->getUInt32(champ_dwLength);
+        qint64 fileSize = rawSource.file->size();
+        if ((qint64)rawSource.start16 + 2 * (qint64)length > fileSize ||
+                (rawSource.is24bit && (qint64)rawSource.start24 + length > fileSize))
+            continue;
+
+        rawSources[i] = rawSource;
+    }
+
+    return rawSources;
+}
+
+bool OutputSf2::copyRawData(QFile * source, quint32 position, quint32 size, QByteArray &dataDest)
+{
+    // Read the raw data at the end of dataDest
+    int offset = dataDest.size();
+    dataDest.resize(offset + size);
+    if (size == 0)
+        return true;
+    return source->seek(position) && source->read(dataDest.data() + offset, size) == size;
+}
+
+void OutputSf2::writeBlock(QFile &fi, QByteArray &data, bool force)
+{
+    // Data is written only when the block is full, unless forced
+    if (data.isEmpty() || (!force && data.size() < SAMPLE_BLOCK_SIZE))
+        return;
+    fi.write(data);
+    data.resize(0);
+}
+
+void OutputSf2::convertTo16bit(const QVector<float> &dataSrc, quint32 length, QByteArray &dataDest)
+{
+    // "length" points are written (completed by 0 if the source is shorter), followed by 46 null points
+    const float * data = dataSrc.constData();
+    quint32 count = qMin(length, static_cast<quint32>(dataSrc.size()));
+    int offset = dataDest.size();
+    dataDest.resize(offset + 2 * (length + 46));
+    qint16 * data16 = reinterpret_cast<qint16 *>(dataDest.data() + offset);
+
+    for (quint32 i = 0; i < count; i++)
+        data16[i] = static_cast<qint16>(Utils::floatToInt24Vectorizable(data[i]) >> 8);
+    memset(data16 + count, 0, 2 * (length + 46 - count));
 }
 
-void OutputSf2::convertTo24bit(QVector<float> dataSrc, QByteArray &dataDest)
+void OutputSf2::convertTo24bit(const QVector<float> &dataSrc, quint32 length, QByteArray &dataDest)
 {
+    // "length" points are written (completed by 0 if the source is shorter), followed by 46 null points
     const float * data = dataSrc.constData();
-    int length = dataSrc.size();
+    quint32 count = qMin(length, static_cast<quint32>(dataSrc.size()));
+    int offset = dataDest.size();
+    dataDest.resize(offset + length + 46);
+    char * dataChar = dataDest.data() + offset;
 
     // Get only the last 8 bits of the 24 bits value
-    dataDest.resize(length);
-    char * dataChar = dataDest.data();
-    for (int i = 0; i < length; i++)
-        dataChar[i] = (Utils::floatToInt24(data[i]) & 0xFF);
+    for (quint32 i = 0; i < count; i++)
+        dataChar[i] = static_cast<char>(Utils::floatToInt24Vectorizable(data[i]) & 0xFF);
+    memset(dataChar + count, 0, length + 46 - count);
 }
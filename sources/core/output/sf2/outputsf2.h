@@ -26,7 +26,10 @@
 #define OUTPUTSF2_H
 
 #include "abstractoutput.h"
+#include "eltid.h"
+#include "attribute.h"
 class SoundfontManager;
+class QFile;
 
 class OutputSf2 : public AbstractOutput
 {
@@ -39,9 +42,33 @@ protected slots:
     void processInternal(QString fileName, SoundfontManager * sm, bool &success, QString &error, int sf2Index, QMap<QString, QVariant> & options) override;
 
 private:
+    // Location of sample data that can be copied as is from an existing sf2 file
+    struct RawSampleSource
+    {
+        QFile * file;
+        quint32 start16;
+        quint32 start24;
+        bool is24bit;
+    };
+
     void save(QString fileName, SoundfontManager * sm, bool &success, QString &error, int sf2Index);
-    static void convertTo16bit(QVector<float> dataSrc, QByteArray &dataDest);
-    static void convertTo24bit(QVector<float> dataSrc, QByteArray &dataDest);
+
+    // Chunks are built in memory and written with a single call
+    static void appendText(QByteArray &data, const QByteArray &text, int length);
+    static void appendMods(QByteArray &data, SoundfontManager * sm, EltID idMod);
+    static void appendGens(QByteArray &data, SoundfontManager * sm, EltID id, EltID idGen, AttributeType indexAttribute);
+    static void writeBlock(QFile &fi, QByteArray &data, bool force);
+
+    // Reuse of the sample data already stored in a sf2 file
+    static QMap<int, RawSampleSource> getRawSources(SoundfontManager * sm, EltID idSmpl, QString fileName,
+                                                    QMap<QString, QFile *> &openedFiles);
+    static bool copyRawData(QFile * source, quint32 position, quint32 size, QByteArray &dataDest);
+
+    // Sample data is appended to dataDest, followed by 46 null points
+    static void convertTo16bit(const QVector<float> &dataSrc, quint32 length, QByteArray &dataDest);
+    static void convertTo24bit(const QVector<float> &dataSrc, quint32 length, QByteArray &dataDest);
+
+    static const int SAMPLE_BLOCK_SIZE;
 };
 
 #endif // OUTPUTSF2_H
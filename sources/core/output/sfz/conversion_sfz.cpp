@@ -30,12 +30,57 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QDate>
-#include "contextmanager.h"
+#include "keynamemanager.h"
 #include "attribute.h"
 #include "sfzparamlist.h"
 #include "balanceparameters.h"
 #include "sfzwriter.h"
+#include <QRunnable>
 
+class RunnableWavWriter: public QRunnable
+{
+public:
+    RunnableWavWriter(QString filePath, QSharedPointer<Sound> sound, QSharedPointer<Sound> rightSound = QSharedPointer<Sound>()) : QRunnable(),
+        _filePath(filePath),
+        _sound(sound),
+        _rightSound(rightSound)
+    {}
+
+    void run() override
+    {
+        SampleWriterWav writer(_filePath);
+        if (_rightSound.isNull())
+            writer.write(_sound.data());
+        else
+            writer.write(_sound.data(), _rightSound.data());
+    }
+
+private:
+    QString _filePath;
+    QSharedPointer<Sound> _sound; // Kept alive until the file is written
+    QSharedPointer<Sound> _rightSound;
+};
+
+class RunnableSfzWriter: public QRunnable
+{
+public:
+    RunnableSfzWriter(SfzWriter * sfzWriter) : QRunnable(),
+        _sfzWriter(sfzWriter)
+    {}
+
+    ~RunnableSfzWriter() override
+    {
+        delete _sfzWriter;
+    }
+
+    void run() override
+    {
+        _sfzWriter->write();
+    }
+
+private:
+    SfzWriter * _sfzWriter;
+};
 
 ConversionSfz::ConversionSfz() : QObject(),
     _sf2(SoundfontManager::getInstance()),
@@ -115,6 +160,9 @@ QString ConversionSfz::convert(QString dirPath, EltID idSf2, bool presetPrefix,
         exportPrst(sourceDir, presetId, presetPrefix);
     }
 
+    // Wait for all files to be written
+    _writerPool.waitForDone();
+
     return "";
 }
 
@@ -227,10 +275,8 @@ void ConversionSfz::exportPrst(QString dir, EltID id, bool presetPrefix)
         delete paramPrst;
     }
 
-    _sfzWriter->write();
-
-    // Delete the writer so that a new one can be created for the next preset
-    delete _sfzWriter;
+    // Write the file in parallel, the writer is then deleted
+    _writerPool.start(new RunnableSfzWriter(_sfzWriter));
     _sfzWriter = nullptr;
 }
 
@@ -240,20 +286,25 @@ QString ConversionSfz::getPathSfz(QString dir, QString name)
     if (name.isEmpty())
         name = tr("untitled");
     name = escapeStr(name);
-    QFile file(dir + "/" + name + ".sfz");
-    QDir dossier(dir + "/" + name);
-    if (file.exists() || dossier.exists())
+    if (isPathUsed(dir + "/" + name + ".sfz") || QDir(dir + "/" + name).exists())
     {
         int i = 1;
-        while (QFile(dir + "/" + name + "-" + QString::number(i) + ".sfz").exists() ||
+        while (isPathUsed(dir + "/" + name + "-" + QString::number(i) + ".sfz") ||
                QDir(dir + "/" + name + "-" + QString::number(i)).exists())
             i++;
         name = name + "-" + QString::number(i);
     }
+    _reservedPaths << (dir + "/" + name + ".sfz").toLower();
 
     return dir + "/" + name;
 }
 
+bool ConversionSfz::isPathUsed(QString filePath)
+{
+    // Files are possibly not written yet
+    return _reservedPaths.contains(filePath.toLower()) || QFile(filePath).exists();
+}
+
 QMap<AttributeType, AttributeValue> ConversionSfz::getInstSmplParameters(EltID idInstSmpl)
 {
     EltID idInstSmplGen(elementInstSmplGen, idInstSmpl.indexSf2, idInstSmpl.indexElt, idInstSmpl.indexElt2);
@@ -387,7 +438,7 @@ void ConversionSfz::writeElement(AttributeType champ, double value)
     case champ_modLfoToFilterFc:        _sfzWriter->addLine("fillfo_depth", value);                    break;
     case champ_modLfoToPitch:           /* IMPOSSIBLE !!! */                                           break;
     case champ_keynum:
-        _sfzWriter->addLine("pitch_keycenter", ContextManager::keyName()->getKeyName(qRound(value), false, false, true));
+        _sfzWriter->addLine("pitch_keycenter", KeyNameManager::getInstance()->getKeyName(qRound(value), false, false, true));
         _sfzWriter->addLine("pitch_keytrack", 0);
         break;
     case champ_reverbEffectsSend:       _sfzWriter->addLine("effect1", value);                         break;
@@ -401,7 +452,7 @@ void ConversionSfz::writeElement(AttributeType champ, double value)
     case champ_keynumToVolEnvDecay:     _sfzWriter->addLine("ampeg_decaycc133", value);                break;
     case champ_releaseVolEnv:           _sfzWriter->addLine("ampeg_release", value);                   break;
     case champ_overridingRootKey:
-        _sfzWriter->addLine("pitch_keycenter", ContextManager::keyName()->getKeyName(qRound(value), false, false, true));
+        _sfzWriter->addLine("pitch_keycenter", KeyNameManager::getInstance()->getKeyName(qRound(value), false, false, true));
         break;
     case champ_delayVibLFO:             _sfzWriter->addLine("pitchlfo_delay", value);                  break;
     case champ_freqVibLFO:              _sfzWriter->addLine("pitchlfo_freq", value);                   break;
@@ -426,11 +477,11 @@ void ConversionSfz::writeElement(AttributeType champ, double value)
         int hikey = qRound(value - 1000. * qRound(value / 1000.));
         if (lokey != hikey)
         {
-            _sfzWriter->addLine("lokey", ContextManager::keyName()->getKeyName(lokey, false, false, true));
-            _sfzWriter->addLine("hikey", ContextManager::keyName()->getKeyName(hikey, false, false, true));
+            _sfzWriter->addLine("lokey", KeyNameManager::getInstance()->getKeyName(lokey, false, false, true));
+            _sfzWriter->addLine("hikey", KeyNameManager::getInstance()->getKeyName(hikey, false, false, true));
         }
         else
-            _sfzWriter->addLine("key", ContextManager::keyName()->getKeyName(lokey, false, false, true));
+            _sfzWriter->addLine("key", KeyNameManager::getInstance()->getKeyName(lokey, false, false, true));
     }break;
     case champ_velRange:{
         int lovel = qRound(value / 1000.);
@@ -556,14 +607,14 @@ QString ConversionSfz::getSamplePath(EltID idSmpl, int &sampleChannel, int &link
         name = _sf2->getQstr(idSmpl, champ_name);
 
     name = escapeStr(name);
-    QFile file(_dirSamples + "/" + name + ".wav");
-    if (file.exists())
+    if (isPathUsed(_dirSamples + "/" + name + ".wav"))
     {
         int i = 1;
-        while (QFile(_dirSamples + "/" + name + "-" + QString::number(i) + ".wav").exists())
+        while (isPathUsed(_dirSamples + "/" + name + "-" + QString::number(i) + ".wav"))
             i++;
         name = name + "-" + QString::number(i);
     }
+    _reservedPaths << (_dirSamples + "/" + name + ".wav").toLower();
 
     // Path of the file
     QString path = QDir(_dirSamples).dirName() + "/" + name + ".wav";
@@ -572,21 +623,21 @@ QString ConversionSfz::getSamplePath(EltID idSmpl, int &sampleChannel, int &link
     if (_gmSortEnabled)
         path.prepend("../");
 
-    // Export and save
-    SampleWriterWav writer(_dirSamples + "/" + name + ".wav");
+    // Export and save in parallel
+    QString filePath = _dirSamples + "/" + name + ".wav";
     if (linkedSampleId == -1)
     {
         // Mono sample
-        writer.write(_sf2->getSound(idSmpl));
+        _writerPool.start(new RunnableWavWriter(filePath, _sf2->getSound(idSmpl)));
         _mapSamples[idSmpl.indexElt] = QPair<int, QString>(0, path);
     }
     else
     {
         // Stereo, left channel first
         if (sampleChannel == 1)
-            writer.write(_sf2->getSound(idSmplLinked), _sf2->getSound(idSmpl));
+            _writerPool.start(new RunnableWavWriter(filePath, _sf2->getSound(idSmplLinked), _sf2->getSound(idSmpl)));
         else
-            writer.write(_sf2->getSound(idSmpl), _sf2->getSound(idSmplLinked));
+            _writerPool.start(new RunnableWavWriter(filePath, _sf2->getSound(idSmpl), _sf2->getSound(idSmplLinked)));
 
         _mapSamples[idSmpl.indexElt] = QPair<int, QString>(sampleChannel, path);
         _mapSamples[idSmplLinked.indexElt] = QPair<int, QString>(-sampleChannel, path);
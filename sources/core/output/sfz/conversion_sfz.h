@@ -29,6 +29,8 @@
 #include <QList>
 #include <QMap>
 #include <QTextStream>
+#include <QSet>
+#include <QThreadPool>
 #include "qmath.h"
 #include "basetypes.h"
 #include "sfz/sfzwriter.h"
@@ -56,9 +58,12 @@ private:
     QString _dirSamples;
     bool _bankSortEnabled, _gmSortEnabled;
     SfzWriter * _sfzWriter;
+    QThreadPool _writerPool; // Sample files and sfz files are written in parallel
+    QSet<QString> _reservedPaths; // Paths of the files being written (lower case)
 
     void exportPrst(QString dir, EltID id, bool presetPrefix);
     QString getPathSfz(QString dir, QString name);
+    bool isPathUsed(QString filePath);
     QString getSamplePath(EltID idSmpl, int &sampleChannel, int &linkedSampleId);
     QMap<AttributeType, AttributeValue> getInstSmplParameters(EltID idInstSmpl);
 
@@ -0,0 +1,101 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "polyphonecore.h"
+#include "soundfontmanager.h"
+#include "inputfactory.h"
+#include "abstractinputparser.h"
+#include "outputfactory.h"
+#include "abstractoutput.h"
+#include "keynamemanager.h"
+#include <QFile>
+
+void PolyphoneCore::initialize()
+{
+    SoundfontManager::getInstance();
+    KeyNameManager::getInstance();
+    InputFactory::isSuffixSupported(""); // Creates the list of inputs
+}
+
+int PolyphoneCore::load(QString filePath, QString &error)
+{
+    AbstractInputParser * input = InputFactory::getInput(filePath);
+    input->process(false);
+    int sf2Index = input->getSf2Index();
+    if (input->isSuccess())
+        error = "";
+    else
+    {
+        error = input->getError();
+        close(sf2Index);
+        sf2Index = -1;
+    }
+    delete input;
+
+    return sf2Index;
+}
+
+bool PolyphoneCore::save(int sf2Index, QString filePath, QMap<QString, QVariant> options, QString &error)
+{
+    AbstractOutput * output = OutputFactory::getOutput(filePath);
+    QMapIterator<QString, QVariant> it(options);
+    while (it.hasNext())
+    {
+        it.next();
+        output->setOption(it.key(), it.value());
+    }
+    output->process(sf2Index, false);
+    bool success = output->isSuccess();
+    error = success ? "" : output->getError();
+    delete output;
+
+    return success;
+}
+
+void PolyphoneCore::close(int sf2Index)
+{
+    SoundfontManager * sm = SoundfontManager::getInstance();
+    EltID idSf2(elementSf2, sf2Index);
+    if (sf2Index == -1 || !sm->isValid(idSf2))
+        return;
+
+    // Possibly delete the temporary file created when loading, even if the soundfont has been saved since
+    QString filePathTemporary = sm->getQstr(idSf2, champ_filenameTemporary);
+    if (!filePathTemporary.isEmpty())
+        QFile::remove(filePathTemporary);
+
+    sm->remove(idSf2);
+}
+
+SoundfontManager * PolyphoneCore::soundfonts()
+{
+    return SoundfontManager::getInstance();
+}
+
+void PolyphoneCore::release()
+{
+    SoundfontManager::kill();
+    InputFactory::clear();
+    KeyNameManager::kill();
+}
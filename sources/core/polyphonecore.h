@@ -0,0 +1,59 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef POLYPHONECORE_H
+#define POLYPHONECORE_H
+
+#include <QString>
+#include <QMap>
+#include <QVariant>
+class SoundfontManager;
+
+// Entry point for using the engine without the editor (conversions, batch processing, rendering)
+// Everything relies on QtCore only, the soundfonts being stored in the SoundfontManager
+class PolyphoneCore
+{
+public:
+    /// Create the shared resources, before files are loaded from several threads
+    static void initialize();
+
+    /// Load a file (sf2, sf3, sfz, sfArk or organ) and return the index of the soundfont created, or -1 with an error
+    /// Several files can be loaded at the same time from different threads
+    static int load(QString filePath, QString &error);
+
+    /// Save a soundfont, the format depending on the extension (sf2, sf3 or sfz)
+    /// Options are "quality" for sf3 (0, 1 or 2) and "prefix", "bankdir", "gmsort" for sfz (booleans)
+    static bool save(int sf2Index, QString filePath, QMap<QString, QVariant> options, QString &error);
+
+    /// Close a soundfont and release its memory
+    static void close(int sf2Index);
+
+    /// Access to the soundfonts, for reading or editing them and for creating a Synth
+    static SoundfontManager * soundfonts();
+
+    /// Release all resources (soundfonts included)
+    static void release();
+};
+
+#endif // POLYPHONECORE_H
@@ -0,0 +1,105 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "firfilter.h"
+#include <QtMath>
+
+FirFilter::FirFilter(const QVector<float> &gains) :
+    _fft(nullptr)
+{
+    Q_ASSERT(gains.size() >= 2);
+
+    // Impulse response of the zero-phase filter, centered on 0 (circular)
+    int halfSize = gains.size() - 1;
+    quint32 designSize = static_cast<quint32>(2 * halfSize);
+    QVector<Complex> bins(gains.size());
+    for (int i = 0; i < gains.size(); i++)
+        bins[i] = Complex(gains[i], 0);
+    QVector<float> impulse(static_cast<int>(designSize));
+    {
+        FourierTransform design(designSize);
+        design.inverse(bins.constData(), impulse.data());
+    }
+
+    // Truncation with a Blackman window, the filter being delayed by half its length
+    _length = 2 * halfSize - 1;
+    _delay = halfSize - 1;
+    QVector<float> coefs(_length);
+    for (int i = 0; i < _length; i++)
+    {
+        double window = 1;
+        if (_length > 1)
+        {
+            double x = 2. * M_PI * i / (_length - 1);
+            window = 0.42 - 0.5 * qCos(x) + 0.08 * qCos(2 * x);
+        }
+        coefs[i] = static_cast<float>(impulse[(i - _delay + halfSize * 2) % (halfSize * 2)] * window);
+    }
+
+    // Spectrum of the coefficients for the blocks
+    _fft = new FourierTransform(FourierTransform::getOptimalSize(static_cast<quint32>(4 * _length)));
+    int fftSize = static_cast<int>(_fft->size());
+    _hopSize = fftSize - _length + 1;
+    _block.fill(0, fftSize);
+    for (int i = 0; i < _length; i++)
+        _block[i] = coefs[i];
+    _kernel.resize(static_cast<int>(_fft->binCount()));
+    _spectrum.resize(static_cast<int>(_fft->binCount()));
+    _fft->forward(_block.constData(), _kernel.data());
+}
+
+FirFilter::~FirFilter()
+{
+    delete _fft;
+}
+
+void FirFilter::process(const float * input, float * output, quint32 size)
+{
+    qint64 fftSize = _fft->size();
+    qint64 history = _length - 1;
+    qint64 end = static_cast<qint64>(size);
+    for (qint64 blockStart = 0; blockStart < end + _delay; blockStart += _hopSize)
+    {
+        // New values, preceded by the last values of the previous block
+        for (qint64 i = 0; i < fftSize; i++)
+        {
+            qint64 pos = blockStart - history + i;
+            _block[static_cast<int>(i)] = (pos >= 0 && pos < end) ? input[pos] : 0;
+        }
+
+        // Circular convolution
+        _fft->forward(_block.constData(), _spectrum.data());
+        for (int i = 0; i < _spectrum.size(); i++)
+            _spectrum[i] = _spectrum[i] * _kernel[i];
+        _fft->inverse(_spectrum.constData(), _block.data());
+
+        // Values that are not affected by the wrapping, shifted by the delay
+        for (qint64 i = 0; i < _hopSize; i++)
+        {
+            qint64 pos = blockStart + i - _delay;
+            if (pos >= 0 && pos < end)
+                output[pos] = _block[static_cast<int>(history + i)];
+        }
+    }
+}
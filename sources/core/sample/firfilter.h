@@ -0,0 +1,59 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef FIRFILTER_H
+#define FIRFILTER_H
+
+#include "fouriertransform.h"
+
+// Zero-phase FIR filter applied by blocks (overlap-save)
+// The memory used does not depend on the length of the filtered signal
+class FirFilter
+{
+public:
+    /// Filter whose gains are given for frequencies evenly spaced from 0 to the Nyquist frequency (both included)
+    /// The length of the filter is 2 * (gains.size() - 1) - 1 coefficients
+    FirFilter(const QVector<float> &gains);
+    ~FirFilter();
+
+    /// Number of coefficients
+    int length() const { return _length; }
+
+    /// Filter "size" values, the delay of the filter being compensated
+    /// Input and output must not overlap
+    void process(const float * input, float * output, quint32 size);
+
+private:
+    Q_DISABLE_COPY(FirFilter)
+
+    int _length;
+    int _delay;
+    int _hopSize;
+    FourierTransform * _fft;
+    QVector<Complex> _kernel;
+    QVector<Complex> _spectrum;
+    QVector<float> _block;
+};
+
+#endif // FIRFILTER_H
@@ -0,0 +1,386 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+/*
+ * The mixed-radix complex transform and its real-input wrapper are adapted from kissfft:
+ *
+ * Copyright (c) 2003-2010, Mark Borgerding. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice, this
+ *       list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this
+ *       list of conditions and the following disclaimer in the documentation and/or
+ *       other materials provided with the distribution.
+ *     * Neither the author nor the names of any contributors may be used to endorse or
+ *       promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fouriertransform.h"
+#include <QtMath>
+
+static const int MAX_CACHED_PLANS = 16;
+
+QList<FourierTransform::Plan *> FourierTransform::s_plans;
+QMutex FourierTransform::s_mutex;
+
+FourierTransform::FourierTransform(quint32 size) :
+    _size(size)
+{
+    Q_ASSERT(size >= 2 && size % 2 == 0);
+    _plan = acquirePlan(size);
+    _twiddles = _plan->twiddles.constData();
+
+    // Work buffers
+    _input.resize(static_cast<int>(size / 2));
+    _output.resize(static_cast<int>(size / 2));
+    int maxRadix = 1;
+    for (int i = 0; i < _plan->factors.size(); i += 2)
+        maxRadix = qMax(maxRadix, _plan->factors[i]);
+    _scratch.resize(maxRadix);
+}
+
+FourierTransform::~FourierTransform()
+{
+    releasePlan(_plan);
+}
+
+quint32 FourierTransform::getOptimalSize(quint32 minSize)
+{
+    // Smallest even number made of the factors 2, 3 and 5
+    quint32 size = qMax(minSize, 2u);
+    if (size % 2 != 0)
+        size++;
+    while (true)
+    {
+        quint32 n = size / 2;
+        while (n % 2 == 0)
+            n /= 2;
+        while (n % 3 == 0)
+            n /= 3;
+        while (n % 5 == 0)
+            n /= 5;
+        if (n == 1)
+            return size;
+        size += 2;
+    }
+}
+
+FourierTransform::Plan * FourierTransform::acquirePlan(quint32 size)
+{
+    QMutexLocker locker(&s_mutex);
+
+    // Existing plan?
+    for (int i = 0; i < s_plans.count(); i++)
+    {
+        if (s_plans[i]->size == size)
+        {
+            Plan * plan = s_plans.takeAt(i);
+            plan->useCount++;
+            s_plans.append(plan);
+            return plan;
+        }
+    }
+
+    // Factors of the complex transform, radix 4 first
+    Plan * plan = new Plan();
+    plan->size = size;
+    plan->useCount = 1;
+    int n = static_cast<int>(size / 2);
+    int p = 4;
+    int floorSqrt = static_cast<int>(qFloor(qSqrt(n)));
+    do
+    {
+        while (n % p)
+        {
+            switch (p)
+            {
+            case 4: p = 2; break;
+            case 2: p = 3; break;
+            default: p += 2; break;
+            }
+            if (p > floorSqrt)
+                p = n;
+        }
+        n /= p;
+        plan->factors << p << n;
+    } while (n > 1);
+
+    // Twiddles
+    int halfSize = static_cast<int>(size / 2);
+    plan->twiddles.resize(halfSize);
+    for (int i = 0; i < halfSize; i++)
+    {
+        double phase = -2.0 * M_PI * i / halfSize;
+        plan->twiddles[i] = Complex(static_cast<float>(qCos(phase)), static_cast<float>(qSin(phase)));
+    }
+    plan->realTwiddles.resize(halfSize / 2 + 1);
+    for (int i = 0; i <= halfSize / 2; i++)
+    {
+        double phase = -2.0 * M_PI * i / size;
+        plan->realTwiddles[i] = Complex(static_cast<float>(qCos(phase)), static_cast<float>(qSin(phase)));
+    }
+
+    // Store it, the oldest unused plans being removed
+    s_plans.append(plan);
+    for (int i = 0; i < s_plans.count() && s_plans.count() > MAX_CACHED_PLANS; i++)
+    {
+        if (s_plans[i]->useCount == 0)
+        {
+            delete s_plans.takeAt(i);
+            i--;
+        }
+    }
+
+    return plan;
+}
+
+void FourierTransform::releasePlan(Plan * plan)
+{
+    QMutexLocker locker(&s_mutex);
+    plan->useCount--;
+    if (plan->useCount == 0 && s_plans.count() > MAX_CACHED_PLANS)
+    {
+        // The cache was full when the plan was used
+        s_plans.removeOne(plan);
+        delete plan;
+    }
+}
+
+void FourierTransform::forward(const float * input, Complex * output)
+{
+    // Even and odd values are the real and imaginary parts of a signal half the size
+    int halfSize = static_cast<int>(_size / 2);
+    Complex * data = _input.data();
+    for (int i = 0; i < halfSize; i++)
+        data[i] = Complex(input[2 * i], input[2 * i + 1]);
+    transform(_output.data(), _input.constData(), 1, _plan->factors.constData());
+
+    // Split the transforms of the even and odd values and combine them
+    const Complex * z = _output.constData();
+    const Complex * w = _plan->realTwiddles.constData();
+    output[0] = Complex(z[0].real() + z[0].imag(), 0);
+    output[halfSize] = Complex(z[0].real() - z[0].imag(), 0);
+    for (int k = 1; k <= halfSize - k; k++)
+    {
+        Complex even = (z[k] + z[halfSize - k].conj()) * 0.5f;
+        Complex odd = (z[k] - z[halfSize - k].conj()) * 0.5f;
+        Complex t = w[k] * Complex(odd.imag(), -odd.real());
+        output[k] = even + t;
+        output[halfSize - k] = (even - t).conj();
+    }
+}
+
+void FourierTransform::inverse(const Complex * input, float * output)
+{
+    // Transform of the signal made of the even and odd values, conjugated for computing the inverse transform
+    int halfSize = static_cast<int>(_size / 2);
+    const Complex * w = _plan->realTwiddles.constData();
+    Complex * z = _input.data();
+    for (int k = 0; k <= halfSize - k; k++)
+    {
+        Complex even = (input[k] + input[halfSize - k].conj()) * 0.5f;
+        Complex odd = (input[k] - input[halfSize - k].conj()) * 0.5f * w[k].conj();
+        z[k] = (even + Complex(-odd.imag(), odd.real())).conj();
+        if (k != 0 && k != halfSize - k)
+            z[halfSize - k] = (even.conj() + Complex(odd.imag(), odd.real())).conj();
+    }
+    transform(_output.data(), _input.constData(), 1, _plan->factors.constData());
+
+    // Scale and interleave
+    float scale = 1.0f / halfSize;
+    const Complex * data = _output.constData();
+    for (int i = 0; i < halfSize; i++)
+    {
+        output[2 * i] = data[i].real() * scale;
+        output[2 * i + 1] = -data[i].imag() * scale;
+    }
+}
+
+void FourierTransform::transform(Complex * output, const Complex * input, int stride, const int * factors)
+{
+    // Decimation in time: each sub-sequence is transformed and then combined with the butterflies
+    Complex * outputBegin = output;
+    int p = *factors++;
+    int m = *factors++;
+    const Complex * outputEnd = output + p * m;
+    if (m == 1)
+    {
+        do
+        {
+            *output = *input;
+            input += stride;
+        } while (++output != outputEnd);
+    }
+    else
+    {
+        do
+        {
+            transform(output, input, stride * p, factors);
+            input += stride;
+        } while ((output += m) != outputEnd);
+    }
+
+    switch (p)
+    {
+    case 2: butterfly2(outputBegin, stride, m); break;
+    case 3: butterfly3(outputBegin, stride, m); break;
+    case 4: butterfly4(outputBegin, stride, m); break;
+    case 5: butterfly5(outputBegin, stride, m); break;
+    default: butterflyGeneric(outputBegin, stride, m, p); break;
+    }
+}
+
+void FourierTransform::butterfly2(Complex * data, int stride, int m)
+{
+    Complex * data2 = data + m;
+    const Complex * tw = _twiddles;
+    for (int i = 0; i < m; i++)
+    {
+        Complex t = data2[i] * *tw;
+        tw += stride;
+        data2[i] = data[i] - t;
+        data[i] += t;
+    }
+}
+
+void FourierTransform::butterfly3(Complex * data, int stride, int m)
+{
+    const Complex * tw1 = _twiddles;
+    const Complex * tw2 = _twiddles;
+    float epi3 = _twiddles[stride * m].imag();
+    for (int i = 0; i < m; i++)
+    {
+        Complex s1 = data[m] * *tw1;
+        Complex s2 = data[2 * m] * *tw2;
+        Complex s3 = s1 + s2;
+        Complex s0 = (s1 - s2) * epi3;
+        tw1 += stride;
+        tw2 += 2 * stride;
+
+        Complex d1 = *data - s3 * 0.5f;
+        *data += s3;
+        data[2 * m] = Complex(d1.real() + s0.imag(), d1.imag() - s0.real());
+        data[m] = Complex(d1.real() - s0.imag(), d1.imag() + s0.real());
+        data++;
+    }
+}
+
+void FourierTransform::butterfly4(Complex * data, int stride, int m)
+{
+    const Complex * tw1 = _twiddles;
+    const Complex * tw2 = _twiddles;
+    const Complex * tw3 = _twiddles;
+    for (int i = 0; i < m; i++)
+    {
+        Complex s0 = data[m] * *tw1;
+        Complex s1 = data[2 * m] * *tw2;
+        Complex s2 = data[3 * m] * *tw3;
+        Complex s5 = *data - s1;
+        *data += s1;
+        Complex s3 = s0 + s2;
+        Complex s4 = s0 - s2;
+        data[2 * m] = *data - s3;
+        *data += s3;
+        tw1 += stride;
+        tw2 += 2 * stride;
+        tw3 += 3 * stride;
+        data[m] = Complex(s5.real() + s4.imag(), s5.imag() - s4.real());
+        data[3 * m] = Complex(s5.real() - s4.imag(), s5.imag() + s4.real());
+        data++;
+    }
+}
+
+void FourierTransform::butterfly5(Complex * data, int stride, int m)
+{
+    Complex ya = _twiddles[stride * m];
+    Complex yb = _twiddles[stride * 2 * m];
+    Complex * data0 = data;
+    Complex * data1 = data + m;
+    Complex * data2 = data + 2 * m;
+    Complex * data3 = data + 3 * m;
+    Complex * data4 = data + 4 * m;
+    for (int u = 0; u < m; u++)
+    {
+        Complex s0 = data0[u];
+        Complex s1 = data1[u] * _twiddles[u * stride];
+        Complex s2 = data2[u] * _twiddles[2 * u * stride];
+        Complex s3 = data3[u] * _twiddles[3 * u * stride];
+        Complex s4 = data4[u] * _twiddles[4 * u * stride];
+        Complex s7 = s1 + s4;
+        Complex s10 = s1 - s4;
+        Complex s8 = s2 + s3;
+        Complex s9 = s2 - s3;
+
+        data0[u] += s7 + s8;
+        Complex s5 = s0 + s7 * ya.real() + s8 * yb.real();
+        Complex s6(s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                   -s10.real() * ya.imag() - s9.real() * yb.imag());
+        data1[u] = s5 - s6;
+        data4[u] = s5 + s6;
+        Complex s11 = s0 + s7 * yb.real() + s8 * ya.real();
+        Complex s12(-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                    s10.real() * yb.imag() - s9.real() * ya.imag());
+        data2[u] = s11 + s12;
+        data3[u] = s11 - s12;
+    }
+}
+
+void FourierTransform::butterflyGeneric(Complex * data, int stride, int m, int p)
+{
+    int n = static_cast<int>(_size / 2);
+    Complex * scratch = _scratch.data();
+    for (int u = 0; u < m; u++)
+    {
+        for (int q1 = 0, k = u; q1 < p; q1++, k += m)
+            scratch[q1] = data[k];
+
+        for (int q1 = 0, k = u; q1 < p; q1++, k += m)
+        {
+            int twiddleIndex = 0;
+            data[k] = scratch[0];
+            for (int q = 1; q < p; q++)
+            {
+                twiddleIndex += stride * k;
+                if (twiddleIndex >= n)
+                    twiddleIndex -= n;
+                data[k] += scratch[q] * _twiddles[twiddleIndex];
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef FOURIERTRANSFORM_H
+#define FOURIERTRANSFORM_H
+
+#include "complex.h"
+#include <QVector>
+#include <QList>
+#include <QMutex>
+
+// Fourier transform of real signals, based on a mixed-radix complex transform of half the size
+// The algorithm is adapted from kissfft (see the license in fouriertransform.cpp)
+// Plans (factors and twiddles) are shared between the transforms having the same size and kept in a cache
+// An instance is used by one thread at a time, its work buffers being reused from one transform to the other
+class FourierTransform
+{
+public:
+    /// Transform of real signals made of "size" values, size being even
+    /// Sizes that are products of 2, 3 and 5 are the fastest (see getOptimalSize)
+    FourierTransform(quint32 size);
+    ~FourierTransform();
+
+    /// Smallest fast size that is greater than or equal to minSize, for padding a signal with zeros
+    static quint32 getOptimalSize(quint32 minSize);
+
+    /// Number of real values
+    quint32 size() const { return _size; }
+
+    /// Number of bins of the transform (size / 2 + 1)
+    quint32 binCount() const { return _size / 2 + 1; }
+
+    /// Forward transform: "size" values are read in input and "size / 2 + 1" bins are written in output
+    void forward(const float * input, Complex * output);
+
+    /// Inverse transform: "size / 2 + 1" bins are read in input and "size" values are written in output
+    /// The result is scaled so that the inverse of the forward transform gives the initial signal
+    void inverse(const Complex * input, float * output);
+
+private:
+    struct Plan
+    {
+        quint32 size;
+        QVector<int> factors; // Radix and remaining size for each stage of the complex transform
+        QVector<Complex> twiddles; // Twiddles of the complex transform (size / 2)
+        QVector<Complex> realTwiddles; // Twiddles for splitting the complex transform into the real transform (size / 2)
+        int useCount;
+    };
+
+    Q_DISABLE_COPY(FourierTransform)
+
+    static Plan * acquirePlan(quint32 size);
+    static void releasePlan(Plan * plan);
+    void transform(Complex * output, const Complex * input, int stride, const int * factors);
+    void butterfly2(Complex * data, int stride, int m);
+    void butterfly3(Complex * data, int stride, int m);
+    void butterfly4(Complex * data, int stride, int m);
+    void butterfly5(Complex * data, int stride, int m);
+    void butterflyGeneric(Complex * data, int stride, int m, int p);
+
+    quint32 _size;
+    Plan * _plan;
+    const Complex * _twiddles;
+    QVector<Complex> _input;
+    QVector<Complex> _output;
+    QVector<Complex> _scratch;
+
+    static QList<Plan *> s_plans; // The most recently used plan is the last one
+    static QMutex s_mutex;
+};
+
+#endif // FOURIERTRANSFORM_H
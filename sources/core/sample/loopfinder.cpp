@@ -0,0 +1,271 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "loopfinder.h"
+#include "sampleutils.h"
+#include "fouriertransform.h"
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QtMath>
+#include <algorithm>
+
+static const int LOOP_END_COUNT = 8; // Loop ends evaluated in the last quarter of the steady part
+static const int LOOP_START_COUNT = 4; // Loop starts kept for each loop end
+static const quint32 FRAME_SIZE = 2048; // For the spectral distance
+static const float SPECTRAL_WEIGHT = 0.02f; // Weight of 1 dB of spectral distance in the score
+
+class LoopFinderTask: public QRunnable
+{
+public:
+    LoopFinderTask(LoopFinder * finder, quint32 loopEnd, QSemaphore * semaphore) : QRunnable(),
+        _finder(finder),
+        _loopEnd(loopEnd),
+        _semaphore(semaphore)
+    {
+        // Deleted by the finder, that may also run the task itself
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        _finder->processLoopEnd(_loopEnd);
+        _semaphore->release();
+    }
+
+private:
+    LoopFinder * _finder;
+    quint32 _loopEnd;
+    QSemaphore * _semaphore;
+};
+
+LoopFinder::LoopFinder(QVector<float> vData1, QVector<float> vData2, quint32 dwSmplRate) :
+    _dwSmplRate(dwSmplRate),
+    _posStart(0),
+    _segmentLength(static_cast<quint32>(0.05 * dwSmplRate))
+{
+    // Both sides are cut to the same length
+    _channels << vData1;
+    if (!vData2.isEmpty())
+    {
+        int length = qMin(vData1.size(), vData2.size());
+        _channels[0].resize(length);
+        vData2.resize(length);
+        _channels << vData2;
+    }
+
+    // Hann window for the spectral distance
+    _window.resize(static_cast<int>(FRAME_SIZE));
+    for (quint32 i = 0; i < FRAME_SIZE; i++)
+        _window[static_cast<int>(i)] = static_cast<float>(0.5 - 0.5 * qCos(2. * M_PI * i / FRAME_SIZE));
+}
+
+QList<LoopFinder::Candidate> LoopFinder::find(quint32 loopStart, quint32 loopEnd, int maxCount)
+{
+    _candidates.clear();
+    quint32 size = static_cast<quint32>(_channels[0].size());
+    if (size < 2 || _segmentLength == 0)
+        return _candidates;
+
+    // Steady part, found on the sum of both sides
+    _posStart = loopStart;
+    if (loopEnd >= size)
+        loopEnd = size - 1;
+    if (_posStart >= loopEnd || loopEnd < _dwSmplRate / 4 + _posStart)
+    {
+        QVector<float> vData = _channels[0];
+        if (_channels.size() > 1)
+        {
+            const float * data2 = _channels[1].constData();
+            for (int i = 0; i < vData.size(); i++)
+                vData[i] = 0.5f * (vData[i] + data2[i]);
+        }
+        SampleUtils::regimePermanent(vData, _dwSmplRate, _posStart, loopEnd);
+    }
+    if (loopEnd < _dwSmplRate / 4 + _posStart)
+        return _candidates;
+
+    // One task per loop end, in the last quarter of the steady part
+    QThreadPool * threadPool = getThreadPool();
+    QSemaphore semaphore;
+    QList<LoopFinderTask *> tasks;
+    quint32 step = (loopEnd - _posStart) / (4 * LOOP_END_COUNT);
+    for (int i = 0; i < LOOP_END_COUNT; i++)
+    {
+        LoopFinderTask * task = new LoopFinderTask(this, loopEnd - i * step, &semaphore);
+        tasks << task;
+        threadPool->start(task);
+        if (step == 0)
+            break;
+    }
+
+    // The tasks that have not started yet are run in this thread
+    foreach (LoopFinderTask * task, tasks)
+        if (threadPool->tryTake(task))
+            task->run();
+    semaphore.acquire(tasks.size());
+    qDeleteAll(tasks);
+
+    // Best candidates
+    std::sort(_candidates.begin(), _candidates.end());
+    while (_candidates.size() > maxCount)
+        _candidates.removeLast();
+    return _candidates;
+}
+
+void LoopFinder::processLoopEnd(quint32 loopEnd)
+{
+    // Segment at the end of the loop compared to the values before each possible loop start
+    if ((loopEnd - _posStart) / 2 <= 2 * _segmentLength)
+        return;
+    quint32 nbCor = (loopEnd - _posStart) / 2 - 2 * _segmentLength;
+    QVector<float> vectCorrel(static_cast<int>(nbCor), 0);
+    QVector<float> products(static_cast<int>(nbCor));
+    foreach (QVector<float> vData, _channels)
+    {
+        // Mean squared differences, from the products and running energy sums (see SampleUtils::loopStep1)
+        const float * pointerSegB = &vData.constData()[loopEnd - _segmentLength];
+        const float * pointerData = &vData.constData()[_segmentLength + _posStart];
+        SampleUtils::crossCorrelation(pointerSegB, _segmentLength, pointerData, nbCor, products.data());
+        double energySegB = 0;
+        double energyData = 0;
+        for (quint32 j = 0; j < _segmentLength; j++)
+        {
+            energySegB += static_cast<double>(pointerSegB[j]) * pointerSegB[j];
+            energyData += static_cast<double>(pointerData[j]) * pointerData[j];
+        }
+        for (quint32 i = 0; i < nbCor; i++)
+        {
+            vectCorrel[static_cast<int>(i)] += static_cast<float>(
+                        qMax(0.0, energySegB + energyData - 2.0 * products[static_cast<int>(i)]) /
+                        (_segmentLength * _channels.size()));
+            if (i + 1 < nbCor)
+                energyData += static_cast<double>(pointerData[i + _segmentLength]) * pointerData[i + _segmentLength] -
+                        static_cast<double>(pointerData[i]) * pointerData[i];
+        }
+    }
+
+    // Smallest local minima
+    QList<quint32> positions;
+    for (quint32 i = 0; i < nbCor; i++)
+    {
+        float value = vectCorrel[static_cast<int>(i)];
+        if ((i > 0 && vectCorrel[static_cast<int>(i - 1)] <= value) ||
+                (i + 1 < nbCor && vectCorrel[static_cast<int>(i + 1)] < value))
+            continue;
+
+        int index = 0;
+        while (index < positions.size() && vectCorrel[static_cast<int>(positions[index])] <= value)
+            index++;
+        if (index < LOOP_START_COUNT)
+        {
+            positions.insert(index, i);
+            if (positions.size() > LOOP_START_COUNT)
+                positions.removeLast();
+        }
+    }
+
+    // Evaluate the candidates
+    QList<Candidate> candidates;
+    foreach (quint32 pos, positions)
+    {
+        Candidate candidate;
+        candidate.loopStart = 2 * _segmentLength + pos + _posStart;
+        candidate.loopEnd = loopEnd;
+        candidate.correlation = vectCorrel[static_cast<int>(pos)];
+
+        // Crossfade length increasing with the incoherence (see SampleUtils::loopStep1)
+        candidate.crossfadeLength = qMin(pos + 2 * _segmentLength, static_cast<quint32>(
+                                             qMax(0.0f, 1.0f - candidate.correlation) * _dwSmplRate * 4.0f + 0.5f));
+
+        // Quality of the loop points and continuity of the spectrum, for the worst side
+        candidate.quality = 0;
+        candidate.spectralDistance = 0;
+        foreach (QVector<float> vData, _channels)
+        {
+            candidate.quality = qMax(candidate.quality, SampleUtils::computeLoopQuality(
+                                         vData, candidate.loopStart, candidate.loopEnd));
+            candidate.spectralDistance = qMax(candidate.spectralDistance, getSpectralDistance(
+                                                  vData, candidate.loopStart, candidate.loopEnd));
+        }
+        candidate.score = candidate.quality + SPECTRAL_WEIGHT * candidate.spectralDistance;
+        candidates << candidate;
+    }
+
+    _mutex.lock();
+    _candidates << candidates;
+    _mutex.unlock();
+}
+
+float LoopFinder::getSpectralDistance(const QVector<float> &vData, quint32 pos1, quint32 pos2)
+{
+    // Not computed if there are not enough values before the loop start
+    if (pos1 < FRAME_SIZE || pos2 < FRAME_SIZE)
+        return 0;
+
+    // Power spectra of the values before the loop start and before the loop end
+    QVector<float> power1 = getPowerSpectrum(&vData.constData()[pos1 - FRAME_SIZE]);
+    QVector<float> power2 = getPowerSpectrum(&vData.constData()[pos2 - FRAME_SIZE]);
+    float powerMax = 0;
+    for (int i = 0; i < power1.size(); i++)
+        powerMax = qMax(powerMax, qMax(power1[i], power2[i]));
+    if (powerMax <= 0)
+        return 0;
+
+    // Root mean square of the differences in dB, for the bins above -60 dB
+    float noiseFloor = powerMax * 1e-6f;
+    double sum = 0;
+    int count = 0;
+    for (int i = 0; i < power1.size(); i++)
+    {
+        if (power1[i] < noiseFloor && power2[i] < noiseFloor)
+            continue;
+        double diff = 10.0 * log10((power1[i] + noiseFloor) / (power2[i] + noiseFloor));
+        sum += diff * diff;
+        count++;
+    }
+    return count > 0 ? static_cast<float>(qSqrt(sum / count)) : 0;
+}
+
+QVector<float> LoopFinder::getPowerSpectrum(const float * data)
+{
+    FourierTransform fft(FRAME_SIZE);
+    QVector<float> frame(static_cast<int>(FRAME_SIZE));
+    for (int i = 0; i < frame.size(); i++)
+        frame[i] = data[i] * _window[i];
+    QVector<Complex> spectrum(static_cast<int>(fft.binCount()));
+    fft.forward(frame.constData(), spectrum.data());
+
+    QVector<float> power(spectrum.size());
+    for (int i = 0; i < spectrum.size(); i++)
+        power[i] = spectrum[i].real() * spectrum[i].real() + spectrum[i].imag() * spectrum[i].imag();
+    return power;
+}
+
+QThreadPool * LoopFinder::getThreadPool()
+{
+    // Pool dedicated to the loop search, so that a search can be started from the global pool
+    static QThreadPool * s_threadPool = new QThreadPool();
+    return s_threadPool;
+}
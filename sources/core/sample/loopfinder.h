@@ -0,0 +1,76 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef LOOPFINDER_H
+#define LOOPFINDER_H
+
+#include <QVector>
+#include <QList>
+#include <QMutex>
+class QThreadPool;
+
+// Search of loops in a sample, or jointly in both sides of a stereo sample
+// Several loop ends are evaluated in parallel, each giving several loop starts, and all candidates are ranked
+class LoopFinder
+{
+public:
+    struct Candidate
+    {
+        quint32 loopStart;
+        quint32 loopEnd;
+        quint32 crossfadeLength;
+        float correlation; // Mean squared difference between the end of the loop and the values before the start
+        float quality; // Result of SampleUtils::computeLoopQuality, for the worst side
+        float spectralDistance; // Log-spectral distance in dB between the end of the loop and the values before the start
+        float score; // The lower the better
+
+        bool operator<(const Candidate &other) const { return score < other.score; }
+    };
+
+    /// Both sides must have the same sample rate, vData2 is empty for a mono sample
+    LoopFinder(QVector<float> vData1, QVector<float> vData2, quint32 dwSmplRate);
+
+    /// Find at most "maxCount" loops, sorted from the best one
+    /// The search is made between loopStart and loopEnd if they are far enough, otherwise in the steady part of the sample
+    QList<Candidate> find(quint32 loopStart, quint32 loopEnd, int maxCount);
+
+private:
+    friend class LoopFinderTask;
+    Q_DISABLE_COPY(LoopFinder)
+
+    void processLoopEnd(quint32 loopEnd);
+    float getSpectralDistance(const QVector<float> &vData, quint32 pos1, quint32 pos2);
+    QVector<float> getPowerSpectrum(const float * data);
+    static QThreadPool * getThreadPool();
+
+    QList<QVector<float> > _channels;
+    quint32 _dwSmplRate;
+    quint32 _posStart;
+    quint32 _segmentLength;
+    QVector<float> _window;
+    QList<Candidate> _candidates;
+    QMutex _mutex;
+};
+
+#endif // LOOPFINDER_H
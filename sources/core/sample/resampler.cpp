@@ -0,0 +1,205 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "resampler.h"
+#include <QtMath>
+
+static const int HALF_LENGTH = 32; // Coefficients on each side of a position when the rate increases
+static const int MAX_HALF_LENGTH = 1024;
+static const quint32 MAX_RATIONAL_PHASES = 1024;
+static const int INTERPOLATED_PHASES = 256;
+static const double BANDWIDTH = 0.92; // Part of the smallest Nyquist frequency that is kept
+static const double KAISER_BETA = 8.0; // Stopband attenuation of about 80 dB
+
+Resampler::Resampler(double inputRate, double outputRate) :
+    _inputRate(inputRate),
+    _outputRate(outputRate),
+    _step(inputRate / outputRate),
+    _rational(false),
+    _numerator(0)
+{
+    // Longer filters when the rate decreases, so that the transition band keeps the same width
+    double ratio = qMin(1.0, outputRate / inputRate);
+    _halfLength = qMin(MAX_HALF_LENGTH, static_cast<int>(qCeil(HALF_LENGTH / ratio)));
+    _halfLength += _halfLength % 2; // Number of coefficients multiple of 4
+    _tapCount = 2 * _halfLength;
+
+    // Rational ratio between the sample rates?
+    quint32 rateIn = static_cast<quint32>(qRound(inputRate));
+    quint32 rateOut = static_cast<quint32>(qRound(outputRate));
+    if (rateIn > 0 && rateOut > 0 && qAbs(inputRate - rateIn) < 1e-9 && qAbs(outputRate - rateOut) < 1e-9)
+    {
+        quint32 a = rateIn, b = rateOut;
+        while (b != 0)
+        {
+            quint32 tmp = a % b;
+            a = b;
+            b = tmp;
+        }
+        if (rateOut / a <= MAX_RATIONAL_PHASES)
+        {
+            _rational = true;
+            _phaseCount = static_cast<int>(rateOut / a);
+            _numerator = rateIn / a;
+        }
+    }
+    if (!_rational)
+        _phaseCount = INTERPOLATED_PHASES;
+
+    // Filterbank: windowed sinc for each fractional position
+    // An additional phase is computed for the interpolation of the last one
+    int storedPhases = _rational ? _phaseCount : _phaseCount + 1;
+    _coefs.resize(storedPhases * _tapCount);
+    double cutoff = ratio * BANDWIDTH;
+    double besselBeta = besselI0(KAISER_BETA);
+    for (int phase = 0; phase < storedPhases; phase++)
+    {
+        double delta = static_cast<double>(phase) / _phaseCount;
+        float * coefs = _coefs.data() + phase * _tapCount;
+        double sum = 0;
+        for (int i = 0; i < _tapCount; i++)
+        {
+            double t = (i - _halfLength + 1) - delta;
+            double x = t / _halfLength;
+            double value = 0;
+            if (qAbs(x) < 1.0)
+            {
+                value = qAbs(t) < 1e-9 ? cutoff : qSin(M_PI * cutoff * t) / (M_PI * t);
+                value *= besselI0(KAISER_BETA * qSqrt(1.0 - x * x)) / besselBeta;
+            }
+            coefs[i] = static_cast<float>(value);
+            sum += value;
+        }
+
+        // Unity gain for a constant signal
+        for (int i = 0; i < _tapCount; i++)
+            coefs[i] = static_cast<float>(coefs[i] / sum);
+    }
+}
+
+quint32 Resampler::getOutputSize(quint32 inputSize) const
+{
+    if (inputSize == 0)
+        return 0;
+    return static_cast<quint32>(1. + (inputSize - 1.0) * _outputRate / _inputRate);
+}
+
+void Resampler::process(const float * input, quint32 inputSize, float * output, quint32 firstOutput, quint32 outputCount) const
+{
+    for (quint32 i = 0; i < outputCount; i++)
+    {
+        quint64 index = static_cast<quint64>(firstOutput) + i;
+        if (_rational)
+        {
+            // Exact position
+            quint64 num = index * _numerator;
+            output[i] = computeValue(input, inputSize, static_cast<qint64>(num / static_cast<quint64>(_phaseCount)),
+                                     _coefs.constData() + (num % static_cast<quint64>(_phaseCount)) * static_cast<quint64>(_tapCount));
+        }
+        else
+        {
+            // Position between two phases
+            double pos = index * _step;
+            double posFloor = qFloor(pos);
+            double phasePos = (pos - posFloor) * _phaseCount;
+            int phase = qMin(_phaseCount - 1, static_cast<int>(phasePos));
+            const float * coefs = _coefs.constData() + phase * _tapCount;
+            output[i] = computeValue(input, inputSize, static_cast<qint64>(posFloor), coefs, coefs + _tapCount,
+                                     static_cast<float>(phasePos - phase));
+        }
+    }
+}
+
+float Resampler::computeValue(const float * input, qint64 inputSize, qint64 position, const float * coefs) const
+{
+    qint64 first = position - _halfLength + 1;
+    if (first >= 0 && first + _tapCount <= inputSize)
+    {
+        // Dot product, with 4 independent sums
+        const float * data = input + first;
+        float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+        for (int i = 0; i < _tapCount; i += 4)
+        {
+            sum0 += data[i] * coefs[i];
+            sum1 += data[i + 1] * coefs[i + 1];
+            sum2 += data[i + 2] * coefs[i + 2];
+            sum3 += data[i + 3] * coefs[i + 3];
+        }
+        return (sum0 + sum1) + (sum2 + sum3);
+    }
+
+    // Borders of the signal, the values outside being zeros
+    float sum = 0;
+    for (int i = qMax(0, static_cast<int>(-first)); i < _tapCount && first + i < inputSize; i++)
+        sum += input[first + i] * coefs[i];
+    return sum;
+}
+
+float Resampler::computeValue(const float * input, qint64 inputSize, qint64 position, const float * coefs1,
+                              const float * coefs2, float interpolation) const
+{
+    qint64 first = position - _halfLength + 1;
+    float sum1 = 0, sum2 = 0;
+    if (first >= 0 && first + _tapCount <= inputSize)
+    {
+        // Dot products with both phases
+        const float * data = input + first;
+        float sum1b = 0, sum2b = 0;
+        for (int i = 0; i < _tapCount; i += 2)
+        {
+            sum1 += data[i] * coefs1[i];
+            sum2 += data[i] * coefs2[i];
+            sum1b += data[i + 1] * coefs1[i + 1];
+            sum2b += data[i + 1] * coefs2[i + 1];
+        }
+        sum1 += sum1b;
+        sum2 += sum2b;
+    }
+    else
+    {
+        // Borders of the signal, the values outside being zeros
+        for (int i = qMax(0, static_cast<int>(-first)); i < _tapCount && first + i < inputSize; i++)
+        {
+            sum1 += input[first + i] * coefs1[i];
+            sum2 += input[first + i] * coefs2[i];
+        }
+    }
+    return sum1 + (sum2 - sum1) * interpolation;
+}
+
+double Resampler::besselI0(double x)
+{
+    // Power series of the modified Bessel function of the first kind, order 0
+    double sum = 1.0;
+    double term = 1.0;
+    double halfX = 0.5 * x;
+    for (int k = 1; k < 50; k++)
+    {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+    return sum;
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <QVector>
+
+// Polyphase resampler: each output value is the dot product of the input around its position with
+// a set of coefficients (a phase) taken in a precomputed filterbank
+// The anti-aliasing low-pass filter is included in the coefficients
+// Rational ratios use one phase per fractional position, other ratios interpolate between two phases
+class Resampler
+{
+public:
+    Resampler(double inputRate, double outputRate);
+
+    /// Number of values after resampling "inputSize" values
+    quint32 getOutputSize(quint32 inputSize) const;
+
+    /// Compute "outputCount" values starting at "firstOutput" (a signal can be processed by blocks)
+    /// The instance is not modified, several threads can process different blocks at the same time
+    void process(const float * input, quint32 inputSize, float * output, quint32 firstOutput, quint32 outputCount) const;
+
+private:
+    float computeValue(const float * input, qint64 inputSize, qint64 position, const float * coefs) const;
+    float computeValue(const float * input, qint64 inputSize, qint64 position, const float * coefs1,
+                       const float * coefs2, float interpolation) const;
+    static double besselI0(double x);
+
+    double _inputRate;
+    double _outputRate;
+    double _step; // Distance between two output values, in input values
+    int _tapCount; // Number of coefficients per phase
+    int _halfLength; // Number of coefficients before and including the position
+    int _phaseCount;
+    bool _rational;
+    quint32 _numerator; // Rational ratio: the position of the output value i is i * _numerator / _phaseCount
+    QVector<float> _coefs; // Coefficients of all phases, one after the other
+};
+
+#endif // RESAMPLER_H
@@ -0,0 +1,122 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "sampledelta.h"
+#include <cstring>
+
+const int SampleDelta::CHUNK_SIZE = 65536;
+
+SampleDelta::SampleDelta() :
+    _isFull(false),
+    _otherLength(0)
+{
+
+}
+
+void SampleDelta::setPreviousData(const QVector<float> &previousData)
+{
+    _isFull = true;
+    _fullData = previousData;
+    _chunks.clear();
+    _otherLength = previousData.size();
+}
+
+void SampleDelta::setPreviousData(const QVector<float> &previousData, const QVector<float> &data)
+{
+    // Chunks that differ
+    int previousLength = previousData.size();
+    int length = data.size();
+    int chunkCount = (qMax(previousLength, length) + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    QList<int> changedChunks;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        int start = i * CHUNK_SIZE;
+        int previousCount = qBound(0, previousLength - start, CHUNK_SIZE);
+        int count = qBound(0, length - start, CHUNK_SIZE);
+        if (previousCount != count ||
+                memcmp(previousData.constData() + start, data.constData() + start, static_cast<size_t>(count) * sizeof(float)) != 0)
+            changedChunks << i;
+    }
+
+    // Everything changed: the previous version is shared instead of being copied by chunks
+    if (changedChunks.size() == chunkCount && chunkCount > 0)
+    {
+        setPreviousData(previousData);
+        return;
+    }
+
+    _isFull = false;
+    _fullData.clear();
+    _chunks.clear();
+    _otherLength = previousLength;
+    foreach (int i, changedChunks)
+    {
+        int start = i * CHUNK_SIZE;
+        _chunks[i] = previousData.mid(start, qBound(0, previousLength - start, CHUNK_SIZE));
+    }
+}
+
+void SampleDelta::swap(QVector<float> &data)
+{
+    if (_isFull)
+    {
+        QVector<float> tmp = data;
+        data = _fullData;
+        _fullData = tmp;
+        _otherLength = _fullData.size();
+        return;
+    }
+
+    // Chunks of the current version, to be stored
+    int length = data.size();
+    QMap<int, QVector<float> > currentChunks;
+    foreach (int i, _chunks.keys())
+    {
+        int start = i * CHUNK_SIZE;
+        currentChunks[i] = data.mid(start, qBound(0, length - start, CHUNK_SIZE));
+    }
+
+    // Other version: the chunks that did not change are kept
+    data.resize(_otherLength);
+    float * values = data.data();
+    foreach (int i, _chunks.keys())
+    {
+        const QVector<float> &chunk = _chunks[i];
+        memcpy(values + i * CHUNK_SIZE, chunk.constData(), static_cast<size_t>(chunk.size()) * sizeof(float));
+    }
+
+    _chunks = currentChunks;
+    _otherLength = length;
+}
+
+qint64 SampleDelta::getMemorySize() const
+{
+    if (_isFull)
+        return static_cast<qint64>(_fullData.size()) * static_cast<qint64>(sizeof(float));
+
+    qint64 result = 0;
+    foreach (const QVector<float> &chunk, _chunks)
+        result += static_cast<qint64>(chunk.size()) * static_cast<qint64>(sizeof(float));
+    return result;
+}
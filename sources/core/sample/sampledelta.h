@@ -0,0 +1,60 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef SAMPLEDELTA_H
+#define SAMPLEDELTA_H
+
+#include <QVector>
+#include <QMap>
+
+// Difference between two versions of the data of a sample, for the undo / redo
+// The data is split into chunks and only the chunks of the other version that differ are stored
+// Each swap restores the other version and keeps instead the chunks of the version that has been replaced
+class SampleDelta
+{
+public:
+    SampleDelta();
+
+    /// Store the previous version completely, without comparing (no copy is made)
+    void setPreviousData(const QVector<float> &previousData);
+
+    /// Store the chunks of the previous version that differ from the new version
+    void setPreviousData(const QVector<float> &previousData, const QVector<float> &data);
+
+    /// Replace "data" by the other version, and store the differences to get back "data"
+    void swap(QVector<float> &data);
+
+    /// Memory used by the stored values, in bytes
+    qint64 getMemorySize() const;
+
+private:
+    static const int CHUNK_SIZE; // Number of values per chunk
+
+    bool _isFull; // True if the other version is completely stored in _fullData
+    QVector<float> _fullData;
+    QMap<int, QVector<float> > _chunks; // Content of the other version for the chunks that differ (may be shorter or empty)
+    int _otherLength; // Length of the other version
+};
+
+#endif // SAMPLEDELTA_H
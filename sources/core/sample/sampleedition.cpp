@@ -22,16 +22,29 @@
 **             Date: 01.01.2013                                           **
 ***************************************************************************/
 
-#include "complex.h"
+#include "sampleedition.h"
+#include "soundfontmanager.h"
 
-Complex::Complex()
+SampleEdition::SampleEdition(SoundfontManager * sm, EltID idSmpl) :
+    _sm(sm),
+    _id(idSmpl),
+    _sound(sm->getSound(idSmpl)),
+    _data(nullptr),
+    _size(0)
 {
-
+    if (!_sound.isNull())
+    {
+        _data = _sound->editData(_previousData);
+        _size = static_cast<quint32>(_previousData.size());
+    }
 }
 
-Complex Complex::operator *= (const float factor)
+SampleEdition::~SampleEdition()
 {
-    _real *= factor;
-    _imag *= factor;
-    return *this;
+    if (_sound.isNull())
+        return;
+
+    // The sample is released before locking the soundfonts, the synth possibly waiting for it with this lock
+    _sound->endEditData();
+    _sm->storeEditedData(_id, _previousData);
 }
@@ -0,0 +1,60 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef SAMPLEEDITION_H
+#define SAMPLEEDITION_H
+
+#include "basetypes.h"
+#include <QVector>
+#include <QSharedPointer>
+class SoundfontManager;
+class Sound;
+
+// Modification of the data of a sample in place, during the lifetime of the instance
+// The sample is locked (no other thread can read it) and kept alive even if it is deleted in the meantime
+// The previous version is stored for the undo when the instance is destroyed
+class SampleEdition
+{
+public:
+    SampleEdition(SoundfontManager * sm, EltID idSmpl);
+    ~SampleEdition();
+
+    /// Data that can be modified, null if the sample is not valid
+    float * getData() { return _data; }
+
+    /// Number of values
+    quint32 getSize() { return _size; }
+
+private:
+    Q_DISABLE_COPY(SampleEdition)
+
+    SoundfontManager * _sm;
+    EltID _id;
+    QSharedPointer<Sound> _sound;
+    QVector<float> _previousData;
+    float * _data;
+    quint32 _size;
+};
+
+#endif // SAMPLEEDITION_H
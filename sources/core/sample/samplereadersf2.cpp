@@ -94,16 +94,21 @@ SampleReaderSf2::SampleReaderResult SampleReaderSf2::getData(QFile &fi, QVector<
         memset(data24, 0, _info->dwLength);
 
     // Convert to float between -1 and 1
+    convert(data, data24, _info->dwLength, fData);
+
+    delete [] data;
+    delete [] data24;
+    return FILE_OK;
+}
+
+void SampleReaderSf2::convert(const qint16 * data, const quint8 * data24, quint32 length, float * fData)
+{
     qint32 tmp;
-    for (quint32 i = 0; i < _info->dwLength; i++)
+    for (quint32 i = 0; i < length; i++)
     {
-        tmp = (data[i] << 8) | data24[i];
+        tmp = (data[i] << 8) | (data24 == nullptr ? 0 : data24[i]);
         if (tmp & 0x800000)
             tmp |= 0xff000000;
         fData[i] = Utils::int24ToFloat(tmp);
     }
-
-    delete [] data;
-    delete [] data24;
-    return FILE_OK;
 }
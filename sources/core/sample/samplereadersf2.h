@@ -39,6 +39,9 @@ public:
     // Get sample data
     SampleReaderResult getData(QFile &fi, QVector<float> &smpl) override;
 
+    // Convert the smpl and sm24 parts (data24 can be null) to float between -1 and 1
+    static void convert(const qint16 * data, const quint8 * data24, quint32 length, float * fData);
+
 private:
     InfoSound * _info;
 };
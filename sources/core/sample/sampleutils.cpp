@@ -23,7 +23,8 @@
 ***************************************************************************/
 
 #include "sampleutils.h"
-#include <QMessageBox>
+#include "firfilter.h"
+#include "resampler.h"
 
 SampleUtils::SampleUtils()
 {
@@ -32,82 +33,14 @@ SampleUtils::SampleUtils()
 
 QVector<float> SampleUtils::resampleMono(QVector<float> vData, double echInit, quint32 echFinal)
 {
-    // Paramètres
-    double alpha = 3;
-    qint32 nbPoints = 10;
-
-    // Préparation signal d'entrée
-    if (echFinal < echInit)
-    {
-        // Filtre passe bas (voir sinc filter)
-        vData = SampleUtils::bandFilter(vData, echInit, echFinal / 2, 0, -1);
-    }
+    // Polyphase filterbank, including the low-pass filter
+    Resampler resampler(echInit, echFinal);
     quint32 sizeInit = static_cast<quint32>(vData.size());
-    const float * dataF = vData.constData();
-
-    // Création fenêtre Kaiser-Bessel 2048 points
-    double kbdWindow[2048];
-    KBDWindow(kbdWindow, 2048, alpha);
-
-    // Nombre de points à trouver
-    quint32 sizeFinal = static_cast<quint32>(1. + (sizeInit - 1.0) * echFinal / echInit);
-    QVector<float> dataRet(sizeFinal);
-
-    // Calcul des points par interpolation à bande limitée
-    float pos, delta;
-    qint32 pos1, pos2;
-    float * sincCoef = new float[1 + 2 * static_cast<quint32>(nbPoints)];
-    float valMax = 0;
-    for (quint32 i = 0; i < sizeFinal; i++)
-    {
-        // Position à interpoler
-        pos = (echInit * i) / echFinal;
-
-        // Calcul des coefs
-        for (qint32 j = -nbPoints; j <= nbPoints; j++)
-        {
-            delta = pos - floor(pos);
-
-            // Calcul du sinus cardinal
-            sincCoef[j + nbPoints] = sinc(M_PI * (static_cast<double>(j) - delta));
-
-            // Application fenêtre
-            delta = static_cast<double>(j + nbPoints - delta) / (1 + 2 * nbPoints) * 2048;
-            pos1 = static_cast<qint32>(floor(delta) + .5);
-            if (pos1 < 0)
-                pos1 = 0;
-            else if (pos1 > 2047)
-                pos1 = 2047;
-            pos2 = static_cast<qint32>(ceil (delta) + .5);
-            if (pos2 < 0)
-                pos2 = 0;
-            else if (pos2 > 2047)
-                pos2 = 2047;
-
-            sincCoef[j + nbPoints] *= kbdWindow[pos1] * (ceil((delta)) - delta)
-                    + kbdWindow[pos2] * (1.f - ceil((delta)) + delta);
-        }
-
-        // Valeur
-        dataRet[i] = 0;
-        for (int j = qMax(0, static_cast<qint32>(pos) - nbPoints);
-             j <= qMin(static_cast<qint32>(sizeInit) - 1, static_cast<qint32>(pos) + nbPoints); j++)
-            dataRet[i] += sincCoef[j - static_cast<qint32>(pos) + nbPoints] * dataF[j];
-
-        valMax = qMax(valMax, qAbs(dataRet[i]));
-    }
-    delete [] sincCoef;
+    QVector<float> dataRet(static_cast<int>(resampler.getOutputSize(sizeInit)));
+    resampler.process(vData.constData(), sizeInit, dataRet.data(), 0, static_cast<quint32>(dataRet.size()));
 
     // Limitation si besoin
-    if (valMax > 1.0f)
-    {
-        float coef = 1.0f / valMax;
-        for (quint32 i = 0; i < sizeFinal; i++)
-            dataRet[i] *= coef;
-    }
-
-    // Filtre passe bas après resampling
-    dataRet = SampleUtils::bandFilter(dataRet, echFinal, echFinal / 2, 0, -1);
+    preventClipping(dataRet);
     return dataRet;
 }
 
@@ -135,18 +68,13 @@ QVector<float> SampleUtils::bandFilter(QVector<float> vData, double dwSmplRate,
         return vData;
     }
 
-    quint32 size;
-
-    // Conversion de baData en complexes
-    Complex * cpxData;
-    cpxData = fromFloatToComplex(vData, size);
-
-    // Calculer la fft du signal
-    Complex * fc_sortie_fft = FFT(cpxData, size);
-    delete [] cpxData;
+    // Gains of the filter
+    if (vData.isEmpty())
+        return vData;
+    quint32 size = getFilterDesignSize(vData.size());
+    QVector<float> gains(static_cast<int>(size / 2 + 1));
 
-    // Convoluer par le filtre Butterworth d'ordre 4, applique dans le sens direct et retrograde
-    // pour supprimer la phase (Hr4 * H4 = Gr4 * G4 = (G4)^2)
+    // Butterworth filter applied in both directions to remove the phase (Hr4 * H4 = Gr4 * G4 = (G4)^2)
     double d_gain_ph, d_gain_pb;
     if (fHaut <= 0)
     {
@@ -156,21 +84,19 @@ QVector<float> SampleUtils::bandFilter(QVector<float> vData, double dwSmplRate,
         if (ordre == -1)
         {
             // "Mur de brique"
-            for (unsigned long i = 0; i < (size + 1) / 2; i++)
+            for (int i = 0; i < gains.size(); i++)
             {
-                pos = static_cast<double>(i) / (size - 1);
-                fc_sortie_fft[i] *= (pos * dwSmplRate) < fBas;
-                fc_sortie_fft[size - 1 - i] *= (pos * dwSmplRate) < fBas;
+                pos = static_cast<double>(i) / size;
+                gains[i] = (pos * dwSmplRate) < fBas ? 1.0f : 0.0f;
             }
         }
         else
         {
-            for (unsigned long i = 0; i < (size + 1) / 2; i++)
+            for (int i = 0; i < gains.size(); i++)
             {
-                pos = static_cast<double>(i) / (size - 1);
+                pos = static_cast<double>(i) / size;
                 d_gain_pb = 1.0 / (1.0 + pow(pos * dwSmplRate / fBas, 2 * ordre));
-                fc_sortie_fft[i] *= d_gain_pb;
-                fc_sortie_fft[size - 1 - i] *= d_gain_pb;
+                gains[i] = static_cast<float>(d_gain_pb);
             }
         }
     }
@@ -182,21 +108,19 @@ QVector<float> SampleUtils::bandFilter(QVector<float> vData, double dwSmplRate,
         if (ordre == -1)
         {
             // "Mur de brique"
-            for (unsigned long i = 0; i < (size + 1) / 2; i++)
+            for (int i = 0; i < gains.size(); i++)
             {
-                pos = static_cast<double>(i) / (size - 1);
-                fc_sortie_fft[i] *= (pos * dwSmplRate) > fHaut;
-                fc_sortie_fft[size - 1 - i] *= (pos * dwSmplRate) > fHaut;
+                pos = static_cast<double>(i) / size;
+                gains[i] = (pos * dwSmplRate) > fHaut ? 1.0f : 0.0f;
             }
         }
         else
         {
-            for (unsigned long i = 0; i < (size + 1) / 2; i++)
+            for (int i = 0; i < gains.size(); i++)
             {
-                pos = static_cast<double>(i) / (size - 1);
+                pos = static_cast<double>(i) / size;
                 d_gain_ph = 1 - (1.0 / (1.0 + pow((pos * dwSmplRate) / fHaut, 2 * ordre)));
-                fc_sortie_fft[i] *= d_gain_ph;
-                fc_sortie_fft[size - 1 - i] *= d_gain_ph;
+                gains[i] = static_cast<float>(d_gain_ph);
             }
         }
     }
@@ -205,248 +129,177 @@ QVector<float> SampleUtils::bandFilter(QVector<float> vData, double dwSmplRate,
         double pos;
 
         // Filtre passe bande
-        for (unsigned long i = 0; i < (size+1)/2; i++)
+        for (int i = 0; i < gains.size(); i++)
         {
-            pos = static_cast<double>(i) / (size - 1);
+            pos = static_cast<double>(i) / size;
             d_gain_ph = 1 - (1.0 / (1.0 + pow((pos * dwSmplRate) / fHaut, 2 * ordre)));
             d_gain_pb = 1.0 / (1.0 + pow(pos * dwSmplRate / fBas, 2 * ordre));
-            fc_sortie_fft[i] *= d_gain_ph * d_gain_pb;
-            fc_sortie_fft[size-1-i] *= d_gain_ph * d_gain_pb;
+            gains[i] = static_cast<float>(d_gain_ph * d_gain_pb);
         }
     }
 
-    // Calculer l'ifft du signal
-    cpxData = IFFT(fc_sortie_fft, size);
-    delete [] fc_sortie_fft;
-    // Prise en compte du facteur d'echelle
-    for (unsigned long i = 0; i < size; i++)
-        cpxData[i].real(cpxData[i].real() / size);
-
-    // Retour en QByteArray
-    QVector<float> vRet = fromComplexToFloat(cpxData, vData.size());
-    delete [] cpxData;
-    return vRet;
+    // Filtering by blocks
+    return applyFilter(vData, gains);
 }
 
 QVector<float> SampleUtils::cutFilter(QVector<float> vData, quint32 dwSmplRate, QVector<float> dValues, int maxFreq)
 {
-    // Convert baData in complex
-    quint32 size;
-    Complex * cpxData = fromFloatToComplex(vData, size);
-
-    // Compute the fft
-    Complex * fc_sortie_fft = FFT(cpxData, size);
-    delete [] cpxData;
-
-    // Get the maximum module of the FFT
-    float moduleMax = 0;
-    for (unsigned long i = 0; i < (size + 1) / 2; i++)
-    {
-        // Left side
-        float module = sqrt(fc_sortie_fft[i].imag() * fc_sortie_fft[i].imag() +
-                             fc_sortie_fft[i].real() * fc_sortie_fft[i].real());
-        moduleMax = qMax(moduleMax, module);
-
-        // Right side
-        module = sqrt(fc_sortie_fft[size-1-i].imag() * fc_sortie_fft[size-1-i].imag() +
-                fc_sortie_fft[size-1-i].real() * fc_sortie_fft[size-1-i].real());
-        moduleMax = qMax(moduleMax, module);
-    }
-
-    // Cut the frequencies according to dValues (representing maximum intensities from minFreq to maxFreq)
+    // Short-time processing: frames weighted by a Hann window, overlapping by 75%
+    if (vData.isEmpty())
+        return vData;
+    FourierTransform fft(4096);
+    int frameSize = static_cast<int>(fft.size());
+    int hopSize = frameSize / 4;
+    QVector<float> window(frameSize);
+    for (int i = 0; i < frameSize; i++)
+        window[i] = static_cast<float>(0.5 - 0.5 * cos(2. * M_PI * i / frameSize));
+    QVector<float> frame(frameSize);
+    QVector<Complex> spectrum(static_cast<int>(fft.binCount()));
+
+    // Maximum intensity for each bin, relative to the maximum module
+    // (dValues represents maximum intensities from 0 to maxFreq)
     int nbValues = dValues.count();
-    for (unsigned long i = 0; i < (size + 1) / 2; i++)
+    QVector<float> limits(spectrum.size());
+    for (int i = 0; i < limits.size(); i++)
     {
-        // Current frequency and current module
-        float freq = static_cast<float>(dwSmplRate * i) / (size - 1);
-        float module1 = sqrt(fc_sortie_fft[i].imag() * fc_sortie_fft[i].imag() +
-                              fc_sortie_fft[i].real() * fc_sortie_fft[i].real());
-        float module2 = sqrt(fc_sortie_fft[size - 1 - i].imag() * fc_sortie_fft[size - 1 - i].imag() +
-                fc_sortie_fft[size - 1 - i].real() * fc_sortie_fft[size - 1 - i].real());
-
-        // Module max
-        float limit = moduleMax;
+        float freq = static_cast<float>(dwSmplRate) * i / frameSize;
         int index1 = static_cast<int>(freq / maxFreq * dValues.count());
         if (index1 >= nbValues - 1)
-            limit *= dValues[nbValues - 1];
+            limits[i] = dValues[nbValues - 1];
         else
         {
             float x1 = static_cast<float>(index1) / nbValues * maxFreq;
             float y1 = dValues[index1];
             float x2 = static_cast<float>(index1 + 1) / nbValues * maxFreq;
             float y2 = dValues[index1 + 1];
-            limit *= ((freq - x1) / (x2 - x1)) * (y2 - y1) + y1;
+            limits[i] = ((freq - x1) / (x2 - x1)) * (y2 - y1) + y1;
         }
+    }
 
-        // Cut the frequency if it's above the limit
-        if (module1 > limit)
-            fc_sortie_fft[i] *= limit / module1;
-        if (module2 > limit)
-            fc_sortie_fft[size - 1 - i] *= limit / module2;
+    // First pass: maximum module of all frames
+    float moduleMax = 0;
+    for (int frameStart = hopSize - frameSize; frameStart < vData.size(); frameStart += hopSize)
+    {
+        readFrame(vData, frameStart, window, frame);
+        fft.forward(frame.constData(), spectrum.data());
+        for (int i = 0; i < spectrum.size(); i++)
+            moduleMax = qMax(moduleMax, spectrum[i].abs());
     }
 
-    // Calculer l'ifft du signal
-    cpxData = IFFT(fc_sortie_fft, size);
-    delete [] fc_sortie_fft;
+    // Second pass: cut the frequencies above the limits and add the frames
+    // (the sum of the squared windows is 1.5 with this overlap)
+    QVector<float> vRet(vData.size(), 0);
+    for (int frameStart = hopSize - frameSize; frameStart < vData.size(); frameStart += hopSize)
+    {
+        readFrame(vData, frameStart, window, frame);
+        fft.forward(frame.constData(), spectrum.data());
+        for (int i = 0; i < spectrum.size(); i++)
+        {
+            float module = spectrum[i].abs();
+            float limit = moduleMax * limits[i];
+            if (module > limit)
+                spectrum[i] *= limit / module;
+        }
+        fft.inverse(spectrum.constData(), frame.data());
 
-    // Prise en compte du facteur d'echelle
-    for (unsigned long i = 0; i < size; i++)
-        cpxData[i].real(cpxData[i].real() / size);
+        for (int i = qMax(0, -frameStart); i < frameSize && frameStart + i < vRet.size(); i++)
+            vRet[frameStart + i] += frame[i] * window[i] / 1.5f;
+    }
 
-    // Retour en QByteArray
-    QVector<float> vRet = fromComplexToFloat(cpxData, vData.size());
-    delete [] cpxData;
+    preventClipping(vRet);
     return vRet;
 }
 
 QVector<float> SampleUtils::EQ(QVector<float> vData, quint32 dwSmplRate, QVector<int> eqGains)
 {
-    quint32 size;
-
-    // Conversion de baData en complexes
-    Complex * cpxData;
-    cpxData = fromFloatToComplex(vData, size);
-
-    // Calculer la fft du signal
-    Complex * fc_sortie_fft = FFT(cpxData, size);
-    delete [] cpxData;
-    // Filtrage
+    // Gains of the filter
+    if (vData.isEmpty())
+        return vData;
+    quint32 size = getFilterDesignSize(vData.size());
+    QVector<float> gains(static_cast<int>(size / 2 + 1));
     double freq;
-    double gain;
-    for (unsigned long i = 0; i < (size + 1) / 2; i++)
+    for (int i = 0; i < gains.size(); i++)
     {
-        freq = static_cast<double>(i * dwSmplRate) / (size - 1);
-        gain = gainEQ(freq, eqGains);
-        fc_sortie_fft[i] *= gain;
-        fc_sortie_fft[size - 1 - i] *= gain;
+        freq = static_cast<double>(i) * dwSmplRate / size;
+        gains[i] = static_cast<float>(gainEQ(freq, eqGains));
     }
 
-    // Calculer l'ifft du signal
-    cpxData = IFFT(fc_sortie_fft, size);
-    delete [] fc_sortie_fft;
+    // Filtering by blocks
+    return applyFilter(vData, gains);
+}
 
-    // Prise en compte du facteur d'echelle
-    for (unsigned long i = 0; i < size; i++)
-        cpxData[i].real(cpxData[i].real() / size);
+QVector<float> SampleUtils::getFourierTransform(QVector<float> input)
+{
+    // Module of the bins, from 0 to the Nyquist frequency (excluded)
+    FourierTransform fft(FourierTransform::getOptimalSize(static_cast<quint32>(input.size())));
+    QVector<Complex> spectrum = getSpectrum(input, fft);
+    QVector<float> vectFourier(static_cast<int>(fft.size() / 2));
+    for (int i = 0; i < vectFourier.size(); i++)
+        vectFourier[i] = spectrum[i].abs();
 
-    // Retour en QByteArray
-    QVector<float> vRet = fromComplexToFloat(cpxData, vData.size());
-    delete [] cpxData;
-    return vRet;
+    return vectFourier;
 }
 
-Complex * SampleUtils::FFT(Complex * x, quint32 N)
+QVector<Complex> SampleUtils::getSpectrum(QVector<float> vData, FourierTransform &fft)
 {
-    Complex* out = new Complex[N];
-    Complex* scratch = new Complex[N];
-    Complex* twiddles = new Complex [N];
-    quint32 k;
-    for (k = 0; k != N; ++k)
-    {
-        twiddles[k].real(cos(-2.0 * M_PI * k / N));
-        twiddles[k].imag(sin(-2.0 * M_PI * k / N));
-    }
-    FFT_calculate(x, N, out, scratch, twiddles);
-    delete [] twiddles;
-    delete [] scratch;
-    return out;
+    // The signal is completed with zeros
+    vData.resize(static_cast<int>(fft.size()));
+    QVector<Complex> spectrum(static_cast<int>(fft.binCount()));
+    fft.forward(vData.constData(), spectrum.data());
+    return spectrum;
 }
 
-Complex * SampleUtils::IFFT(Complex * x, quint32 N)
+quint32 SampleUtils::getFilterDesignSize(int signalSize)
 {
-    Complex * out = new Complex[N];
-    Complex * scratch = new Complex[N];
-    Complex * twiddles = new Complex [N];
-    quint32 k;
-    for (k = 0; k != N; ++k)
-    {
-        twiddles[k].real(cos(2.0 * M_PI * k / N));
-        twiddles[k].imag(sin(2.0 * M_PI * k / N));
-    }
-    FFT_calculate(x, N, out, scratch, twiddles);
-    delete [] twiddles;
-    delete [] scratch;
-    return out;
+    // The frequency resolution of the filters is the sample rate divided by this size (2.7 Hz at 44100 Hz)
+    // Short signals use a shorter filter
+    return qMin(static_cast<quint32>(16384), FourierTransform::getOptimalSize(static_cast<quint32>(qMax(2, 2 * signalSize))));
 }
 
-QVector<float> SampleUtils::getFourierTransform(QVector<float> input)
+QVector<float> SampleUtils::applyFilter(const QVector<float> &vData, const QVector<float> &gains)
 {
-    quint32 size = 0;
-    Complex * cpxData = fromFloatToComplex(input, size);
-    Complex * fc_sortie_fft = FFT(cpxData, size);
-    delete [] cpxData;
-    QVector<float> vectFourier;
-    vectFourier.resize(size / 2);
-    for (quint32 i = 0; i < size / 2; i++)
-    {
-        vectFourier[static_cast<int>(i)] =
-                static_cast<float>(0.5 * qSqrt(fc_sortie_fft[i].real() * fc_sortie_fft[i].real() +
-                                               fc_sortie_fft[i].imag() * fc_sortie_fft[i].imag()));
-        vectFourier[static_cast<int>(i)] +=
-                static_cast<float>(0.5 * qSqrt(fc_sortie_fft[size-i-1].real() * fc_sortie_fft[size-i-1].real() +
-                fc_sortie_fft[size-i-1].imag() * fc_sortie_fft[size-i-1].imag()));
-    }
-    delete [] fc_sortie_fft;
-
-    return vectFourier;
+    FirFilter filter(gains);
+    QVector<float> vRet(vData.size());
+    filter.process(vData.constData(), vRet.data(), static_cast<quint32>(vData.size()));
+    preventClipping(vRet);
+    return vRet;
 }
 
-Complex * SampleUtils::fromFloatToComplex(QVector<float> fData, quint32 &size)
+void SampleUtils::readFrame(const QVector<float> &vData, int frameStart, const QVector<float> &window, QVector<float> &frame)
 {
-    // Nombre de données (puissance de 2 la plus proche)
-    quint32 nb = static_cast<quint32>(ceil(qLn(fData.size()) / 0.69314718056));
-    size = 1;
-    for (quint32 i = 0; i < nb; i++)
-        size *= 2;
-
-    // Création et remplissage d'un tableau de complexes
-    Complex * cpxData = new Complex[size];
-
-    // Remplissage
-    for (int i = 0; i < fData.size(); i++)
+    // Values outside the signal are zeros
+    for (int i = 0; i < frame.size(); i++)
     {
-        cpxData[i].real(static_cast<double>(fData[i]));
-        cpxData[i].imag(0);
+        int pos = frameStart + i;
+        frame[i] = (pos >= 0 && pos < vData.size()) ? vData[pos] * window[i] : 0;
     }
-
-    // On complète avec des 0
-    for (quint32 i = static_cast<quint32>(fData.size()); i < size; i++)
-    {
-        cpxData[i].real(0);
-        cpxData[i].imag(0);
-    }
-
-    return cpxData;
 }
 
-QVector<float> SampleUtils::fromComplexToFloat(Complex * cpxData, int size)
+void SampleUtils::preventClipping(QVector<float> &vData)
 {
-    // Convert to real values
-    QVector<float> vRet(size);
-    float valMax = 0;
-    for (int i = 0; i < size; i++)
-    {
-        vRet[i] = cpxData[i].real();
-        valMax = qMax(valMax, qAbs(vRet[i]));
-    }
-
     // Possible attenuation
-    if (valMax > 1.0)
+    float valMax = 0;
+    for (int i = 0; i < vData.size(); i++)
+        valMax = qMax(valMax, qAbs(vData[i]));
+    if (valMax > 1.0f)
     {
-        double att = 1.0f / valMax;
-        for (int i = 0; i < size; i++)
-            vRet[i] *= att;
+        float att = 1.0f / valMax;
+        for (int i = 0; i < vData.size(); i++)
+            vData[i] *= att;
     }
-
-    return vRet;
 }
 
 QVector<float> SampleUtils::normalize(QVector<float> vData, float dVal, float &db)
+{
+    normalize(vData.data(), static_cast<quint32>(vData.size()), dVal, db);
+    return vData;
+}
+
+void SampleUtils::normalize(float * data, quint32 size, float dVal, float &db)
 {
     // Get the maximum value
-    float * data = vData.data();
     float valMax = 0;
-    for (int i = 0; i < vData.size(); i++)
+    for (quint32 i = 0; i < size; i++)
         valMax = qMax(valMax, qAbs(data[i]));
 
     // Compute the amplification
@@ -454,26 +307,32 @@ QVector<float> SampleUtils::normalize(QVector<float> vData, float dVal, float &d
     db = 20.0f * log10(mult);
 
     // Amplify
-    for (int i = 0; i < vData.size(); i++)
+    for (quint32 i = 0; i < size; i++)
         data[i] *= mult;
+}
 
+QVector<float> SampleUtils::multiply(QVector<float> vData, float dMult, float &db)
+{
+    multiply(vData.data(), static_cast<quint32>(vData.size()), dMult, db);
     return vData;
 }
 
-QVector<float> SampleUtils::multiply(QVector<float> vData, float dMult, float &db)
+void SampleUtils::multiply(float * data, quint32 size, float dMult, float &db)
 {
     // Compute the amplification
     db = 20.0f * log10(dMult);
 
     // Amplify
-    float * data = vData.data();
-    for (int i = 0; i < vData.size(); i++)
+    for (quint32 i = 0; i < size; i++)
         data[i] *= dMult;
+}
 
-    return vData;
+void SampleUtils::removeBlankStep1(const QVector<float> &vData, quint32 &pos1, quint32 &pos2)
+{
+    removeBlankStep1(vData.constData(), static_cast<quint32>(vData.size()), pos1, pos2);
 }
 
-void SampleUtils::removeBlankStep1(QVector<float> vData, quint32 &pos1, quint32 &pos2)
+void SampleUtils::removeBlankStep1(const float * data, quint32 size, quint32 &pos1, quint32 &pos2)
 {
     // Thresholds
     const float threshold1 = 0.0000005f;
@@ -483,10 +342,9 @@ void SampleUtils::removeBlankStep1(QVector<float> vData, quint32 &pos1, quint32
     pos1 = pos2 = 0;
     bool pos1Found = false;
     bool pos2Found = false;
-    quint32 size = static_cast<quint32>(vData.size());
     for (quint32 i = 0; i < size; i++)
     {
-        float value = vData.at(i);
+        float value = data[i];
         if (value < 0)
             value = -value;
         if (!pos1Found && value > threshold1)
@@ -512,20 +370,56 @@ QVector<float> SampleUtils::removeBlankStep2(QVector<float> vData, quint32 pos)
     return vData;
 }
 
-void SampleUtils::regimePermanent(QVector<float> fData, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd)
+void SampleUtils::regimePermanent(const QVector<float> &fData, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd)
 {
-    quint32 size = static_cast<quint32>(fData.size());
+    regimePermanent(fData.constData(), static_cast<quint32>(fData.size()), dwSmplRate, posStart, posEnd);
+}
+
+void SampleUtils::regimePermanent(const float * fData, quint32 size, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd)
+{
+    // Calcul de la moyenne des valeurs absolues sur une période de 0.1 s à chaque 20ième de seconde
+    quint32 sizePeriode = dwSmplRate / 10;
+    quint32 step = dwSmplRate / 20;
+    quint32 nbValeurs = (size < sizePeriode || step == 0) ? 0 : (size - sizePeriode) / step;
+    if (nbValeurs == 0)
+    {
+        // Take the full length of the sample
+        posStart = 0;
+        posEnd = (size == 0 ? 0 : size - 1);
+        return;
+    }
+
+    // Each window is the difference of two running sums, so that each value is read twice only
+    QVector<float> tableauMoyennes;
+    tableauMoyennes.resize(static_cast<int>(nbValeurs));
+    double sumBeforeStart = 0;
+    double sumBeforeEnd = 0;
+    quint32 posBeforeStart = 0;
+    quint32 posBeforeEnd = 0;
+    for (quint32 i = 0; i < nbValeurs; i++)
+    {
+        for (; posBeforeStart < step * i; posBeforeStart++)
+            sumBeforeStart += static_cast<double>(qAbs(fData[posBeforeStart]));
+        for (; posBeforeEnd < step * i + sizePeriode; posBeforeEnd++)
+            sumBeforeEnd += static_cast<double>(qAbs(fData[posBeforeEnd]));
+        tableauMoyennes[static_cast<int>(i)] = static_cast<float>((sumBeforeEnd - sumBeforeStart) / sizePeriode);
+    }
+
+    // Calcul de la médiane des valeurs
+    // (computed on a copy since the values are reordered)
+    QVector<float> tmp = tableauMoyennes;
+    float med = median(tmp.data(), nbValeurs);
 
     // Recherche fine
-    regimePermanent(fData, dwSmplRate, posStart, posEnd, 10, 1.05f);
+    regimePermanent(tableauMoyennes, med, step, sizePeriode, posStart, posEnd, 10, 1.05f);
     if (posEnd < size / 2 + posStart)
     {
         // Recherche grossière
-        regimePermanent(fData, dwSmplRate, posStart, posEnd, 7, 1.2f);
+        regimePermanent(tableauMoyennes, med, step, sizePeriode, posStart, posEnd, 7, 1.2f);
         if (posEnd < size / 2 + posStart)
         {
             // Recherche très grossière
-            regimePermanent(fData, dwSmplRate, posStart, posEnd, 4, 1.35f);
+            regimePermanent(tableauMoyennes, med, step, sizePeriode, posStart, posEnd, 4, 1.35f);
             if (posEnd < size / 2 + posStart)
             {
                 // moitié du milieu
@@ -555,18 +449,24 @@ QVector<float> SampleUtils::correlation(const float * fData, quint32 size, quint
         return vectCorrel;
     vectCorrel.resize(static_cast<int>(dMax - dMin + 1));
 
-    double qTmp;
-    float fTmp;
+    // Mesure de la ressemblance: sum((x[j] - x[j+i])^2) = sum(x[j]^2) + sum(x[j+i]^2) - 2 * sum(x[j] * x[j+i])
+    // The products come from a cross-correlation and the energies are running sums
+    quint32 length = size - dMax;
+    QVector<float> products(vectCorrel.size());
+    crossCorrelation(fData, length, &fData[dMin], dMax - dMin + 1, products.data());
+    double energy0 = 0;
+    double energyI = 0;
+    for (quint32 j = 0; j < length; j++)
+    {
+        energy0 += static_cast<double>(fData[j]) * fData[j];
+        energyI += static_cast<double>(fData[j + dMin]) * fData[j + dMin];
+    }
     for (quint32 i = dMin; i <= dMax; ++i)
     {
-        // Mesure de la ressemblance
-        qTmp = 0;
-        for (quint32 j = 0; j < size - dMax; j++)
-        {
-            fTmp = fData[j] - fData[j+i];
-            qTmp += static_cast<double>(fTmp * fTmp);
-        }
-        vectCorrel[static_cast<int>(i - dMin)] = static_cast<float>(qTmp / (size - dMax));
+        double qTmp = energy0 + energyI - 2.0 * products[static_cast<int>(i - dMin)];
+        vectCorrel[static_cast<int>(i - dMin)] = static_cast<float>(qMax(0.0, qTmp) / length);
+        if (i < dMax)
+            energyI += static_cast<double>(fData[i + length]) * fData[i + length] - static_cast<double>(fData[i]) * fData[i];
     }
 
     return vectCorrel;
@@ -620,25 +520,39 @@ bool SampleUtils::loopStep1(QVector<float> vData, quint32 dwSmplRate, quint32 &l
     float minCorValue;
     quint32 bestCorPos;
     {
-        float fTmp;
         quint32 nbCor = (loopEnd - posStart) / 2 - 2 * longueurSegmentB;
 
         if (nbCor == 0)
             return false;
 
         const float * pointerSegB = segmentB.constData();
-        const float * pointerData = vData.constData();
+        const float * pointerData = &vData.constData()[longueurSegmentB + posStart];
+
+        // Products of segment B with all positions, the energies being running sums
+        QVector<float> products(static_cast<int>(nbCor));
+        crossCorrelation(pointerSegB, longueurSegmentB, pointerData, nbCor, products.data());
+        double energySegB = 0;
+        double energyData = 0;
+        for (quint32 j = 0; j < longueurSegmentB; j++)
+        {
+            energySegB += static_cast<double>(pointerSegB[j]) * pointerSegB[j];
+            energyData += static_cast<double>(pointerData[j]) * pointerData[j];
+        }
 
-        minCorValue = correlation(pointerSegB, &pointerData[longueurSegmentB + posStart], longueurSegmentB, nullptr);
+        minCorValue = 0;
         bestCorPos = 0;
-        for (quint32 i = 1; i < nbCor; ++i)
+        for (quint32 i = 0; i < nbCor; ++i)
         {
-            fTmp = correlation(pointerSegB, &pointerData[longueurSegmentB + posStart + i], longueurSegmentB, &minCorValue);
-            if (fTmp < minCorValue)
+            float fTmp = static_cast<float>(qMax(0.0, energySegB + energyData - 2.0 * products[static_cast<int>(i)]) /
+                    longueurSegmentB);
+            if (i == 0 || fTmp < minCorValue)
             {
                 minCorValue = fTmp;
                 bestCorPos = i;
             }
+            if (i + 1 < nbCor)
+                energyData += static_cast<double>(pointerData[i + longueurSegmentB]) * pointerData[i + longueurSegmentB] -
+                        static_cast<double>(pointerData[i]) * pointerData[i];
         }
     }
 
@@ -652,10 +566,49 @@ bool SampleUtils::loopStep1(QVector<float> vData, quint32 dwSmplRate, quint32 &l
     return true;
 }
 
+void SampleUtils::crossCorrelation(const float * pattern, quint32 patternSize, const float * data, quint32 count, float * result)
+{
+    // result[i] = sum(pattern[j] * data[i + j]), computed by blocks (overlap-save)
+    // "count + patternSize - 1" values are read in data
+    FourierTransform fft(FourierTransform::getOptimalSize(qMax(4 * patternSize, 4096u)));
+    quint32 fftSize = fft.size();
+    if (patternSize == 0 || patternSize > fftSize)
+        return; // The hop size would exceed the block
+    quint32 hopSize = fftSize - patternSize + 1;
+    quint32 dataSize = count + patternSize - 1;
+    QVector<float> block(static_cast<int>(fftSize));
+    QVector<Complex> patternSpectrum(static_cast<int>(fft.binCount()));
+    QVector<Complex> spectrum(static_cast<int>(fft.binCount()));
+
+    // Conjugated spectrum of the pattern
+    for (quint32 i = 0; i < fftSize; i++)
+        block[static_cast<int>(i)] = i < patternSize ? pattern[i] : 0;
+    fft.forward(block.constData(), patternSpectrum.data());
+    for (int i = 0; i < patternSpectrum.size(); i++)
+        patternSpectrum[i] = patternSpectrum[i].conj();
+
+    for (quint32 blockStart = 0; blockStart < count; blockStart += hopSize)
+    {
+        for (quint32 i = 0; i < fftSize; i++)
+            block[static_cast<int>(i)] = blockStart + i < dataSize ? data[blockStart + i] : 0;
+        fft.forward(block.constData(), spectrum.data());
+        for (int i = 0; i < spectrum.size(); i++)
+            spectrum[i] = spectrum[i] * patternSpectrum[i];
+        fft.inverse(spectrum.constData(), block.data());
+
+        // The first "hopSize" values are not affected by the wrapping
+        for (quint32 i = 0; i < hopSize && blockStart + i < count; i++)
+            result[blockStart + i] = block[static_cast<int>(i)];
+    }
+}
+
 QVector<float> SampleUtils::loopStep2(QVector<float> vData, quint32 loopStart, quint32 loopEnd, quint32 loopCrossfadeLength)
 {
-    // Loop with a crossfade
+    // Coupure et ajout de 8 valeurs
+    vData.resize(static_cast<int>(loopEnd + 8));
     float * fData = vData.data();
+
+    // Loop with a crossfade
     float dTmp;
     for (quint32 i = 0; i < loopCrossfadeLength; i++)
     {
@@ -665,21 +618,26 @@ QVector<float> SampleUtils::loopStep2(QVector<float> vData, quint32 loopStart, q
                 dTmp * fData[loopStart - loopCrossfadeLength + i];
     }
 
-    // Coupure et ajout de 8 valeurs
-    vData.resize(loopEnd + 8);
+    // Values after the end of the loop
     for (quint32 i = 0; i < 8; i++)
-        vData[loopEnd + i] = fData[loopStart + i];
+        fData[loopEnd + i] = fData[loopStart + i];
+
     return vData;
 }
 
-QList<quint32> SampleUtils::findMins(QVector<float> vectData, int maxNb, float minFrac)
+QList<quint32> SampleUtils::findMins(const QVector<float> &vectData, int maxNb, float minFrac)
 {
-    if (vectData.isEmpty())
+    return findMins(vectData.constData(), static_cast<quint32>(vectData.size()), maxNb, minFrac);
+}
+
+QList<quint32> SampleUtils::findMins(const float * vectData, quint32 size, int maxNb, float minFrac)
+{
+    if (size == 0)
         return QList<quint32>();
 
     // Calcul mini maxi
     float mini = vectData[0], maxi = vectData[0];
-    for (qint32 i = 1; i < vectData.size(); i++)
+    for (quint32 i = 1; i < size; i++)
     {
         if (vectData[i] < mini)
             mini = vectData[i];
@@ -692,9 +650,9 @@ QList<quint32> SampleUtils::findMins(QVector<float> vectData, int maxNb, float m
 
     // Recherche des indices de tous les creux
     QMap<quint32, float> mapCreux;
-    for (int i = 1; i < vectData.size() - 1; i++)
+    for (quint32 i = 1; i + 1 < size; i++)
         if (vectData[i-1] > vectData[i] && vectData[i+1] > vectData[i] && vectData[i] < valMax)
-            mapCreux[static_cast<quint32>(i)] = vectData[i];
+            mapCreux[i] = vectData[i];
 
     // Sélection des plus petits creux
     QList<float> listCreux = mapCreux.values();
@@ -706,14 +664,19 @@ QList<quint32> SampleUtils::findMins(QVector<float> vectData, int maxNb, float m
     return listRet;
 }
 
-QList<quint32> SampleUtils::findMax(QVector<float> vectData, int maxNb, float minFrac)
+QList<quint32> SampleUtils::findMax(const QVector<float> &vectData, int maxNb, float minFrac)
+{
+    return findMax(vectData.constData(), static_cast<quint32>(vectData.size()), maxNb, minFrac);
+}
+
+QList<quint32> SampleUtils::findMax(const float * vectData, quint32 size, int maxNb, float minFrac)
 {
-    if (vectData.isEmpty())
+    if (size == 0)
         return QList<quint32>();
 
     // Calcul mini maxi
     float mini = vectData[0], maxi = vectData[0];
-    for (qint32 i = 1; i < vectData.size(); i++)
+    for (quint32 i = 1; i < size; i++)
     {
         if (vectData[i] < mini)
             mini = vectData[i];
@@ -725,8 +688,8 @@ QList<quint32> SampleUtils::findMax(QVector<float> vectData, int maxNb, float mi
     float valMin = mini + minFrac * (maxi - mini);
 
     // Recherche des indices de tous les pics
-    QMap<int, float> mapPics;
-    for (int i = 1; i < vectData.size() - 1; i++)
+    QMap<quint32, float> mapPics;
+    for (quint32 i = 1; i + 1 < size; i++)
         if (vectData[i-1] < vectData[i] && vectData[i+1] < vectData[i] && vectData[i] > valMin)
             mapPics[i] = vectData[i];
 
@@ -735,16 +698,22 @@ QList<quint32> SampleUtils::findMax(QVector<float> vectData, int maxNb, float mi
     std::sort(listPics.begin(), listPics.end());
     QList<quint32> listRet;
     for (int i = listPics.size() - 1; i >= qMax(0, listPics.size() - maxNb); i--)
-        listRet << static_cast<quint32>(mapPics.key(listPics.at(i)));
+        listRet << mapPics.key(listPics.at(i));
 
     return listRet;
 }
 
-float SampleUtils::max(QVector<float> vData)
+float SampleUtils::max(const QVector<float> &vData)
+{
+    return max(vData.constData(), static_cast<quint32>(vData.size()));
+}
+
+float SampleUtils::max(const float * data, quint32 size)
 {
-    const float * data = vData.constData();
-    qint32 maxi = data[0];
-    for (int i = 1; i < vData.size(); i++)
+    if (size == 0)
+        return 0;
+    float maxi = data[0];
+    for (quint32 i = 1; i < size; i++)
         if (data[i] > maxi)
             maxi = data[i];
     return maxi;
@@ -793,70 +762,27 @@ int SampleUtils::lastLettersToRemove(QString str1, QString str2)
 
 // UTILITAIRES, PARTIE PRIVEE
 
-void SampleUtils::FFT_calculate(Complex * x, quint32 N /* must be a power of 2 */,
-                                Complex * X, Complex * scratch, Complex * twiddles)
+float SampleUtils::mean(const float * data, quint32 size)
 {
-    quint32 k, m, n, skip;
-    bool evenIteration = N & 0x55555555;
-    Complex* E;
-    Complex* Xp, * Xp2, * Xstart;
-    if (N == 1)
-    {
-        X[0] = x[0];
-        return;
-    }
-    E = x;
-    for (n = 1; n < N; n *= 2)
-    {
-        Xstart = evenIteration? scratch : X;
-        skip = N / (2 * n);
-        /* each of D and E is of length n, and each element of each D and E is
-        separated by 2*skip. The Es begin at E[0] to E[skip - 1] and the Ds
-        begin at E[skip] to E[2*skip - 1] */
-        Xp = Xstart;
-        Xp2 = Xstart + N / 2;
-        for (k = 0; k != n; k++)
-        {
-            double tim = twiddles[k * skip].imag();
-            double tre = twiddles[k * skip].real();
-            for (m = 0; m != skip; ++m)
-            {
-                Complex* D = E + skip;
-                /* twiddle *D to get dre and dim */
-                double dre = D->real() * tre - D->imag() * tim;
-                double dim = D->real() * tim + D->imag() * tre;
-                Xp->real(E->real() + dre);
-                Xp->imag(E->imag() + dim);
-                Xp2->real(E->real() - dre);
-                Xp2->imag(E->imag() - dim);
-                ++Xp;
-                ++Xp2;
-                ++E;
-            }
-            E += skip;
-        }
-        E = Xstart;
-        evenIteration = !evenIteration;
-    }
+    if (size > 0)
+        return sum(data, size) / size;
+    else
+        return 0;
 }
 
-float SampleUtils::mean(QVector<float> vData)
+float SampleUtils::meanSquare(const QVector<float> &vData)
 {
-    if (vData.size() > 0)
-        return sum(vData) / vData.size();
-    else
-        return 0;
+    return meanSquare(vData.constData(), static_cast<quint32>(vData.size()));
 }
 
-float SampleUtils::meanSquare(QVector<float> vData)
+float SampleUtils::meanSquare(const float * data, quint32 size)
 {
-    return qSqrt(sumSquare(vData)) / vData.size();
+    return qSqrt(sumSquare(data, size)) / size;
 }
 
-float SampleUtils::median(QVector<float> vData)
+float SampleUtils::median(float * arr, quint32 size)
 {
-    float * arr = vData.data();
-    qint32 n = vData.size();
+    qint32 n = static_cast<qint32>(size);
     qint32 low, high;
     qint32 median;
     qint32 middle, ll, hh;
@@ -931,20 +857,37 @@ float SampleUtils::median(QVector<float> vData)
     }
 }
 
-float SampleUtils::sum(QVector<float> vData)
+float SampleUtils::sum(const float * data, quint32 size)
 {
-    float result = 0;
-    for (int i = 0; i < vData.size(); i++)
-        result += vData.at(i);
-    return result;
+    // Independent partial sums, so that the additions can be pipelined
+    double result[4] = {0, 0, 0, 0};
+    quint32 i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        result[0] += static_cast<double>(data[i]);
+        result[1] += static_cast<double>(data[i + 1]);
+        result[2] += static_cast<double>(data[i + 2]);
+        result[3] += static_cast<double>(data[i + 3]);
+    }
+    for (; i < size; i++)
+        result[0] += static_cast<double>(data[i]);
+    return static_cast<float>((result[0] + result[1]) + (result[2] + result[3]));
 }
 
-float SampleUtils::sumSquare(QVector<float> vData)
+float SampleUtils::sumSquare(const float * data, quint32 size)
 {
-    float result = 0;
-    for (int i = 0; i < vData.size(); i++)
-        result += vData.at(i) * vData.at(i);
-    return result;
+    double result[4] = {0, 0, 0, 0};
+    quint32 i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        result[0] += static_cast<double>(data[i] * data[i]);
+        result[1] += static_cast<double>(data[i + 1] * data[i + 1]);
+        result[2] += static_cast<double>(data[i + 2] * data[i + 2]);
+        result[3] += static_cast<double>(data[i + 3] * data[i + 3]);
+    }
+    for (; i < size; i++)
+        result[0] += static_cast<double>(data[i] * data[i]);
+    return static_cast<float>((result[0] + result[1]) + (result[2] + result[3]));
 }
 
 double SampleUtils::gainEQ(double freq, QVector<int> eqGains)
@@ -1018,44 +961,15 @@ double SampleUtils::gainEQ(double freq, QVector<int> eqGains)
     return pow(10.0, 0.1 * val);
 }
 
-void SampleUtils::regimePermanent(QVector<float> data, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd, quint32 nbOK, float coef)
+void SampleUtils::regimePermanent(const QVector<float> &means, float med, quint32 step, quint32 sizePeriode, quint32 &posStart, quint32 &posEnd, quint32 nbOK, float coef)
 {
-    // Calcul de la moyenne des valeurs absolues sur une période de 0.05 s à chaque 10ième de seconde
-    quint32 sizePeriode = dwSmplRate / 10;
-    quint32 len = static_cast<quint32>(data.size());
-    if (len < sizePeriode)
-    {
-        // Take the full length of the sample
-        posStart = 0;
-        posEnd = (len == 0 ? 0 : len - 1);
-        return;
-    }
-    quint32 nbValeurs = (len - sizePeriode) / (dwSmplRate / 20);
-    if (nbValeurs == 0)
-    {
-        // Take also the full length of the sample
-        posStart = 0;
-        posEnd = (len == 0 ? 0 : len - 1);
-        return;
-    }
-    QVector<float> tableauMoyennes;
-    tableauMoyennes.resize(static_cast<int>(nbValeurs));
-    for (quint32 i = 0; i < nbValeurs; i++)
-    {
-        float valTmp = 0;
-        for (quint32 j = 0; j < sizePeriode; j++)
-            valTmp += qAbs(data[static_cast<int>((dwSmplRate / 20) * i + j)]);
-        data[static_cast<int>(i)] = valTmp / sizePeriode;
-    }
-
-    // Calcul de la médiane des valeurs
-    float med = median(tableauMoyennes);
+    quint32 nbValeurs = static_cast<quint32>(means.size());
     posStart = 0;
     posEnd = nbValeurs - 1;
     quint32 count = 0;
     while (count < nbOK && posStart <= posEnd)
     {
-        if (data[static_cast<int>(posStart)] < coef * med && data[static_cast<int>(posStart)] > med / coef)
+        if (means[static_cast<int>(posStart)] < coef * med && means[static_cast<int>(posStart)] > med / coef)
             count++;
         else
             count = 0;
@@ -1065,7 +979,7 @@ void SampleUtils::regimePermanent(QVector<float> data, quint32 dwSmplRate, quint
     count = 0;
     while (count < nbOK && posEnd > 0)
     {
-        if (data[static_cast<int>(posEnd)] < coef * med && data[static_cast<int>(posEnd)] > med / coef)
+        if (means[static_cast<int>(posEnd)] < coef * med && means[static_cast<int>(posEnd)] > med / coef)
             count++;
         else
             count = 0;
@@ -1074,94 +988,18 @@ void SampleUtils::regimePermanent(QVector<float> data, quint32 dwSmplRate, quint
     posEnd += count-2;
 
     // Conversion position
-    posStart *= dwSmplRate / 20;
-    posEnd *= dwSmplRate / 20;
+    posStart *= step;
+    posEnd *= step;
     posEnd += sizePeriode;
 }
 
-double SampleUtils::sinc(double x)
+float SampleUtils::computeLoopQuality(const QVector<float> &vData, quint32 loopStart, quint32 loopEnd)
 {
-    double epsilon0 = 0.32927225399135962333569506281281311031656150598474e-9L;
-    double epsilon2 = qSqrt(epsilon0);
-    double epsilon4 = qSqrt(epsilon2);
-
-    if (qAbs(x) >= epsilon4)
-        return(qSin(x)/x);
-    else
-    {
-        // x très proche de 0, développement limité ordre 0
-        double result = 1;
-        if (qAbs(x) >= epsilon0)
-        {
-            double x2 = x*x;
-
-            // x un peu plus loin de 0, développement limité ordre 2
-            result -= x2 / 6.;
-
-            if (qAbs(x) >= epsilon2)
-            {
-                // x encore plus loin de 0, développement limité ordre 4
-                result += (x2 * x2) / 120.;
-            }
-        }
-        return(result);
-    }
-}
-
-// Keser-Bessel window
-void SampleUtils::KBDWindow(double* window, int size, double alpha)
-{
-    double sumvalue = 0.;
-    int i;
-
-    for (i = 0; i < size/2; i++)
-    {
-        sumvalue += BesselI0(M_PI * alpha * sqrt(1. - pow(4.0*i/size - 1., 2)));
-        window[i] = sumvalue;
-    }
-
-    // need to add one more value to the nomalization factor at size/2:
-    sumvalue += BesselI0(M_PI * alpha * sqrt(1. - pow(4.0*(size/2) / size-1., 2)));
-
-    // normalize the window and fill in the righthand side of the window:
-    for (i = 0; i < size/2; i++)
-    {
-        window[i] = sqrt(window[i]/sumvalue);
-        window[size-1-i] = window[i];
-    }
-}
-
-double SampleUtils::BesselI0(double x)
-{
-    double denominator;
-    double numerator;
-    double z;
-
-    if (x == 0.0)
-        return 1.0;
-    else
-    {
-        z = x * x;
-        numerator = (z* (z* (z* (z* (z* (z* (z* (z* (z* (z* (z* (z* (z*
-                                                                     (z* 0.210580722890567e-22  + 0.380715242345326e-19 ) +
-                                                                     0.479440257548300e-16) + 0.435125971262668e-13 ) +
-                                                             0.300931127112960e-10) + 0.160224679395361e-7  ) +
-                                                     0.654858370096785e-5)  + 0.202591084143397e-2  ) +
-                                             0.463076284721000e0)   + 0.754337328948189e2   ) +
-                                     0.830792541809429e4)   + 0.571661130563785e6   ) +
-                             0.216415572361227e8)   + 0.356644482244025e9   ) +
-                     0.144048298227235e10);
-        denominator = (z*(z*(z-0.307646912682801e4)+
-                          0.347626332405882e7)-0.144048298227235e10);
-    }
-
-    return -numerator/denominator;
+    return computeLoopQuality(vData.constData(), static_cast<quint32>(vData.size()), loopStart, loopEnd);
 }
 
-float SampleUtils::computeLoopQuality(QVector<float> vData, quint32 loopStart, quint32 loopEnd)
+float SampleUtils::computeLoopQuality(const float * data, quint32 length, quint32 loopStart, quint32 loopEnd)
 {
-    const float * data = vData.constData();
-    quint32 length = vData.size();
     if (loopStart < 2 || loopStart >= loopEnd || loopEnd >= length)
         return 0;
 
@@ -26,6 +26,7 @@
 #define SAMPLEUTILS_H
 
 #include "basetypes.h"
+#include "fouriertransform.h"
 
 class SampleUtils
 {
@@ -36,43 +37,55 @@ public:
     static QVector<float> bandFilter(QVector<float> vData, double dwSmplRate, double fBas, double fHaut, int ordre);
     static QVector<float> cutFilter(QVector<float> vData, quint32 dwSmplRate, QVector<float> dValues, int maxFreq);
     static QVector<float> EQ(QVector<float> vData, quint32 dwSmplRate, QVector<int> eqGains);
-    static Complex * fromFloatToComplex(QVector<float> fData, quint32 &size);
-    static QVector<float> fromComplexToFloat(Complex * cpxData, int size);
     static QVector<float> getFourierTransform(QVector<float> input);
     static QVector<float> normalize(QVector<float> vData, float dVal, float &db);
     static QVector<float> multiply(QVector<float> vData, float dMult, float &db);
-    static void removeBlankStep1(QVector<float> vData, quint32 &pos1, quint32 &pos2);
+    static void removeBlankStep1(const QVector<float> &vData, quint32 &pos1, quint32 &pos2);
     static QVector<float> removeBlankStep2(QVector<float> vData, quint32 pos);
-    static void regimePermanent(QVector<float> fData, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd);
+    static void regimePermanent(const QVector<float> &fData, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd);
     static QVector<float> correlation(const float *fData, quint32 size, quint32 dwSmplRate, quint32 fMin, quint32 fMax, quint32 &dMin);
     static float correlation(const float *fData1, const float *fData2, quint32 length, float *bestValue);
+
+    // Products of a pattern with the data at "count" successive positions: result[i] = sum(pattern[j] * data[i + j])
+    // "count + patternSize - 1" values are read in data, nothing is written in result if the pattern is empty
+    static void crossCorrelation(const float * pattern, quint32 patternSize, const float * data, quint32 count, float * result);
     static bool loopStep1(QVector<float> vData, quint32 dwSmplRate, quint32 &loopStart, quint32 &loopEnd, quint32 &loopCrossfadeLength);
     static QVector<float> loopStep2(QVector<float> vData, quint32 loopStart, quint32 loopEnd, quint32 loopCrossfadeLength);
-    static QList<quint32> findMins(QVector<float> vectData, int maxNb, float minFrac = 0);
-    static QList<quint32> findMax(QVector<float> vectData, int maxNb, float minFrac = 0);
-    static float max(QVector<float> vData);
-    static float meanSquare(QVector<float> vData);
+    static QList<quint32> findMins(const QVector<float> &vectData, int maxNb, float minFrac = 0);
+    static QList<quint32> findMax(const QVector<float> &vectData, int maxNb, float minFrac = 0);
+    static float max(const QVector<float> &vData);
+    static float meanSquare(const QVector<float> &vData);
     static int lastLettersToRemove(QString str1, QString str2);
 
     // Compute the quality of a loop
     // If the result if < 0.05 it can be considered as OK
     // If > 0.150 => you will probably hear the loop point
-    static float computeLoopQuality(QVector<float> vData, quint32 loopStart, quint32 loopEnd);
+    static float computeLoopQuality(const QVector<float> &vData, quint32 loopStart, quint32 loopEnd);
+
+    // Same functions working on spans, without copying the data
+    // The functions having a non-const pointer modify the data in place
+    static void normalize(float * data, quint32 size, float dVal, float &db);
+    static void multiply(float * data, quint32 size, float dMult, float &db);
+    static void removeBlankStep1(const float * data, quint32 size, quint32 &pos1, quint32 &pos2);
+    static void regimePermanent(const float * fData, quint32 size, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd);
+    static QList<quint32> findMins(const float * vectData, quint32 size, int maxNb, float minFrac = 0);
+    static QList<quint32> findMax(const float * vectData, quint32 size, int maxNb, float minFrac = 0);
+    static float max(const float * data, quint32 size);
+    static float meanSquare(const float * data, quint32 size);
+    static float computeLoopQuality(const float * data, quint32 length, quint32 loopStart, quint32 loopEnd);
 
 private:
-    static void FFT_calculate(Complex * x, quint32 N /* must be a power of 2 */,
-                              Complex * X, Complex * scratch, Complex * twiddles);
-    static float mean(QVector<float> vData);
+    static QVector<Complex> getSpectrum(QVector<float> vData, FourierTransform &fft);
+    static quint32 getFilterDesignSize(int signalSize);
+    static QVector<float> applyFilter(const QVector<float> &vData, const QVector<float> &gains);
+    static void readFrame(const QVector<float> &vData, int frameStart, const QVector<float> &window, QVector<float> &frame);
+    static void preventClipping(QVector<float> &vData);
+    static float mean(const float * data, quint32 size);
     static double gainEQ(double freq, QVector<int> eqGains);
-    static float median(QVector<float> vData);
-    static float sum(QVector<float> vData);
-    static float sumSquare(QVector<float> vData);
-    static void regimePermanent(QVector<float> data, quint32 dwSmplRate, quint32 &posStart, quint32 &posEnd, quint32 nbOK, float coef);
-    static double sinc(double x);
-    static void KBDWindow(double* window, int size, double alpha);
-    static double BesselI0(double x);
-    static Complex * FFT(Complex * x, quint32 N); // N must be a power of 2
-    static Complex * IFFT(Complex * x, quint32 N); // N must be a power of 2
+    static float median(float * arr, quint32 size); // The values are reordered
+    static float sum(const float * data, quint32 size);
+    static float sumSquare(const float * data, quint32 size);
+    static void regimePermanent(const QVector<float> &means, float med, quint32 step, quint32 sizePeriode, quint32 &posStart, quint32 &posEnd, quint32 nbOK, float coef);
     static float getDiffForLoopQuality(const float *data, quint32 pos1, quint32 pos2);
 };
 
@@ -132,10 +132,11 @@ void SampleWriterWav::write(QByteArray &baData, InfoSound &info)
 
     bool withLoop = !info.loops.empty();
 
-    // Ecriture
+    // Ecriture (the header is prepared in memory)
     quint32 dwTemp;
     quint16 wTemp;
-    QDataStream out(&fi);
+    QByteArray header;
+    QDataStream out(&header, QIODevice::WriteOnly);
     out.setByteOrder(QDataStream::LittleEndian);
     quint32 dwTailleFmt = 18;
     quint32 dwTailleSmpl = 36;
@@ -234,24 +235,26 @@ void SampleWriterWav::write(QByteArray &baData, InfoSound &info)
     ///////////// BLOC DATA /////////////
     out.writeRawData("data", 4);
     out << dwLength;
-    out.writeRawData(baData.constData(), baData.size());
+    fi.write(header);
+    fi.write(baData);
 
     // Fermeture du fichier
     fi.close();
 }
 
-void SampleWriterWav::convertTo16bit(QVector<float> dataSrc, QByteArray &dataDest)
+void SampleWriterWav::convertTo16bit(const QVector<float> &dataSrc, QByteArray &dataDest)
 {
     const float * data = dataSrc.constData();
     int length = dataSrc.size();
 
     dataDest.resize(2 * length);
     qint16 * data16 = reinterpret_cast<qint16 *>(dataDest.data());
+
     for (int i = 0; i < length; i++)
-        data16[i] = (Utils::floatToInt24(data[i]) >> 8);
+        data16[i] = static_cast<qint16>(Utils::floatToInt24Vectorizable(data[i]) >> 8);
 }
 
-void SampleWriterWav::convertTo24bit(QVector<float> dataSrc, QByteArray &dataDest)
+void SampleWriterWav::convertTo24bit(const QVector<float> &dataSrc, QByteArray &dataDest)
 {
     const float * data = dataSrc.constData();
     int length = dataSrc.size();
@@ -260,7 +263,7 @@ void SampleWriterWav::convertTo24bit(QVector<float> dataSrc, QByteArray &dataDes
     char * dataChar = dataDest.data();
     for (int i = 0; i < length; i++)
     {
-        qint32 tmp = Utils::floatToInt24(data[i]);
+        qint32 tmp = Utils::floatToInt24Vectorizable(data[i]);
         dataChar[3 * i] = tmp & 0xFF;
         dataChar[3 * i + 1] = (tmp >> 8) & 0xFF;
         dataChar[3 * i + 2] = tmp >> 16;
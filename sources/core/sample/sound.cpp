@@ -26,11 +26,16 @@
 #include <QFileInfo>
 #include "samplereader.h"
 #include "samplereaderfactory.h"
+#include "sampleutils.h"
 
 Sound::Sound() :
     _fileName(""),
     _error(""),
-    _reader(nullptr)
+    _reader(nullptr),
+    _isDataModified(false),
+    _isSteadyStateComputed(false),
+    _steadyStart(0),
+    _steadyEnd(0)
 {
     // Initialize data
     _smpl.clear();
@@ -43,7 +48,10 @@ Sound::~Sound()
 
 bool Sound::setFileName(QString qStr, bool tryFindRootKey)
 {
+    QMutexLocker locker(&_mutex);
     _fileName = qStr;
+    _isDataModified = false;
+    _isSteadyStateComputed = false;
     bool isOk = false;
 
     // Initialize the reader
@@ -83,12 +91,38 @@ bool Sound::setFileName(QString qStr, bool tryFindRootKey)
     return isOk;
 }
 
+InfoSound Sound::getInfo()
+{
+    QMutexLocker locker(&_mutex);
+    return _info;
+}
+
+QString Sound::getError()
+{
+    QMutexLocker locker(&_mutex);
+    return _error;
+}
+
+QString Sound::getFileName()
+{
+    QMutexLocker locker(&_mutex);
+    return _fileName;
+}
+
+bool Sound::isDataModified()
+{
+    QMutexLocker locker(&_mutex);
+    return _isDataModified;
+}
+
 QVector<float> Sound::getData(bool forceReload)
 {
+    QMutexLocker locker(&_mutex);
     if (_reader != nullptr)
     {
         if (forceReload)
         {
+            _isSteadyStateComputed = false;
             _smpl.clear();
             _reader->getInfo(_info);
         }
@@ -102,6 +136,7 @@ QVector<float> Sound::getData(bool forceReload)
 
 quint32 Sound::getUInt32(AttributeType champ)
 {
+    QMutexLocker locker(&_mutex);
     quint32 result = 0;
     switch (champ)
     {
@@ -146,6 +181,7 @@ quint32 Sound::getUInt32(AttributeType champ)
 
 qint32 Sound::getInt32(AttributeType champ)
 {
+    QMutexLocker locker(&_mutex);
     qint32 result = 0;
     switch (champ)
     {
@@ -158,14 +194,54 @@ qint32 Sound::getInt32(AttributeType champ)
     return result;
 }
 
+qint64 Sound::getMemorySize()
+{
+    QMutexLocker locker(&_mutex);
+    return static_cast<qint64>(_smpl.size()) * static_cast<qint64>(sizeof(float));
+}
+
 void Sound::setData(QVector<float> data)
 {
+    QMutexLocker locker(&_mutex);
     _smpl = data;
     _info.dwLength = data.size();
+    _isDataModified = true;
+    _isSteadyStateComputed = false;
+}
+
+float * Sound::editData(QVector<float> &previousData)
+{
+    // No other thread can read the data until the modification is over
+    _mutex.lock();
+    previousData = this->getData();
+    _isDataModified = true;
+    return _smpl.data(); // Copy of the previous version, that is shared
+}
+
+void Sound::endEditData()
+{
+    // The analysis is reset once the data has its final values
+    // (a steady state computed during the modification would be wrong)
+    _isSteadyStateComputed = false;
+    _mutex.unlock();
+}
+
+void Sound::getSteadyState(quint32 &posStart, quint32 &posEnd)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_isSteadyStateComputed)
+    {
+        this->getData();
+        SampleUtils::regimePermanent(_smpl, _info.dwSampleRate, _steadyStart, _steadyEnd);
+        _isSteadyStateComputed = true;
+    }
+    posStart = _steadyStart;
+    posEnd = _steadyEnd;
 }
 
 void Sound::set(AttributeType champ, AttributeValue value)
 {
+    QMutexLocker locker(&_mutex);
     switch (champ)
     {
     case champ_dwStart16:
@@ -197,6 +273,7 @@ void Sound::set(AttributeType champ, AttributeValue value)
     case champ_dwSampleRate:
         // modification de l'échantillonnage
         _info.dwSampleRate = value.dwValue;
+        _isSteadyStateComputed = false;
         break;
     case champ_wChannel:
         // modification du canal utilisé
@@ -225,6 +302,7 @@ void Sound::set(AttributeType champ, AttributeValue value)
 
 void Sound::loadInRam()
 {
+    QMutexLocker locker(&_mutex);
     if (_smpl.isEmpty())
         _smpl = this->getData();
 }
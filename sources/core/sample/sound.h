@@ -27,11 +27,12 @@
 
 #include "basetypes.h"
 #include "infosound.h"
+#include <QRecursiveMutex>
 
 class QFile;
-class QWidget;
 class SampleReader;
 
+// The data can be read and written from several threads, each sound being protected by its own mutex
 class Sound
 {
 public:
@@ -39,17 +40,25 @@ public:
     ~Sound();
 
     // Get information about the sample loaded
-    InfoSound getInfo() { return _info; }
-    QString getError() { return _error; }
-    QString getFileName() { return _fileName; }
+    InfoSound getInfo();
+    QString getError();
+    QString getFileName();
     QVector<float> getData(bool forceReload = false);
+    bool isDataModified(); // True if the data differs from the content of the file
     quint32 getUInt32(AttributeType champ); // For everything but the pitch correction
     qint32 getInt32(AttributeType champ); // For the pitch correction
+    qint64 getMemorySize(); // Size of the data loaded in RAM, in bytes
+
+    // Steady part of the sample, computed once and reset when the data or the sample rate changes
+    // (after the end of a modification in place)
+    void getSteadyState(quint32 &posStart, quint32 &posEnd);
 
     // Set data
     void set(AttributeType champ, AttributeValue value);
     bool setFileName(QString qStr, bool tryFindRootKey = true);
     void setData(QVector<float> data);
+    float * editData(QVector<float> &previousData); // The data is detached and locked until endEditData is called
+    void endEditData();
     void loadInRam();
 
 private:
@@ -58,6 +67,12 @@ private:
     InfoSound _info;
     QVector<float> _smpl;
     SampleReader * _reader;
+    bool _isDataModified;
+    QRecursiveMutex _mutex; // Protect the data, the reader and the information used by the reader
+
+    // Analysis cache
+    bool _isSteadyStateComputed;
+    quint32 _steadyStart, _steadyEnd;
 
     void determineRootKey();
 };
@@ -34,6 +34,7 @@
 #include "indexedelementlist.h"
 #include "utils.h"
 #include "solomanager.h"
+#include "treemodel.h"
 
 SoundfontManager * SoundfontManager::s_instance = nullptr;
 
@@ -78,7 +79,10 @@ SoundfontManager::~SoundfontManager()
 void SoundfontManager::remove(EltID id, int *message)
 {
     QMutexLocker locker(&_mutex);
-    this->remove(id, false, true, message);
+
+    // No actions during a bulk load: the element cannot be displayed again and is directly deleted
+    bool bulkLoad = _bulkLoads.contains(id.indexSf2);
+    this->remove(id, bulkLoad, !bulkLoad, message);
 }
 
 void SoundfontManager::onDropId(EltID id)
@@ -195,27 +199,27 @@ AttributeValue SoundfontManager::get(EltID id, AttributeType champ)
         switch (champ)
         {
         case champ_dwStart16:
-            value.dwValue = tmp->_sound.getUInt32(champ_dwStart16); break;
+            value.dwValue = tmp->_sound->getUInt32(champ_dwStart16); break;
         case champ_dwStart24:
-            value.dwValue = tmp->_sound.getUInt32(champ_dwStart24); break;
+            value.dwValue = tmp->_sound->getUInt32(champ_dwStart24); break;
         case champ_dwLength:
-            value.dwValue = tmp->_sound.getUInt32(champ_dwLength); break;
+            value.dwValue = tmp->_sound->getUInt32(champ_dwLength); break;
         case champ_dwStartLoop:
-            value.dwValue = tmp->_sound.getUInt32(champ_dwStartLoop); break;
+            value.dwValue = tmp->_sound->getUInt32(champ_dwStartLoop); break;
         case champ_dwEndLoop:
-            value.dwValue = tmp->_sound.getUInt32(champ_dwEndLoop); break;
+            value.dwValue = tmp->_sound->getUInt32(champ_dwEndLoop); break;
         case champ_dwSampleRate:
-            value.dwValue = tmp->_sound.getUInt32(champ_dwSampleRate); break;
+            value.dwValue = tmp->_sound->getUInt32(champ_dwSampleRate); break;
         case champ_bpsFile:
-            value.wValue = tmp->_sound.getUInt32(champ_bpsFile); break;
+            value.wValue = tmp->_sound->getUInt32(champ_bpsFile); break;
         case champ_wChannel:
-            value.wValue = tmp->_sound.getUInt32(champ_wChannel); break;
+            value.wValue = tmp->_sound->getUInt32(champ_wChannel); break;
         case champ_wChannels:
-            value.wValue = tmp->_sound.getUInt32(champ_wChannels); break;
+            value.wValue = tmp->_sound->getUInt32(champ_wChannels); break;
         case champ_byOriginalPitch:
-            value.bValue = tmp->_sound.getUInt32(champ_byOriginalPitch); break;
+            value.bValue = tmp->_sound->getUInt32(champ_byOriginalPitch); break;
         case champ_chPitchCorrection:
-            value.cValue = tmp->_sound.getInt32(champ_chPitchCorrection); break;
+            value.cValue = tmp->_sound->getInt32(champ_chPitchCorrection); break;
         case champ_wSampleLink:
             value.wValue = tmp->_wSampleLink; break;
         case champ_sfSampleType:
@@ -339,15 +343,15 @@ AttributeValue SoundfontManager::get(EltID id, AttributeType champ)
     return value;
 }
 
-Sound * SoundfontManager::getSound(EltID id)
+QSharedPointer<Sound> SoundfontManager::getSound(EltID id)
 {
     QMutexLocker locker(&_mutex);
-    Sound * son = nullptr;
+    QSharedPointer<Sound> son;
     if (!this->isValid(id))
         return son;
 
     if (id.typeElement == elementSmpl)
-        son = &_soundfonts->getSoundfont(id.indexSf2)->getSample(id.indexElt)->_sound;
+        son = _soundfonts->getSoundfont(id.indexSf2)->getSample(id.indexElt)->_sound;
 
     return son;
 }
@@ -391,6 +395,8 @@ QString SoundfontManager::getQstr(EltID id, AttributeType champ)
             ret = tmp->_fileNameInitial; break;
         case champ_filenameForData:
             ret = tmp->_fileNameForData; break;
+        case champ_filenameTemporary:
+            ret = tmp->_fileNameTemporary; break;
         default:
             break;
         }
@@ -405,7 +411,7 @@ QString SoundfontManager::getQstr(EltID id, AttributeType champ)
         case champ_nameSort:
             ret = tmp->sortText(); break;
         case champ_filenameForData:
-            ret = tmp->_sound.getFileName(); break;
+            ret = tmp->_sound->getFileName(); break;
         default:
             break;
         }
@@ -450,8 +456,10 @@ QVector<float> SoundfontManager::getData(EltID idSmpl)
     if (!this->isValid(idSmpl))
         return baRet;
 
-    Smpl *tmp = _soundfonts->getSoundfont(idSmpl.indexSf2)->getSample(idSmpl.indexElt);
-    baRet = tmp->_sound.getData();
+    // The sample is possibly loaded from its file without locking the other elements
+    QSharedPointer<Sound> sound = _soundfonts->getSoundfont(idSmpl.indexSf2)->getSample(idSmpl.indexElt)->_sound;
+    locker.unlock();
+    baRet = sound->getData();
 
     return baRet;
 }
@@ -587,6 +595,9 @@ void SoundfontManager::endEditing(QString editingSource)
 {
     QMutexLocker locker(&_mutex);
 
+    // Batches that may have not been closed are ended before the views are notified
+    endAllBatches();
+
     // Close the action set and get the list of sf2 that have been edited
     QList<int> sf2Indexes = _undoRedo->commitActionSet();
     if (!sf2Indexes.empty())
@@ -610,11 +621,56 @@ void SoundfontManager::clearNewEditing()
 void SoundfontManager::revertNewEditing()
 {
     QMutexLocker locker(&_mutex);
+    endAllBatches();
     undo(_undoRedo->getCurrentActions());
     _undoRedo->clearCurrentActionSet();
     _parameterForCustomizingKeyboardChanged = false;
 }
 
+void SoundfontManager::beginBulkLoad(int indexSf2)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_bulkLoads.contains(indexSf2))
+    {
+        _bulkLoads << indexSf2;
+        beginBatch(indexSf2);
+    }
+}
+
+void SoundfontManager::endBulkLoad(int indexSf2)
+{
+    QMutexLocker locker(&_mutex);
+    if (_bulkLoads.removeAll(indexSf2) > 0)
+        endBatch(indexSf2);
+}
+
+void SoundfontManager::beginBatch(int indexSf2)
+{
+    QMutexLocker locker(&_mutex);
+    TreeModel * model = dynamic_cast<TreeModel *>(_soundfonts->getModel(indexSf2));
+    if (model != nullptr)
+    {
+        model->beginBatch();
+        _batches << indexSf2;
+    }
+}
+
+void SoundfontManager::endBatch(int indexSf2)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_batches.removeOne(indexSf2))
+        return;
+    TreeModel * model = dynamic_cast<TreeModel *>(_soundfonts->getModel(indexSf2));
+    if (model != nullptr)
+        model->endBatch();
+}
+
+void SoundfontManager::endAllBatches()
+{
+    while (!_batches.isEmpty())
+        endBatch(_batches.last());
+}
+
 bool SoundfontManager::isUndoable(int indexSf2)
 {
     QMutexLocker locker(&_mutex);
@@ -627,6 +683,12 @@ bool SoundfontManager::isRedoable(int indexSf2)
     return _undoRedo->isRedoable(indexSf2);
 }
 
+void SoundfontManager::setUndoMemoryBudget(qint64 bytes)
+{
+    QMutexLocker locker(&_mutex);
+    _undoRedo->setMemoryBudget(bytes);
+}
+
 void SoundfontManager::undo(int indexSf2)
 {
     QMutexLocker locker(&_mutex);
@@ -657,10 +719,10 @@ QList<int> SoundfontManager::undo(QList<Action *> actions)
         case Action::TypeUpdate:
         case Action::TypeChangeToDefault:
             // Back to the old value
-            if (action->champ >= champ_filenameInitial && action->champ <= champ_nameSort)
+            if (action->champ >= champ_filenameInitial && action->champ <= champ_filenameTemporary)
                 this->set(action->id, action->champ, action->qOldValue); // QString
             else if (action->champ == champ_sampleData)
-                this->set(action->id, action->fOldValue); // QVector<float>
+                this->swapData(action); // QVector<float>
             else
                 this->set(action->id, action->champ, action->vOldValue); // Valeur
             break;
@@ -704,10 +766,10 @@ void SoundfontManager::redo(int indexSf2)
         case Action::TypeUpdate:
         case Action::TypeChangeFromDefault:
             // Apply again the new value
-            if (action->champ >= champ_filenameInitial && action->champ <= champ_nameSort)
+            if (action->champ >= champ_filenameInitial && action->champ <= champ_filenameTemporary)
                 this->set(action->id, action->champ, action->qNewValue); // QString
             else if (action->champ == champ_sampleData)
-                this->set(action->id, action->fNewValue); // QVector<float>
+                this->swapData(action); // QVector<float>
             else
                 this->set(action->id, action->champ, action->vNewValue); // Valeur
             break;
@@ -817,10 +879,13 @@ int SoundfontManager::add(EltID id)
     }
 
     // Create and store an action
-    Action *action = new Action();
-    action->typeAction = Action::TypeCreation;
-    action->id = id;
-    this->_undoRedo->add(action);
+    if (!_bulkLoads.contains(id.indexSf2))
+    {
+        Action *action = new Action();
+        action->typeAction = Action::TypeCreation;
+        action->id = id;
+        this->_undoRedo->add(action);
+    }
 
     return i;
 }
@@ -829,6 +894,7 @@ int SoundfontManager::remove(EltID id, bool permanently, bool storeAction, int *
 {
     if (!this->isValid(id, permanently)) // Hidden ID are accepted for a permanent removal
         return 1;
+    qint64 removedDataSize = 0;
 
     switch (id.typeElement)
     {
@@ -854,6 +920,8 @@ int SoundfontManager::remove(EltID id, bool permanently, bool storeAction, int *
         // Finally delete sf2
         _soundfonts->deleteSoundfont(id.indexSf2);
         _undoRedo->dropSoundfont(id.indexSf2);
+        _bulkLoads.removeAll(id.indexSf2);
+        _batches.removeAll(id.indexSf2);
         emit(soundfontClosed(id.indexSf2));
     }break;
     case elementSmpl:{
@@ -890,11 +958,15 @@ int SoundfontManager::remove(EltID id, bool permanently, bool storeAction, int *
             }
         }
 
-        // Delete or hide the sample?
+        // Delete or hide the sample? (the data of a hidden sample stays in memory)
         if (permanently)
             _soundfonts->getSoundfont(id.indexSf2)->deleteSample(id.indexElt);
         else
-            _soundfonts->getSoundfont(id.indexSf2)->getSample(id.indexElt)->setHidden(true);
+        {
+            Smpl * smpl = _soundfonts->getSoundfont(id.indexSf2)->getSample(id.indexElt);
+            smpl->setHidden(true);
+            removedDataSize = smpl->_sound->getMemorySize();
+        }
     }break;
     case elementInst:{
         // Check that no presets use the instrument
@@ -1070,6 +1142,7 @@ int SoundfontManager::remove(EltID id, bool permanently, bool storeAction, int *
         Action *action = new Action();
         action->typeAction = Action::TypeRemoval;
         action->id = id;
+        action->removedDataSize = removedDataSize;
         this->_undoRedo->add(action);
     }
 
@@ -1122,7 +1195,7 @@ int SoundfontManager::set(EltID id, AttributeType champ, AttributeValue value)
     QMutexLocker locker(&_mutex);
     if (!this->isValid(id))
         return 1;
-    bool storeAction = true;
+    bool storeAction = !_bulkLoads.contains(id.indexSf2);
 
     AttributeValue oldValue;
     oldValue.wValue = 0;
@@ -1158,31 +1231,31 @@ int SoundfontManager::set(EltID id, AttributeType champ, AttributeValue value)
         switch (champ)
         {
         case champ_dwStart16:
-            oldValue.dwValue = tmp->_sound.getUInt32(champ_dwStart16);
-            tmp->_sound.set(champ_dwStart16, value); break;
+            oldValue.dwValue = tmp->_sound->getUInt32(champ_dwStart16);
+            tmp->_sound->set(champ_dwStart16, value); break;
         case champ_dwStart24:
-            oldValue.dwValue = tmp->_sound.getUInt32(champ_dwStart24);
-            tmp->_sound.set(champ_dwStart24, value); break;
+            oldValue.dwValue = tmp->_sound->getUInt32(champ_dwStart24);
+            tmp->_sound->set(champ_dwStart24, value); break;
         case champ_dwLength:
-            oldValue.dwValue = tmp->_sound.getUInt32(champ_dwLength);
-            tmp->_sound.set(champ_dwLength, value); break;
+            oldValue.dwValue = tmp->_sound->getUInt32(champ_dwLength);
+            tmp->_sound->set(champ_dwLength, value); break;
         case champ_dwStartLoop:
-            oldValue.dwValue = tmp->_sound.getUInt32(champ_dwStartLoop);
-            tmp->_sound.set(champ_dwStartLoop, value); break;
+            oldValue.dwValue = tmp->_sound->getUInt32(champ_dwStartLoop);
+            tmp->_sound->set(champ_dwStartLoop, value); break;
         case champ_dwEndLoop:
-            oldValue.dwValue = tmp->_sound.getUInt32(champ_dwEndLoop);
-            tmp->_sound.set(champ_dwEndLoop, value); break;
+            oldValue.dwValue = tmp->_sound->getUInt32(champ_dwEndLoop);
+            tmp->_sound->set(champ_dwEndLoop, value); break;
         case champ_dwSampleRate:
-            oldValue.dwValue = tmp->_sound.getUInt32(champ_dwSampleRate);
-            tmp->_sound.set(champ_dwSampleRate, value); break;
+            oldValue.dwValue = tmp->_sound->getUInt32(champ_dwSampleRate);
+            tmp->_sound->set(champ_dwSampleRate, value); break;
         case champ_byOriginalPitch:
-            oldValue.bValue = tmp->_sound.getUInt32(champ_byOriginalPitch);
-            tmp->_sound.set(champ_byOriginalPitch, value);
+            oldValue.bValue = tmp->_sound->getUInt32(champ_byOriginalPitch);
+            tmp->_sound->set(champ_byOriginalPitch, value);
             _parameterForCustomizingKeyboardChanged = true;
             break;
         case champ_chPitchCorrection:
-            oldValue.cValue = tmp->_sound.getInt32(champ_chPitchCorrection);
-            tmp->_sound.set(champ_chPitchCorrection, value); break;
+            oldValue.cValue = tmp->_sound->getInt32(champ_chPitchCorrection);
+            tmp->_sound->set(champ_chPitchCorrection, value); break;
         case champ_wSampleLink:
             oldValue.wValue = tmp->_wSampleLink;
             tmp->_wSampleLink = value.wValue; break;
@@ -1190,14 +1263,14 @@ int SoundfontManager::set(EltID id, AttributeType champ, AttributeValue value)
             oldValue.sfLinkValue = tmp->_sfSampleType;
             tmp->_sfSampleType = value.sfLinkValue; break;
         case champ_bpsFile:
-            oldValue.wValue = tmp->_sound.getUInt32(champ_bpsFile);
-            tmp->_sound.set(champ_bpsFile, value); break;
+            oldValue.wValue = tmp->_sound->getUInt32(champ_bpsFile);
+            tmp->_sound->set(champ_bpsFile, value); break;
         case champ_wChannel:
-            oldValue.wValue = tmp->_sound.getUInt32(champ_wChannel);
-            tmp->_sound.set(champ_wChannel, value); break;
+            oldValue.wValue = tmp->_sound->getUInt32(champ_wChannel);
+            tmp->_sound->set(champ_wChannel, value); break;
         case champ_wChannels:
-            oldValue.wValue = tmp->_sound.getUInt32(champ_wChannels);
-            tmp->_sound.set(champ_wChannels, value); break;
+            oldValue.wValue = tmp->_sound->getUInt32(champ_wChannels);
+            tmp->_sound->set(champ_wChannels, value); break;
         default:
             break;
         }
@@ -1395,6 +1468,9 @@ int SoundfontManager::set(EltID id, AttributeType champ, QString qStr)
         case champ_filenameForData:
             qOldStr = tmp->_fileNameForData;
             tmp->_fileNameForData = qStr; break;
+        case champ_filenameTemporary:
+            qOldStr = tmp->_fileNameTemporary;
+            tmp->_fileNameTemporary = qStr; break;
         default:
             break;
         }
@@ -1411,10 +1487,10 @@ int SoundfontManager::set(EltID id, AttributeType champ, QString qStr)
             tmp->setName(qStr);
             break;
         case champ_filenameForData:
-            qOldStr = tmp->_sound.getFileName();
-            tmp->_sound.setFileName(qStr);
-            if (!tmp->_sound.getError().isEmpty())
-                emit(errorEncountered(tmp->_sound.getError()));
+            qOldStr = tmp->_sound->getFileName();
+            tmp->_sound->setFileName(qStr);
+            if (!tmp->_sound->getError().isEmpty())
+                emit(errorEncountered(tmp->_sound->getError()));
             break;
         default:
             break;
@@ -1457,13 +1533,16 @@ int SoundfontManager::set(EltID id, AttributeType champ, QString qStr)
     }
 
     // Create and store the action
-    Action *action = new Action();
-    action->typeAction = Action::TypeUpdate;
-    action->id = id;
-    action->champ = champ;
-    action->qOldValue = qOldStr;
-    action->qNewValue = qStr;
-    this->_undoRedo->add(action);
+    if (!_bulkLoads.contains(id.indexSf2))
+    {
+        Action *action = new Action();
+        action->typeAction = Action::TypeUpdate;
+        action->id = id;
+        action->champ = champ;
+        action->qOldValue = qOldStr;
+        action->qNewValue = qStr;
+        this->_undoRedo->add(action);
+    }
 
     return 0;
 }
@@ -1473,26 +1552,72 @@ int SoundfontManager::set(EltID idSmpl, QVector<float> data)
     QMutexLocker locker(&_mutex);
     if (!this->isValid(idSmpl))
         return 1;
+    QSharedPointer<Sound> sound = _soundfonts->getSoundfont(idSmpl.indexSf2)->getSample(idSmpl.indexElt)->_sound;
 
-    QVector<float> oldData;
-    oldData.clear();
-
-    // Update sample data
-    oldData = _soundfonts->getSoundfont(idSmpl.indexSf2)->getSample(idSmpl.indexElt)->_sound.getData();
-    _soundfonts->getSoundfont(idSmpl.indexSf2)->getSample(idSmpl.indexElt)->_sound.setData(data);
+    // During a bulk load, the previous data is neither read nor stored
+    if (_bulkLoads.contains(idSmpl.indexSf2))
+    {
+        sound->setData(data);
+        return 0;
+    }
 
-    // Création et stockage de l'action
+    // The differences with the previous data are computed without locking the other elements
+    locker.unlock();
+    QVector<float> oldData = sound->getData();
     Action *action = new Action();
     action->typeAction = Action::TypeUpdate;
     action->id = idSmpl;
     action->champ = champ_sampleData;
-    action->fOldValue = oldData;
-    action->fNewValue = data;
+    action->sampleDelta.setPreviousData(oldData, data);
+    locker.relock();
+
+    if (!this->isValid(idSmpl))
+    {
+        delete action;
+        return 1;
+    }
+
+    // Compare again if the data changed in the meantime
+    QVector<float> currentData = sound->getData();
+    if (currentData.constData() != oldData.constData() || currentData.size() != oldData.size())
+        action->sampleDelta.setPreviousData(currentData, data);
+
+    // Update sample data and store the action
+    sound->setData(data);
     this->_undoRedo->add(action);
 
     return 0;
 }
 
+void SoundfontManager::storeEditedData(EltID idSmpl, QVector<float> previousData)
+{
+    QMutexLocker locker(&_mutex);
+
+    // During a bulk load or if the sample has been deleted in the meantime, the previous data is not stored
+    if (_bulkLoads.contains(idSmpl.indexSf2) || !this->isValid(idSmpl))
+        return;
+
+    // The previous version is kept without being compared
+    Action *action = new Action();
+    action->typeAction = Action::TypeUpdate;
+    action->id = idSmpl;
+    action->champ = champ_sampleData;
+    action->sampleDelta.setPreviousData(previousData);
+    this->_undoRedo->add(action);
+}
+
+void SoundfontManager::swapData(Action * action)
+{
+    if (!this->isValid(action->id))
+        return;
+
+    // The action keeps the differences with the version that is replaced, for the next undo / redo
+    QSharedPointer<Sound> sound = _soundfonts->getSoundfont(action->id.indexSf2)->getSample(action->id.indexElt)->_sound;
+    QVector<float> data = sound->getData();
+    action->sampleDelta.swap(data);
+    sound->setData(data);
+}
+
 void SoundfontManager::reset(EltID id, AttributeType champ)
 {
     QMutexLocker locker(&_mutex);
@@ -1547,12 +1672,15 @@ void SoundfontManager::reset(EltID id, AttributeType champ)
         _parameterForCustomizingKeyboardChanged = true;
 
     // Create and store the action
-    Action *action = new Action();
-    action->typeAction = Action::TypeChangeToDefault;
-    action->id = id;
-    action->champ = champ;
-    action->vOldValue = oldValue;
-    _undoRedo->add(action);
+    if (!_bulkLoads.contains(id.indexSf2))
+    {
+        Action *action = new Action();
+        action->typeAction = Action::TypeChangeToDefault;
+        action->id = id;
+        action->champ = champ;
+        action->vOldValue = oldValue;
+        _undoRedo->add(action);
+    }
 }
 
 void SoundfontManager::simplify(EltID id, AttributeType champ)
@@ -1939,6 +2067,6 @@ void SoundfontManager::loadAllSamples(int sf2Index)
     {
         // And load data in RAM if it's not hidden
         if (!smplTmp->isHidden())
-            smplTmp->_sound.loadInRam();
+            smplTmp->_sound->loadInRam();
     }
 }
@@ -29,6 +29,7 @@
 #include "basetypes.h"
 #include <QMap>
 #include <QObject>
+#include <QSharedPointer>
 class Action;
 class ActionManager;
 class Soundfonts;
@@ -53,11 +54,11 @@ public:
     bool isSet(EltID id, AttributeType champ);
     AttributeValue get(EltID id, AttributeType champ);
     QString getQstr(EltID id, AttributeType champ);
-    Sound *getSound(EltID id);
+    QSharedPointer<Sound> getSound(EltID id); // The sound stays valid even if the sample is deleted in the meantime
     QVector<float> getData(EltID idSmpl);
     int set(EltID id, AttributeType champ, AttributeValue value);
     int set(EltID id, AttributeType champ, QString qStr);
-    int set(EltID idSmpl, QVector<float> data);
+    int set(EltID idSmpl, QVector<float> data); // SampleEdition can also edit the data in place
     void reset(EltID id, AttributeType champ);
     void simplify(EltID id, AttributeType champ);
 
@@ -68,10 +69,21 @@ public:
     void endEditing(QString editingSource);
     void clearNewEditing(); // Keep the changes but don't make an undo
     void revertNewEditing(); // Doesn't keep the changes
+
+    // Bulk load of a soundfont: no actions are stored for it until endBulkLoad is called
+    // (used by the input parsers, the changes being then cleared with clearNewEditing)
+    void beginBulkLoad(int indexSf2);
+    void endBulkLoad(int indexSf2);
+
+    // Batch of changes in a soundfont: the tree is updated once when the batch ends instead of for each element
+    // (all batches are ended at the latest with endEditing or revertNewEditing)
+    void beginBatch(int indexSf2);
+    void endBatch(int indexSf2);
     bool isUndoable(int indexSf2);
     bool isRedoable(int indexSf2);
     void undo(int indexSf2);
     void redo(int indexSf2);
+    void setUndoMemoryBudget(qint64 bytes); // Memory that can be used by all undo / redo, in bytes
 
     // Version management
     void markAsSaved(int indexSf2);
@@ -91,6 +103,9 @@ public:
     // Create a notification about a new soundfont that has been loaded
     void emitNewSoundfontLoaded(int sf2Index) { emit(this->soundfontLoaded(sf2Index)); }
 
+    // Create a notification about an error, for instance a part of a file that cannot be read
+    void emitError(QString text) { emit(this->errorEncountered(text)); }
+
     // Get the division order
     // Sort type: 0: key, 1: velocity, 2: name
     // Result:
@@ -133,6 +148,7 @@ private slots:
     void onDropId(EltID id);
 
 private:
+    friend class SampleEdition;
     SoundfontManager();
 
     /// Display the element ID
@@ -146,6 +162,13 @@ private:
 
     QList<int> undo(QList<Action *> actions);
 
+    /// Replace the data of a sample by the other version stored in an action (undo or redo)
+    void swapData(Action * action);
+
+    /// Store the previous version of a sample edited in place
+    void storeEditedData(EltID idSmpl, QVector<float> previousData);
+    void endAllBatches();
+
     // Division order
     int compareKey(EltID idDiv1, EltID idDiv2);
     int compareVelocity(EltID idDiv1, EltID idDiv2);
@@ -156,6 +179,8 @@ private:
     ActionManager * _undoRedo;
     QRecursiveMutex _mutex;
     SoloManager * _solo;
+    QList<int> _bulkLoads;
+    QList<int> _batches;
 
     bool _parameterForCustomizingKeyboardChanged;
 };
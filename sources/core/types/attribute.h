@@ -138,6 +138,7 @@ typedef enum
     champ_ISFT = 172,
     champ_name = 173,                   // (sf2, smpl, inst et prst)
     champ_nameSort = 174,
+    champ_filenameTemporary = 175,      // QString (sf2)
 
     champ_sampleData = 200,             // QVector<float>
 
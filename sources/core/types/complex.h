@@ -25,21 +25,51 @@
 #ifndef COMPLEX_H
 #define COMPLEX_H
 
+#include <cmath>
 
 class Complex
 {
 public:
-    /// Constructor
-    Complex();
+    /// Constructors (values are not initialized by default)
+    Complex() {}
+    Complex(float real, float imag) : _real(real), _imag(imag) {}
 
     /// Getters / Setters for real and imag parts of the complex number
     void imag(float value) { _imag = value; }
     void real(float value) { _real = value; }
-    float imag() { return _imag; }
-    float real() { return _real; }
+    float imag() const { return _imag; }
+    float real() const { return _real; }
 
-    /// Multiplication
-    Complex operator *= (const float factor);
+    /// Conjugate and module
+    Complex conj() const { return Complex(_real, -_imag); }
+    float abs() const { return std::sqrt(_real * _real + _imag * _imag); }
+
+    /// Operations
+    Complex operator + (const Complex &other) const { return Complex(_real + other._real, _imag + other._imag); }
+    Complex operator - (const Complex &other) const { return Complex(_real - other._real, _imag - other._imag); }
+    Complex operator * (const Complex &other) const
+    {
+        return Complex(_real * other._real - _imag * other._imag, _real * other._imag + _imag * other._real);
+    }
+    Complex operator * (const float factor) const { return Complex(_real * factor, _imag * factor); }
+    Complex &operator += (const Complex &other)
+    {
+        _real += other._real;
+        _imag += other._imag;
+        return *this;
+    }
+    Complex &operator -= (const Complex &other)
+    {
+        _real -= other._real;
+        _imag -= other._imag;
+        return *this;
+    }
+    Complex &operator *= (const float factor)
+    {
+        _real *= factor;
+        _imag *= factor;
+        return *this;
+    }
 
 private:
     float _real, _imag;
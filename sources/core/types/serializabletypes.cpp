@@ -60,12 +60,31 @@ QDataStream & operator >> (QDataStream &in, qint16Reversed &val)
 
 QDataStream & operator >> (QDataStream &in, SFModulator &mod)
 {
-    quint8 b0, b1;
-    in >> b0 >> b1;
+    char data[2] = {0, 0};
+    in.readRawData(data, 2);
+    readSFModulator(data, mod);
+    return in;
+}
+
+quint16 readQuint16(const char * data)
+{
+    const quint8 * b = reinterpret_cast<const quint8 *>(data);
+    return static_cast<quint16>(b[1] << 8 | b[0]);
+}
+
+quint32 readQuint32(const char * data)
+{
+    const quint8 * b = reinterpret_cast<const quint8 *>(data);
+    return static_cast<quint32>(b[3]) << 24 | b[2] << 16 | b[1] << 8 | b[0];
+}
+
+void readSFModulator(const char * data, SFModulator &mod)
+{
+    quint8 b0 = static_cast<quint8>(data[0]);
+    quint8 b1 = static_cast<quint8>(data[1]);
     mod.Type = static_cast<ModType>(b1 >> 2);
     mod.isBipolar = ((b1 >> 1) & 1);
     mod.isDescending = (b1 & 1);
     mod.CC = bool(b0 >> 7);
     mod.Index = quint16(b0 & 0x7F);
-    return in;
 }
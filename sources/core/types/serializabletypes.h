@@ -63,4 +63,9 @@ QDataStream & operator >> (QDataStream &in, qint16Reversed &val);
 
 QDataStream & operator >> (QDataStream &in, SFModulator &mod);
 
+// Same conversions, from raw data already in memory
+quint16 readQuint16(const char * data);
+quint32 readQuint32(const char * data);
+void readSFModulator(const char * data, SFModulator &mod);
+
 #endif // SERIALIZABLETYPES_H
@@ -54,6 +54,13 @@ public:
     static qint32 floatToInt24(float f);
     static float int24ToFloat(qint32 i);
 
+    /// Same result as floatToInt24, without branches so that the loops calling it can be vectorized
+    static inline qint32 floatToInt24Vectorizable(float f)
+    {
+        f = qBound(-1.0f, f, 1.0f) * 8388607.5f - .5f;
+        return static_cast<qint32>(f + (f > 0 ? 0.5f : -0.5f));
+    }
+
     static QString fixFilePath(QString filePath);
 
     static bool isValidUtf8(QByteArray data);
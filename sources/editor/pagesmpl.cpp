@@ -31,6 +31,7 @@
 #include <QScreen>
 #include "sound.h"
 #include "graphicsfourier.h"
+#include "tools/auto_tune/pitchdetection.h"
 #include "sampleutils.h"
 #include "contextmanager.h"
 
@@ -997,14 +998,11 @@ void PageSmpl::on_pushAutoTune_clicked()
 
 void PageSmpl::autoTune(EltID id, int &pitch, int &correction, float &score)
 {
-    // Remplissage du graphique Fourier
-    ui->grapheFourier->setCurrentIds(id);
-    quint32 startLoop = _sf2->get(id, champ_dwStartLoop).dwValue;
-    quint32 endLoop = _sf2->get(id, champ_dwEndLoop).dwValue;
-    ui->grapheFourier->setPos(startLoop, endLoop, false);
-
-    // Hauteur de note et correction
-    ui->grapheFourier->getEstimation(pitch, correction, score);
+    // Same estimation as the tool detecting the root keys, the analysis being shared
+    SamplePitch samplePitch = PitchDetection::analyze(id);
+    pitch = samplePitch.key;
+    correction = samplePitch.correction;
+    score = samplePitch.score;
 }
 
 void PageSmpl::onSpacePressedInternal()
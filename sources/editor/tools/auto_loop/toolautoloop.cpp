@@ -25,6 +25,7 @@
 #include "auto_loop/toolautoloop.h"
 #include "soundfontmanager.h"
 #include "sampleutils.h"
+#include "loopfinder.h"
 
 void ToolAutoLoop::beforeProcess(IdList ids)
 {
@@ -64,116 +65,43 @@ void ToolAutoLoop::process(SoundfontManager * sm, EltID id, AbstractToolParamete
     }
     _mutex.unlock();
 
-    // Get data, sample rate, start and end loop of sample 1
+    // Both sides of a stereo sample are looped jointly if their sample rates match
+    if (withLink && sm->get(id2, champ_dwSampleRate).dwValue != sm->get(id, champ_dwSampleRate).dwValue)
+    {
+        loopSample(sm, id2, id2, false);
+        withLink = false;
+    }
+    loopSample(sm, id, id2, withLink);
+}
+
+void ToolAutoLoop::loopSample(SoundfontManager * sm, EltID id, EltID id2, bool withLink)
+{
+    // Get data, sample rate, start and end loop
     QVector<float> vData = sm->getData(id);
+    QVector<float> vData2;
+    if (withLink)
+        vData2 = sm->getData(id2);
     quint32 dwSmplRate = sm->get(id, champ_dwSampleRate).dwValue;
     quint32 startLoop = sm->get(id, champ_dwStartLoop).dwValue;
     quint32 endLoop = sm->get(id, champ_dwEndLoop).dwValue;
 
-    // Loop
-    quint32 crossfadeLength;
-    bool result = SampleUtils::loopStep1(vData, dwSmplRate, startLoop, endLoop, crossfadeLength);
-
-    // Same for sample 2
-    if (withLink)
-    {
-        // Only if the sample rates match
-        quint32 dwSmplRate2 = sm->get(id2, champ_dwSampleRate).dwValue;
-        if (dwSmplRate2 == dwSmplRate)
-        {
-            QVector<float> vData2 = sm->getData(id2);
-            quint32 startLoop2 = sm->get(id2, champ_dwStartLoop).dwValue;
-            quint32 endLoop2 = sm->get(id2, champ_dwEndLoop).dwValue;
-
-            quint32 crossfadeLength2;
-            bool result2 = SampleUtils::loopStep1(vData2, dwSmplRate2, startLoop2, endLoop2, crossfadeLength2);
-
-            if (result && !result2)
-            {
-                // Take the values of sample 1, if possible
-                if (endLoop + 8 < (unsigned int)vData2.size())
-                    updateSample(id2, vData2, startLoop, endLoop, crossfadeLength);
-                else
-                {
-                    // Sample 2 cannot be processed
-                    _mutex.lock();
-                    _samplesNotLooped << sm->getQstr(id2, champ_name);
-                    _mutex.unlock();
-                }
-            }
-            else if (!result && result2)
-            {
-                // Use the values of sample 2 for sample 1, if possible
-                if (endLoop2 + 8 < (unsigned int)vData.size())
-                {
-                    startLoop = startLoop2;
-                    endLoop = endLoop2;
-                    crossfadeLength = crossfadeLength2;
-                    result = true;
-                }
-
-                // Update sample 2
-                updateSample(id2, vData2, startLoop2, endLoop2, crossfadeLength2);
-            }
-            else if (!result && !result2)
-            {
-                // None of the samples could be looped
-                _mutex.lock();
-                _samplesNotLooped << sm->getQstr(id2, champ_name);
-                _mutex.unlock();
-            }
-            else
-            {
-                // Use the longest possible loop for both samples
-                if (endLoop < endLoop2)
-                {
-                    if (endLoop2 + 8 < (unsigned int)vData.size())
-                    {
-                        // Use the values of sample 2 for both samples (long loop)
-                        startLoop = startLoop2;
-                        endLoop = endLoop2;
-                        crossfadeLength = crossfadeLength2;
-                    }
-                    else
-                    {
-                        // Use the values of sample 1 for both samples (short loop)
-                        startLoop2 = startLoop;
-                        endLoop2 = endLoop;
-                        crossfadeLength2 = crossfadeLength;
-                    }
-                }
-                else
-                {
-                    if (endLoop + 8 < (unsigned int)vData2.size())
-                    {
-                        // Use the values of sample 1 for both samples (long loop)
-                        startLoop2 = startLoop;
-                        endLoop2 = endLoop;
-                        crossfadeLength2 = crossfadeLength;
-                    }
-                    else
-                    {
-                        // Use the values of sample 2 for both samples (short loop)
-                        startLoop = startLoop2;
-                        endLoop = endLoop2;
-                        crossfadeLength = crossfadeLength2;
-                    }
-                }
-
-                // Update sample 2
-                updateSample(id2, vData2, startLoop2, endLoop2, crossfadeLength2);
-            }
-        }
-    }
-
-    if (result)
-        updateSample(id, vData, startLoop, endLoop, crossfadeLength);
-    else
+    // Best loop
+    LoopFinder loopFinder(vData, vData2, dwSmplRate);
+    QList<LoopFinder::Candidate> candidates = loopFinder.find(startLoop, endLoop, 1);
+    if (candidates.isEmpty())
     {
         _mutex.lock();
         _samplesNotLooped << sm->getQstr(id, champ_name);
+        if (withLink)
+            _samplesNotLooped << sm->getQstr(id2, champ_name);
         _mutex.unlock();
+        return;
     }
+
+    LoopFinder::Candidate candidate = candidates.first();
+    updateSample(id, vData, candidate.loopStart, candidate.loopEnd, candidate.crossfadeLength);
+    if (withLink)
+        updateSample(id2, vData2, candidate.loopStart, candidate.loopEnd, candidate.crossfadeLength);
 }
 
 void ToolAutoLoop::updateSample(EltID id, QVector<float> vData, quint32 startLoop, quint32 endLoop, quint32 crossfadeLength)
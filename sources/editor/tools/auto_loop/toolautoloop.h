@@ -69,6 +69,7 @@ protected:
     QString getWarning() override;
 
 private:
+    void loopSample(SoundfontManager * sm, EltID id, EltID id2, bool withLink);
     void updateSample(EltID id, QVector<float> vData, quint32 startLoop, quint32 endLoop, quint32 crossfadeLength);
 
     IdList _processedSamples;
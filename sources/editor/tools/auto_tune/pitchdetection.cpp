@@ -0,0 +1,82 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "pitchdetection.h"
+#include "soundfontmanager.h"
+#include <QCryptographicHash>
+
+const int PitchDetection::MAX_CACHE_SIZE = 4096;
+QMutex PitchDetection::s_mutex;
+QMap<QByteArray, SamplePitch> PitchDetection::s_cache;
+
+SamplePitch PitchDetection::analyze(EltID idSmpl)
+{
+    SoundfontManager * sm = SoundfontManager::getInstance();
+    QVector<float> vData = sm->getData(idSmpl);
+    quint32 dwSmplRate = sm->get(idSmpl, champ_dwSampleRate).dwValue;
+    quint32 startLoop = sm->get(idSmpl, champ_dwStartLoop).dwValue;
+    quint32 endLoop = sm->get(idSmpl, champ_dwEndLoop).dwValue;
+
+    // Already analyzed?
+    QByteArray hash = getContentHash(vData, dwSmplRate, startLoop, endLoop);
+    s_mutex.lock();
+    if (s_cache.contains(hash))
+    {
+        SamplePitch result = s_cache[hash];
+        s_mutex.unlock();
+        return result;
+    }
+    s_mutex.unlock();
+
+    // Estimation based on the correlation and the Fourier transform
+    SamplePitch result;
+    QVector<float> vectFourier;
+    int posMaxFourier;
+    int deviation = 0;
+    result.peaks = GraphicsFourier::computePeaks(vData, dwSmplRate, startLoop, endLoop, vectFourier, posMaxFourier,
+                                                 &result.key, &deviation, &result.score);
+    result.correction = -deviation;
+
+    // Store the result, the cache being emptied when it is full
+    s_mutex.lock();
+    if (s_cache.count() >= MAX_CACHE_SIZE)
+        s_cache.clear();
+    s_cache[hash] = result;
+    s_mutex.unlock();
+
+    return result;
+}
+
+QByteArray PitchDetection::getContentHash(const QVector<float> &vData, quint32 dwSmplRate, quint32 startLoop, quint32 endLoop)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(vData.constData()),
+                                         vData.size() * static_cast<int>(sizeof(float))));
+
+    // The loop is used to select the part to analyze
+    quint32 parameters[3] = {dwSmplRate, startLoop, endLoop};
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(parameters), sizeof(parameters)));
+
+    return hash.result();
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef PITCHDETECTION_H
+#define PITCHDETECTION_H
+
+#include "basetypes.h"
+#include "graphicsfourier.h"
+#include <QMutex>
+#include <QMap>
+
+class SamplePitch
+{
+public:
+    SamplePitch() :
+        key(-1),
+        correction(0),
+        score(-1)
+    {}
+
+    int key; // -1 if no pitch has been found
+    int correction; // Correction to apply, opposite of the deviation measured
+    float score;
+    QList<Peak> peaks;
+};
+
+class PitchDetection
+{
+public:
+    /// Estimate the root key, the correction and the peaks of a sample (thread-safe)
+    /// Results are cached according to the content of the sample, so that the same data is analyzed once
+    static SamplePitch analyze(EltID idSmpl);
+
+private:
+    static QByteArray getContentHash(const QVector<float> &vData, quint32 dwSmplRate, quint32 startLoop, quint32 endLoop);
+
+    static const int MAX_CACHE_SIZE;
+    static QMutex s_mutex;
+    static QMap<QByteArray, SamplePitch> s_cache;
+};
+
+#endif // PITCHDETECTION_H
@@ -0,0 +1,106 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "toolautotune.h"
+#include "pitchdetection.h"
+#include "soundfontmanager.h"
+
+void ToolAutoTune::beforeProcess(IdList ids)
+{
+    Q_UNUSED(ids)
+    _processedSamples.clear();
+    _samplesWithoutPitch.clear();
+}
+
+void ToolAutoTune::process(SoundfontManager * sm, EltID id, AbstractToolParameters *parameters)
+{
+    Q_UNUSED(parameters);
+
+    // Sample already processed? Both sides of a stereo sample are tuned together
+    EltID id2 = id;
+    bool withLink = false;
+    _mutex.lock();
+    if (_processedSamples.contains(id))
+    {
+        _mutex.unlock();
+        return;
+    }
+    _processedSamples << id;
+    SFSampleLink typeLien = sm->get(id, champ_sfSampleType).sfLinkValue;
+    if (typeLien != monoSample && typeLien != RomMonoSample)
+    {
+        id2.indexElt = sm->get(id, champ_wSampleLink).wValue;
+        if (sm->isValid(id2) && !_processedSamples.contains(id2))
+        {
+            _processedSamples << id2;
+            withLink = true;
+        }
+    }
+    _mutex.unlock();
+
+    // Keep the estimation having the best score
+    SamplePitch pitch = PitchDetection::analyze(id);
+    if (withLink)
+    {
+        SamplePitch pitch2 = PitchDetection::analyze(id2);
+        if (pitch2.score > pitch.score)
+            pitch = pitch2;
+    }
+
+    if (pitch.key == -1)
+    {
+        _mutex.lock();
+        _samplesWithoutPitch << sm->getQstr(id, champ_name);
+        _mutex.unlock();
+        return;
+    }
+
+    // Root key and correction, all changes being part of the same edition
+    AttributeValue valKey, valCorrection;
+    valKey.bValue = static_cast<quint8>(pitch.key);
+    valCorrection.cValue = static_cast<char>(pitch.correction);
+    sm->set(id, champ_byOriginalPitch, valKey);
+    sm->set(id, champ_chPitchCorrection, valCorrection);
+    if (withLink)
+    {
+        sm->set(id2, champ_byOriginalPitch, valKey);
+        sm->set(id2, champ_chPitchCorrection, valCorrection);
+    }
+}
+
+QString ToolAutoTune::getWarning()
+{
+    QString txt;
+
+    if (!_samplesWithoutPitch.isEmpty())
+    {
+        txt = tr("No pitch has been found for the following samples:");
+        txt += "<ul>";
+        for (int i = 0; i < _samplesWithoutPitch.size(); i++)
+            txt += "<li>" + _samplesWithoutPitch.at(i) + "</li>";
+        txt += "</ul>";
+    }
+
+    return txt;
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef TOOLAUTOTUNE_H
+#define TOOLAUTOTUNE_H
+
+#include "abstracttooliterating.h"
+#include <QObject>
+#include <QMutex>
+
+class ToolAutoTune: public AbstractToolIterating
+{
+    Q_OBJECT
+
+public:
+    ToolAutoTune() : AbstractToolIterating(elementSmpl) {}
+
+    /// Icon, label and category displayed to the user to describe the tool
+    QString getIconName() const override
+    {
+        return ":/tool/auto_tune.svg";
+    }
+
+    QString getCategory() const override
+    {
+        return tr("Sample processing");
+    }
+
+    /// Internal identifier
+    QString getIdentifier() const override
+    {
+        return "smpl:autoTune";
+    }
+
+    /// Method executed before the iterating process
+    void beforeProcess(IdList ids) override;
+
+    /// Process an element
+    void process(SoundfontManager * sm, EltID id, AbstractToolParameters * parameters) override;
+
+protected:
+    QString getLabelInternal() const override
+    {
+        return tr("Detect root keys");
+    }
+
+    /// Get the warning to display after the tool is run
+    QString getWarning() override;
+
+private:
+    QMutex _mutex;
+    IdList _processedSamples;
+    QStringList _samplesWithoutPitch;
+};
+
+#endif // TOOLAUTOTUNE_H
@@ -24,6 +24,7 @@
 
 #include "toolbalanceadjustment.h"
 #include "soundfontmanager.h"
+#include "sampleedition.h"
 #include "sampleutils.h"
 #include <qmath.h>
 
@@ -80,7 +81,7 @@ void ToolBalanceAdjustment::process(SoundfontManager * sm, EltID id, AbstractToo
     // Find steady areas
     quint32 debut1, fin1;
     if (sm->get(id, champ_dwStartLoop).dwValue == sm->get(id, champ_dwEndLoop).dwValue)
-        SampleUtils::regimePermanent(vData1, sm->get(id, champ_dwSampleRate).dwValue, debut1, fin1);
+        sm->getSound(id)->getSteadyState(debut1, fin1);
     else
     {
         debut1 = sm->get(id, champ_dwStartLoop).dwValue;
@@ -88,7 +89,7 @@ void ToolBalanceAdjustment::process(SoundfontManager * sm, EltID id, AbstractToo
     }
     quint32 debut2, fin2;
     if (sm->get(id2, champ_dwStartLoop).dwValue == sm->get(id2, champ_dwEndLoop).dwValue)
-        SampleUtils::regimePermanent(vData2, sm->get(id2, champ_dwSampleRate).dwValue, debut2, fin2);
+        sm->getSound(id2)->getSteadyState(debut2, fin2);
     else
     {
         debut2 = sm->get(id2, champ_dwStartLoop).dwValue;
@@ -96,20 +97,22 @@ void ToolBalanceAdjustment::process(SoundfontManager * sm, EltID id, AbstractToo
     }
 
     // Compute intensities
-    float intensite1 = SampleUtils::meanSquare(vData1.mid(debut1, fin1 - debut1));
-    float intensite2 = SampleUtils::meanSquare(vData2.mid(debut2, fin2 - debut2));
+    float intensite1 = SampleUtils::meanSquare(&vData1.constData()[debut1], fin1 - debut1);
+    float intensite2 = SampleUtils::meanSquare(&vData2.constData()[debut2], fin2 - debut2);
 
     // Mean intensity
     float intensiteMoy = sqrt(intensite1 * intensite2);
 
-    // Adjust volume
+    // Adjust volume, the sample data being modified in place (one sample after the other)
     float gain1, gain2;
-    vData1 = SampleUtils::multiply(vData1, intensiteMoy / intensite1, gain1);
-    vData2 = SampleUtils::multiply(vData2, intensiteMoy / intensite2, gain2);
-
-    // Update sample data
-    sm->set(id, vData1);
-    sm->set(id2, vData2);
+    {
+        SampleEdition edition(sm, id);
+        SampleUtils::multiply(edition.getData(), edition.getSize(), intensiteMoy / intensite1, gain1);
+    }
+    {
+        SampleEdition edition(sm, id2);
+        SampleUtils::multiply(edition.getData(), edition.getSize(), intensiteMoy / intensite2, gain2);
+    }
 }
 
 QString ToolBalanceAdjustment::getWarning()
@@ -26,6 +26,7 @@
 #include "toolchangevolume_gui.h"
 #include "toolchangevolume_parameters.h"
 #include "soundfontmanager.h"
+#include "sampleedition.h"
 #include "sampleutils.h"
 #include <qmath.h>
 
@@ -38,28 +39,28 @@ void ToolChangeVolume::process(SoundfontManager * sm, EltID id, AbstractToolPara
 {
     ToolChangeVolume_parameters * params = (ToolChangeVolume_parameters *)parameters;
 
-    // Sample data
-    QVector<float> vData = sm->getData(id);
+    int mode = params->getMode();
+    if (mode < 0 || mode > 2)
+        return;
+
+    // Sample data, modified in place
+    SampleEdition edition(sm, id);
+    float * data = edition.getData();
+    quint32 size = edition.getSize();
 
     // Change the volume
     float db = 0;
-    switch (params->getMode())
+    switch (mode)
     {
     case 0: // Add dB
         // Compute the factor
-        vData = SampleUtils::multiply(vData, qPow(10, params->getAddValue() / 20.0), db);
+        SampleUtils::multiply(data, size, qPow(10, params->getAddValue() / 20.0), db);
         break;
     case 1: // Multiply by a factor
-        vData = SampleUtils::multiply(vData, params->getMultiplyValue(), db);
+        SampleUtils::multiply(data, size, params->getMultiplyValue(), db);
         break;
-    case 2: // Normalize
-        vData = SampleUtils::normalize(vData, params->getNormalizeValue() / 100, db);
+    default: // Normalize
+        SampleUtils::normalize(data, size, params->getNormalizeValue() / 100, db);
         break;
-    default:
-        // Nothing
-        return;
     }
-
-    // Update the sample data
-    sm->set(id, vData);
 }
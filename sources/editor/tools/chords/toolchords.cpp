@@ -101,6 +101,9 @@ void ToolChords::runInternal(SoundfontManager * sm, QWidget * parent, IdList ids
     _waitingDialog->show();
     connect(_waitingDialog, SIGNAL(canceled()), this, SLOT(onCancel()));
 
+    // The tree will be updated once all divisions are created
+    sm->beginBatch(_idNewInst.indexSf2);
+
     // For each division
     quint32 noteStart2 = range.byLo;
     quint32 noteEnd = range.byHi;
@@ -194,6 +197,7 @@ void ToolChords::onElementProcessed(EltID idSmpl, quint32 key, quint32 minKey, d
     {
         delete _waitingDialog;
         _waitingDialog = nullptr;
+        sm->endBatch(_idNewInst.indexSf2);
         if (_canceled)
         {
             SoundfontManager::getInstance()->revertNewEditing();
@@ -101,9 +101,9 @@ void ToolExternalCommand::process(SoundfontManager * sm, EltID id, AbstractToolP
 
     SampleWriterWav writer(pathTempFile);
     if (id2.indexElt != -1)
-        writer.write(sm->getSound(id), sm->getSound(id2));
+        writer.write(sm->getSound(id).data(), sm->getSound(id2).data());
     else
-        writer.write(sm->getSound(id));
+        writer.write(sm->getSound(id).data());
 
     // Execute an external command
 #ifdef Q_OS_WIN
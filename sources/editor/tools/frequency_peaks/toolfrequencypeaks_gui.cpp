@@ -26,6 +26,7 @@
 #include "ui_toolfrequencypeaks_gui.h"
 #include "contextmanager.h"
 #include "graphicsfourier.h"
+#include "auto_tune/pitchdetection.h"
 #include "soundfontmanager.h"
 #include "utils.h"
 #include <QFileDialog>
@@ -40,19 +41,11 @@ public:
 
     void run() override
     {
-        // Get raw data
+        // Compute the peaks (possibly already known)
         SoundfontManager * sm = SoundfontManager::getInstance();
-        QVector<float> vData = sm->getData(_id);
-
-        // Compute the peaks
-        QVector<float> vectFourier;
-        int posMaxFourier;
         SampleFrequencyInfo sampleInfo;
         sampleInfo.name = sm->getQstr(_id, champ_name);
-        sampleInfo.frequencies = GraphicsFourier::computePeaks(
-                    vData, sm->get(_id, champ_dwSampleRate).dwValue,
-                    sm->get(_id, champ_dwStartLoop).dwValue, sm->get(_id, champ_dwEndLoop).dwValue,
-                    vectFourier, posMaxFourier);
+        sampleInfo.frequencies = PitchDetection::analyze(_id).peaks;
 
         // Send everything to the tool gui
         _toolGui->peakComputed(_id, sampleInfo);
@@ -112,6 +112,9 @@ void ToolMixtureCreation::runInternal(SoundfontManager * sm, QWidget * parent, I
     _waitingDialog->show();
     connect(_waitingDialog, SIGNAL(canceled()), this, SLOT(onCancel()));
 
+    // The tree will be updated once all divisions are created
+    sm->beginBatch(_idNewInst.indexSf2);
+
     // For each division
     foreach (DivisionInfo di, dis)
     {
@@ -207,6 +210,7 @@ void ToolMixtureCreation::onElementProcessed(EltID idSmpl, int key, int minKey,
     {
         delete _waitingDialog;
         _waitingDialog = nullptr;
+        sm->endBatch(_idNewInst.indexSf2);
         if (_canceled)
         {
             SoundfontManager::getInstance()->revertNewEditing();
@@ -92,10 +92,10 @@ void ToolSampleExport::process(SoundfontManager * sm, EltID id, AbstractToolPara
             id2 = idTmp;
         }
 
-        writer.write(sm->getSound(id), sm->getSound(id2));
+        writer.write(sm->getSound(id).data(), sm->getSound(id2).data());
     }
     else
-        writer.write(sm->getSound(id));
+        writer.write(sm->getSound(id).data());
 }
 
 QString ToolSampleExport::getFilePath(SoundfontManager * sm, EltID id1, EltID id2, bool isStereo)
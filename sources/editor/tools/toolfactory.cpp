@@ -34,6 +34,7 @@
 #include "change_volume/toolchangevolume.h"
 #include "balance_adjustment/toolbalanceadjustment.h"
 #include "transpose_smpl/tooltransposesmpl.h"
+#include "auto_tune/toolautotune.h"
 #include "link_sample/toollinksample.h"
 #include "unlink_sample/toolunlinksample.h"
 #include "change_attenuation/toolchangeattenuation.h"
@@ -89,6 +90,7 @@ void ToolFactory::initialize()
            << new ToolChangeVolume()
            << new ToolBalanceAdjustment()
            << new ToolTransposeSmpl()
+           << new ToolAutoTune()
            << new ToolLinkSample()
            << new ToolUnlinkSample()
            << new ToolSampleExport()
@@ -175,6 +175,7 @@ void TreeView::keyPressEvent(QKeyEvent * event)
         else
         {
             SoundfontManager * sm = SoundfontManager::getInstance();
+            sm->beginBatch(_dropDestID.indexSf2);
             Duplicator duplicator;
             IdList newIds;
             foreach (EltID idSource, _draggedIds)
@@ -187,6 +188,7 @@ void TreeView::keyPressEvent(QKeyEvent * event)
                         newIds << id;
                 }
             }
+            sm->endBatch(_dropDestID.indexSf2);
 
             if (!newIds.isEmpty())
             {
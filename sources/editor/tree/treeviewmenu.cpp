@@ -219,6 +219,7 @@ void TreeViewMenu::associate(IdList ids, EltID idDest)
 
     // For each element to associate
     SoundfontManager * sm = SoundfontManager::getInstance();
+    sm->beginBatch(idDest.indexSf2);
     Duplicator duplicator;
     if (idDest.typeElement == elementInst)
     {
@@ -271,6 +272,7 @@ void TreeViewMenu::associate(IdList ids, EltID idDest)
         foreach (EltID idSrc, ids)
             duplicator.copy(idSrc, idDest);
     }
+    sm->endBatch(idDest.indexSf2);
     sm->endEditing("command:associate");
 
     // Select the parent element of all children that have been linked
@@ -537,6 +539,7 @@ void TreeViewMenu::paste()
 
         // Paste all copied elements
         SoundfontManager * sm = SoundfontManager::getInstance();
+        sm->beginBatch(idDest.indexSf2);
         Duplicator duplicator;
         IdList newIds;
         foreach (EltID idSource, s_copy)
@@ -549,6 +552,7 @@ void TreeViewMenu::paste()
                     newIds << id;
             }
         }
+        sm->endBatch(idDest.indexSf2);
 
         if (!newIds.isEmpty())
         {
@@ -565,6 +569,7 @@ void TreeViewMenu::duplicate()
 
     // Duplicate all elements
     SoundfontManager * sm = SoundfontManager::getInstance();
+    sm->beginBatch(_currentIds[0].indexSf2);
     Duplicator duplicator;
     IdList newIds;
     foreach (EltID idSource, _currentIds)
@@ -576,6 +581,7 @@ void TreeViewMenu::duplicate()
                 newIds << id;
         }
     }
+    sm->endBatch(_currentIds[0].indexSf2);
 
     if (!newIds.isEmpty())
     {
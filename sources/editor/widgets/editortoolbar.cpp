@@ -33,7 +33,6 @@
 #include <QMessageBox>
 #include <QFileDialog>
 #include "tabmanager.h"
-#include "outputfactory.h"
 #include "dialognewelement.h"
 #include "utils.h"
 #include "tools/auto_distribution/toolautodistribution.h"
@@ -509,7 +508,7 @@ void EditorToolBar::on_pushSave_clicked()
     // Remove the focus from the interface (so that all changes are taken into account)
     this->setFocus();
 
-    OutputFactory::save(TabManager::getInstance()->getCurrentSf2(), false);
+    TabManager::getInstance()->save(TabManager::getInstance()->getCurrentSf2(), false);
 }
 
 void EditorToolBar::onMidiExtensionActionClicked()
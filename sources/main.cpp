@@ -34,6 +34,9 @@
 #include "outputfactory.h"
 #include "abstractoutput.h"
 #include "options.h"
+#include "batchconversion.h"
+#include "benchmark.h"
+#include "audioregression.h"
 #include "contextmanager.h"
 #include "qtsingleapplication.h"
 #include "mainwindow.h"
@@ -242,6 +245,12 @@ int main(int argc, char *argv[])
         valRet = displayHelp(options);
     else if (options.mode() == Options::MODE_RESET_CONFIG)
         valRet = resetConfig(options);
+    else if (options.batch())
+        valRet = BatchConversion(&options).process();
+    else if (options.mode() == Options::MODE_BENCHMARK)
+        valRet = Benchmark(&options).process();
+    else if (options.mode() == Options::MODE_REGRESSION)
+        valRet = AudioRegression(&options).process();
     else
         valRet = convert(options);
 
@@ -41,8 +41,8 @@
 #include "dialogkeyboard.h"
 #include "dialogrecorder.h"
 #include "editortoolbar.h"
-#include "outputfactory.h"
 #include "inputfactory.h"
+#include "abstractinputparser.h"
 #include "extensionmanager.h"
 #include "utils.h"
 #include "playeroptions.h"
@@ -60,6 +60,9 @@ MainWindow::MainWindow(bool playerMode, QWidget *parent) :
     ///////////
 
     ContextManager::s_playerMode = playerMode;
+    AbstractInputParser::s_loadAllSamples = playerMode;
+    SoundfontManager::getInstance()->setUndoMemoryBudget(ContextManager::configuration()->getValue(
+                                                             ConfManager::SECTION_NONE, "undo_memory_mb", 512).toLongLong() * 1024 * 1024);
     ui->setupUi(this);
     this->setWindowTitle(tr("Polyphone SoundFont Editor"));
     this->setWindowIcon(QIcon(":/misc/polyphone.png"));
@@ -245,7 +248,7 @@ void MainWindow::closeEvent(QCloseEvent *event)
             foreach (int i, nbSf2)
             {
                 id.indexSf2 = i;
-                if (sm->isEdited(i) && !OutputFactory::save(i, false))
+                if (sm->isEdited(i) && !_tabManager->save(i, false))
                 {
                     event->ignore();
                     return;
@@ -434,7 +437,7 @@ void MainWindow::onSave()
     // Remove the focus from the interface (so that all changes are taken into account)
     this->setFocus();
 
-    OutputFactory::save(_tabManager->getCurrentSf2(), false);
+    _tabManager->save(_tabManager->getCurrentSf2(), false);
 }
 
 void MainWindow::onSaveAs()
@@ -442,7 +445,7 @@ void MainWindow::onSaveAs()
     // Remove the focus from the interface (so that all changes are taken into account)
     this->setFocus();
 
-    OutputFactory::save(_tabManager->getCurrentSf2(), true);
+    _tabManager->save(_tabManager->getCurrentSf2(), true);
 }
 
 void MainWindow::onUserClicked()
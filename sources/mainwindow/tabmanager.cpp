@@ -26,6 +26,7 @@
 #include <QMessageBox>
 #include <QAbstractButton>
 #include <QApplication>
+#include <QFileDialog>
 #include "tabmanager.h"
 #include "contextmanager.h"
 #include "configpanel.h"
@@ -40,6 +41,7 @@
 #include "userarea.h"
 #include "inputfactory.h"
 #include "outputfactory.h"
+#include "abstractoutput.h"
 #include "repositorymanager.h"
 #include "utils.h"
 #include "synth.h"
@@ -243,7 +245,7 @@ void TabManager::onTabCloseRequested(QWidget * widget)
         case QMessageBox::Cancel:
             return;
         case QMessageBox::Save:
-            if (!OutputFactory::save(id.indexSf2, false))
+            if (!save(id.indexSf2, false))
                 return;
             break;
         case QMessageBox::Discard:
@@ -363,3 +365,73 @@ void TabManager::setCurrentWidget(QWidget * widget)
     if (widget != nullptr)
         _stackedWidget->setCurrentWidget(widget);
 }
+
+bool TabManager::save(int indexSf2, bool saveAs)
+{
+    // Check that the soundfont is valid
+    SoundfontManager * sm = SoundfontManager::getInstance();
+    EltID id(elementSf2, indexSf2);
+    if (indexSf2 == -1 || !sm->isValid(id))
+        return false;
+
+    // Don't go further if the file is already saved
+    if (!sm->isEdited(id.indexSf2) && !saveAs)
+        return false;
+
+    // Path of the file for saving the soundfont
+    QString savePath;
+    QString filePathInitial = sm->getQstr(id, champ_filenameInitial);
+    QString filePathForData = sm->getQstr(id, champ_filenameForData);
+    if (saveAs || !filePathInitial.toLower().endsWith(".sf2") ||
+            filePathInitial != filePathForData || filePathInitial.isEmpty())
+    {
+        // Default path for selecting the destination
+        QString defaultPath;
+        if (filePathInitial.isEmpty())
+        {
+            // A new file is to be saved, the path is based on the internal name and the recent files
+            QString currentName = sm->getQstr(id, champ_name);
+            if (currentName.isEmpty())
+                currentName = QObject::tr("untitled");
+            defaultPath = ContextManager::recentFile()->getLastDirectory(RecentFileManager::FILE_TYPE_SOUNDFONT) + "/" + currentName + ".sf2";
+        }
+        else if (filePathInitial != filePathForData || !filePathInitial.toLower().endsWith(".sf2"))
+        {
+            // The soundfont to be saved was imported => the path is based on the initial file with another extension
+            QFileInfo fi(filePathInitial);
+            defaultPath = fi.absolutePath() + "/" + fi.completeBaseName() + ".sf2";
+        }
+        else
+            defaultPath = filePathInitial;
+
+        // Dialog for choosing a destination
+        savePath = QFileDialog::getSaveFileName(QApplication::activeWindow(), QObject::tr("Save a soundfont"),
+                                                defaultPath, QObject::tr("Sf2 files") + " (*.sf2)");
+        if (savePath.isNull())
+            return false;
+
+        if (!savePath.endsWith(".sf2"))
+            savePath += ".sf2";
+    }
+    else
+        savePath = filePathInitial;
+
+    AbstractOutput * output = OutputFactory::getOutput(savePath);
+    output->process(id.indexSf2, false);
+
+    bool success = output->isSuccess();
+    if (success)
+    {
+        // Possibly delete a temporary file
+        if (filePathInitial != filePathForData && !filePathForData.isEmpty())
+            QFile::remove(filePathForData);
+
+        // New recent file
+        ContextManager::recentFile()->addRecentFile(RecentFileManager::FILE_TYPE_SOUNDFONT, savePath);
+    }
+    else
+        QMessageBox::warning(QApplication::activeWindow(), QObject::tr("Warning"), output->getError());
+    delete output;
+
+    return success;
+}
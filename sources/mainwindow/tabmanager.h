@@ -48,6 +48,9 @@ public:
     void showHome();
     void setCurrentWidget(QWidget * widget);
 
+    /// Save a soundfont in the sf2 format, a destination being asked if needed
+    bool save(int indexSf2, bool saveAs);
+
 public slots:
     /// Open the configuration
     void openConfiguration();
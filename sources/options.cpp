@@ -34,6 +34,11 @@ Options::Options(int argc, char *argv[]) :
     _mode(MODE_GUI),
     _error(false),
     _help(false),
+    _batch(false),
+    _jobNumber(0),
+    _regressionRecord(false),
+    _peakTolerance(0.0001),
+    _spectralTolerance(0.1),
     _sf3Quality(1),
     _sfzPresetPrefix(false),
     _sfzOneDirPerBank(false),
@@ -111,6 +116,15 @@ void Options::processType1(QString arg)
     case 'c':
         _currentState = STATE_CONFIG;
         break;
+    case 'b':
+        _batch = true;
+        break;
+    case 'j':
+        _currentState = STATE_JOB_NUMBER;
+        break;
+    case 'l':
+        _currentState = STATE_SUMMARY_FILE;
+        break;
     case 'h':
         _help = true;
         break;
@@ -120,6 +134,12 @@ void Options::processType1(QString arg)
     case 's':
         _mode = MODE_SYNTHESIZER;
         break;
+    case 'p':
+        _mode = MODE_BENCHMARK;
+        break;
+    case 'g':
+        _mode = MODE_REGRESSION;
+        break;
     default:
         _error = true;
         break;
@@ -141,6 +161,17 @@ void Options::processType2(QString arg)
         _outputFile = arg;
         _currentState = STATE_NONE; // no more output
         break;
+    case STATE_JOB_NUMBER: {
+        bool ok;
+        _jobNumber = arg.toInt(&ok);
+        if (!ok || _jobNumber <= 0)
+            _error = true;
+        _currentState = STATE_NONE;
+    } break;
+    case STATE_SUMMARY_FILE:
+        _summaryFile = arg;
+        _currentState = STATE_NONE;
+        break;
     case STATE_CONFIG:
         if (_mode == MODE_CONVERSION_TO_SFZ)
         {
@@ -190,6 +221,24 @@ void Options::processType2(QString arg)
             else
                 _error = true;
         }
+        else if (_mode == MODE_REGRESSION)
+        {
+            // Either "record" or the tolerances "peak/spectral"
+            if (arg == "record")
+                _regressionRecord = true;
+            else
+            {
+                QStringList split = arg.split('/');
+                bool ok1 = false, ok2 = false;
+                if (split.count() == 2)
+                {
+                    _peakTolerance = split[0].toDouble(&ok1);
+                    _spectralTolerance = split[1].toDouble(&ok2);
+                }
+                if (!ok1 || !ok2 || _peakTolerance < 0 || _spectralTolerance < 0)
+                    _error = true;
+            }
+        }
         else
             _error = true;
         break;
@@ -201,6 +250,22 @@ void Options::processType2(QString arg)
 
 void Options::checkErrors()
 {
+    if (_batch)
+    {
+        // Inputs are checked during the conversion, at least one is required and the output name is deduced from each file
+        if ((_mode != MODE_CONVERSION_TO_SF2 && _mode != MODE_CONVERSION_TO_SF3 && _mode != MODE_CONVERSION_TO_SFZ) ||
+                _inputFiles.empty() || _outputFile != "")
+            _error = true;
+        return;
+    }
+
+    // Options specific to the batch mode (the benchmark and the regression tests also write their results in a file)
+    if (_jobNumber != 0 || (_summaryFile != "" && _mode != MODE_BENCHMARK && _mode != MODE_REGRESSION))
+    {
+        _error = true;
+        return;
+    }
+
     // Input files
     foreach (QString inputFile, _inputFiles)
     {
@@ -216,7 +281,7 @@ void Options::checkErrors()
     case MODE_RESET_CONFIG:
         _error = false;
         break;
-    case MODE_GUI: case MODE_SYNTHESIZER:
+    case MODE_GUI: case MODE_SYNTHESIZER: case MODE_BENCHMARK:
         if (_outputDirectory != "" || _outputFile != "")
             _error = true;
         break;
@@ -224,12 +289,18 @@ void Options::checkErrors()
         if (_inputFiles.count() != 1)
             _error = true;
         break;
+    case MODE_REGRESSION:
+        // The directory contains the references
+        if (!_inputFiles.empty() || _outputDirectory == "" || _outputFile != "")
+            _error = true;
+        break;
     }
 }
 
 void Options::postTreatment()
 {
-    if (_mode == MODE_CONVERSION_TO_SF2 || _mode == MODE_CONVERSION_TO_SF3 || _mode == MODE_CONVERSION_TO_SFZ)
+    // In batch mode, an empty output directory means the directory of each input file
+    if (!_batch && (_mode == MODE_CONVERSION_TO_SF2 || _mode == MODE_CONVERSION_TO_SF3 || _mode == MODE_CONVERSION_TO_SFZ))
     {
         // By default, the output directory is the same than the input file directory
         if (_outputDirectory == "")
@@ -247,7 +318,11 @@ QString Options::getOutputFileFullPath()
     if (!strTmp.endsWith('/'))
         strTmp += '/';
 
-    // Extension
+    return strTmp + _outputFile + getOutputExtension();
+}
+
+QString Options::getOutputExtension()
+{
     QString extension = "";
     switch (_mode)
     {
@@ -264,7 +339,7 @@ QString Options::getOutputFileFullPath()
         break;
     }
 
-    return strTmp + _outputFile + extension;
+    return extension;
 }
 
 QString Options::getInputFilesAsString()
@@ -38,7 +38,9 @@ public:
         MODE_CONVERSION_TO_SF2 = 1,
         MODE_CONVERSION_TO_SF3 = 2,
         MODE_CONVERSION_TO_SFZ = 3,
-        MODE_SYNTHESIZER = 4
+        MODE_SYNTHESIZER = 4,
+        MODE_BENCHMARK = 5,
+        MODE_REGRESSION = 6
     };
 
     Options(int argc, char *argv[]);
@@ -56,12 +58,33 @@ public:
     /// Return the full path of the output file
     QString getOutputFileFullPath();
 
+    /// Return the extension of the output files, dot included (in case of a conversion)
+    QString getOutputExtension();
+
     /// Return the output file (in case of a conversion)
     QString getOutputDirectory() { return _outputDirectory; }
 
     /// Return the mode describing how the executable will be used
     Mode mode() { return _mode; }
 
+    /// Batch option: input files are directories, wildcard patterns or lists of files to convert
+    bool batch() { return _batch; }
+
+    /// Batch option: number of simultaneous conversions (0 is automatic)
+    int jobNumber() { return _jobNumber; }
+
+    /// Batch and benchmark option: path of the JSON summary or results (may be empty)
+    QString getSummaryFile() { return _summaryFile; }
+
+    /// Regression option: record the references instead of comparing with them
+    bool regressionRecord() { return _regressionRecord; }
+
+    /// Regression option: maximum difference between a sample and its reference
+    double peakTolerance() { return _peakTolerance; }
+
+    /// Regression option: maximum spectral distance with the reference, in dB
+    double spectralTolerance() { return _spectralTolerance; }
+
     /// Sfz option: preset number as prefix
     bool sfzPresetPrefix() { return _sfzPresetPrefix; }
 
@@ -90,6 +113,8 @@ private:
         STATE_OUTPUT_FILE,
         STATE_OUTPUT_DIRECTORY,
         STATE_CONFIG,
+        STATE_JOB_NUMBER,
+        STATE_SUMMARY_FILE,
         STATE_NONE
     };
 
@@ -104,6 +129,16 @@ private:
     Mode _mode;
     bool _error, _help;
 
+    // Batch options
+    bool _batch;
+    int _jobNumber;
+    QString _summaryFile;
+
+    // Regression options
+    bool _regressionRecord;
+    double _peakTolerance;
+    double _spectralTolerance;
+
     // Sf3 option
     int _sf3Quality;
 
@@ -0,0 +1,48 @@
+#-------------------------------------------------
+#
+# Engine of Polyphone as a static library, without the editor:
+# model, inputs / outputs, samples and synth (see core/polyphonecore.h)
+# Only QtCore is required so that the engine can be embedded in headless processes
+#
+#-------------------------------------------------
+
+# Use a local copy of the Stk library
+# (this is forced to true for Windows or Mac OS X)
+#DEFINES += USE_LOCAL_STK
+
+# Uncomment this line to use wolfssl instead of openssl
+#DEFINES += USE_WOLFSSL
+
+QMAKE_CXXFLAGS += -std=c++17
+
+QT = core
+TARGET = polyphone-core
+TEMPLATE = lib
+CONFIG += staticlib
+
+win32 {
+    # Compiler must be MinGW for the option -ffloat-store, required by sfArk
+    DEFINES += USE_LOCAL_STK
+    INCLUDEPATH += ../lib_windows/include
+    QMAKE_CXXFLAGS += -ffloat-store
+    DESTDIR = $$PWD/../lib_windows/64bits
+}
+unix:!macx {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += zlib ogg flac vorbis vorbisfile vorbisenc
+    contains(DEFINES, USE_WOLFSSL) {
+        PKGCONFIG += wolfssl
+    } else {
+        PKGCONFIG += openssl
+    }
+    DESTDIR = bin
+}
+macx {
+    QMAKE_MACOSX_DEPLOYMENT_TARGET = 10.13
+    DEFINES += USE_LOCAL_STK
+    INCLUDEPATH += ../lib_mac/include
+    DESTDIR = $$PWD/../lib_mac
+}
+DEFINES += SFTOOLS_NOXML
+
+include(core/core.pri)
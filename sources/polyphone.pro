@@ -153,31 +153,8 @@ contains(DEFINES, USE_LOCAL_RTMIDI) {
     PKGCONFIG += rtmidi
 }
 
-# Location of Stk
-contains(DEFINES, USE_LOCAL_STK) {
-    INCLUDEPATH += lib/_option_stk
-    HEADERS += lib/_option_stk/stk/Stk.h \
-        lib/_option_stk/stk/SineWave.h \
-        lib/_option_stk/stk/OnePole.h \
-        lib/_option_stk/stk/Generator.h \
-        lib/_option_stk/stk/Filter.h \
-        lib/_option_stk/stk/Effect.h \
-        lib/_option_stk/stk/Delay.h \
-        lib/_option_stk/stk/Chorus.h \
-        lib/_option_stk/stk/FreeVerb.h \
-        lib/_option_stk/stk/DelayL.h \
-        lib/_option_stk/stk/Iir.h
-    SOURCES += lib/_option_stk/stk/Stk.cpp \
-        lib/_option_stk/stk/SineWave.cpp \
-        lib/_option_stk/stk/OnePole.cpp \
-        lib/_option_stk/stk/Delay.cpp \
-        lib/_option_stk/stk/Chorus.cpp \
-        lib/_option_stk/stk/FreeVerb.cpp \
-        lib/_option_stk/stk/DelayL.cpp \
-        lib/_option_stk/stk/Iir.cpp
-} else {
-    LIBS += -lstk
-}
+# Engine (model, inputs / outputs, samples, synth), shared with polyphone-core.pro
+include(core/core.pri)
 
 INCLUDEPATH += lib \
     mainwindow \
@@ -193,15 +170,7 @@ INCLUDEPATH += lib \
     editor/widgets \
     editor/tree \
     resources \
-    core \
-    core/input \
-    core/output \
-    core/model \
-    core/sample \
-    core/types \
     clavier \
-    sound_engine \
-    sound_engine/elements \
     repository \
     repository/browser \
     repository/daily \
@@ -216,50 +185,12 @@ INCLUDEPATH += lib \
     .
 
 SOURCES	+= main.cpp \
-    core/input/grandorgue/grandorguedatathrough.cpp \
-    core/input/grandorgue/grandorgueranklink.cpp \
-    core/input/grandorgue/grandorgueswitch.cpp \
-    core/input/sfz/sfzparametergroup.cpp \
-    core/input/sfz/sfzparameterregion.cpp \
-    core/output/sfz/balanceparameters.cpp \
-    core/output/sfz/sfzwriter.cpp \
-    core/sample/samplereaderogg.cpp \
-    core/solomanager.cpp \
-    core/input/abstractinputparser.cpp \
-    core/input/empty/inputparserempty.cpp \
-    core/input/grandorgue/grandorguepipe.cpp \
-    core/input/grandorgue/grandorguerank.cpp \
-    core/input/grandorgue/grandorguestop.cpp \
-    core/input/grandorgue/inputgrandorgue.cpp \
-    core/input/grandorgue/inputparsergrandorgue.cpp \
-    core/input/not_supported/inputparsernotsupported.cpp \
-    core/input/sf2/inputparsersf2.cpp \
-    core/input/sf2/inputsf2.cpp \
-    core/input/sf3/inputparsersf3.cpp \
-    core/input/sf3/inputsf3.cpp \
-    core/input/sfark/inputparsersfark.cpp \
-    core/input/sfark/inputsfark.cpp \
-    core/input/sfz/inputparsersfz.cpp \
-    core/input/sfz/inputsfz.cpp \
-    core/sample/samplereaderfactory.cpp \
-    core/sample/samplereaderflac.cpp \
-    core/sample/samplereadersf2.cpp \
-    core/sample/samplereaderwav.cpp \
-    core/sample/sampleutils.cpp \
-    core/sample/samplewriterwav.cpp \
-    core/sample/sound.cpp \
     core/sample/sampleloader.cpp \
     core/duplicator.cpp \
-    core/types/serializabletypes.cpp \
-    core/utils.cpp \
-    core/input/sfark/sfarkglobal.cpp \
-    core/input/sfark/sfarkfilemanager.cpp \
-    core/output/sfz/conversion_sfz.cpp \
     context/contextmanager.cpp \
     context/thememanager.cpp \
     context/confmanager.cpp \
     context/recentfilemanager.cpp \
-    context/keynamemanager.cpp \
     context/translationmanager.cpp \
     context/interface/editkey.cpp \
     context/audiodevice.cpp \
@@ -334,18 +265,11 @@ SOURCES	+= main.cpp \
     repository/soundfont/editor/htmleditor.cpp \
     repository/soundfont/editor/soundfonteditorfiles.cpp \
     repository/soundfont/editor/soundfontfilecell.cpp \
-    sound_engine/elements/liveeq.cpp \
-    sound_engine/elements/osctriangle.cpp \
-    sound_engine/modulatedparameter.cpp \
-    sound_engine/synth.cpp \
-    sound_engine/voice.cpp \
-    sound_engine/voiceparam.cpp \
-    sound_engine/soundengine.cpp \
-    sound_engine/elements/calibrationsinus.cpp \
-    sound_engine/elements/enveloppevol.cpp \
-    sound_engine/elements/oscsinus.cpp \
-    lib/sf3/sfont.cpp \
     options.cpp \
+    batchconversion.cpp \
+    benchmark.cpp \
+    audioregression.cpp \
+    testbank.cpp \
     mainwindow/widgetshowhistory.cpp \
     mainwindow/widgetshowhistorycell.cpp \
     mainwindow/mainwindow.cpp \
@@ -371,36 +295,12 @@ SOURCES	+= main.cpp \
     editor/pagesf2.cpp \
     editor/pageprst.cpp \
     editor/pagesmpl.cpp \
-    core/types/idlist.cpp \
-    core/soundfontmanager.cpp \
-    core/actionmanager.cpp \
-    core/model/soundfont.cpp \
-    core/model/division.cpp \
-    core/model/smpl.cpp \
-    core/model/instprst.cpp \
-    core/model/soundfonts.cpp \
-    core/model/treemodel.cpp \
-    core/model/treeitemfirstlevel.cpp \
-    core/model/treeitemroot.cpp \
     editor/tree/treeview.cpp \
     editor/tree/treeitemdelegate.cpp \
     editor/widgets/backgroundwidget.cpp \
     editor/tree/treesortfilterproxy.cpp \
-    core/model/treeitem.cpp \
     editor/widgets/styledaction.cpp \
-    core/actionset.cpp \
-    core/action.cpp \
     editor/widgets/styledlineedit.cpp \
-    core/input/inputfactory.cpp \
-    core/input/sf2/sf2header.cpp \
-    core/input/sf2/sf2sdtapart.cpp \
-    core/input/sf2/sf2pdtapart.cpp \
-    core/input/sf2/sf2pdtapart_phdr.cpp \
-    core/input/sf2/sf2pdtapart_inst.cpp \
-    core/input/sf2/sf2pdtapart_shdr.cpp \
-    core/input/sf2/sf2pdtapart_mod.cpp \
-    core/input/sf2/sf2pdtapart_gen.cpp \
-    core/input/sf2/sf2pdtapart_bag.cpp \
     editor/widgets/linkedtowidget.cpp \
     editor/tools/abstracttool.cpp \
     editor/tools/toolfactory.cpp \
@@ -422,6 +322,8 @@ SOURCES	+= main.cpp \
     editor/tools/change_volume/toolchangevolume_parameters.cpp \
     editor/tools/change_volume/toolchangevolume_gui.cpp \
     editor/tools/balance_adjustment/toolbalanceadjustment.cpp \
+    editor/tools/auto_tune/toolautotune.cpp \
+    editor/tools/auto_tune/pitchdetection.cpp \
     editor/tools/transpose_smpl/tooltransposesmpl.cpp \
     editor/tools/transpose_smpl/tooltransposesmpl_parameters.cpp \
     editor/tools/transpose_smpl/tooltransposesmpl_gui.cpp \
@@ -437,9 +339,6 @@ SOURCES	+= main.cpp \
     editor/tools/global_settings/toolglobalsettings_gui.cpp \
     editor/tools/global_settings/toolglobalsettings_parameters.cpp \
     editor/tools/global_settings/graphparamglobal.cpp \
-    core/types/eltid.cpp \
-    core/types/complex.cpp \
-    core/types/attribute.cpp \
     editor/tools/celeste_tuning/toolcelestetuning.cpp \
     editor/tools/celeste_tuning/toolcelestetuning_gui.cpp \
     editor/tools/celeste_tuning/toolcelestetuning_parameters.cpp \
@@ -485,16 +384,6 @@ SOURCES	+= main.cpp \
     editor/tools/soundfont_export/toolsoundfontexport_gui.cpp \
     editor/tools/soundfont_export/toolsoundfontexport_parameters.cpp \
     editor/tools/abstracttoolonestep.cpp \
-    core/output/abstractoutput.cpp \
-    core/output/outputfactory.cpp \
-    core/output/empty/outputdummy.cpp \
-    core/output/sf2/outputsf2.cpp \
-    core/output/sfz/outputsfz.cpp \
-    core/output/not_supported/outputnotsupported.cpp \
-    core/output/sfz/sfzparamlist.cpp \
-    core/output/sf2/sf2indexconverter.cpp \
-    core/output/sf3/outputsf3.cpp \
-    core/input/sfz/sfzparameter.cpp \
     dialogs/dialogcreateelements.cpp \
     editor/widgets/tableheaderview.cpp \
     context/interface/configtoc.cpp \
@@ -537,20 +426,12 @@ SOURCES	+= main.cpp \
     editor/modulator/modulatorcombosrc.cpp \
     clavier/controllerarea.cpp \
     clavier/combocc.cpp \
-    lib/iir/Biquad.cpp \
-    lib/iir/Butterworth.cpp \
-    lib/iir/Cascade.cpp \
-    lib/iir/PoleFilter.cpp \
-    lib/iir/State.cpp \
     editor/widgets/spinboxcents.cpp \
-    sound_engine/parametermodulator.cpp \
-    sound_engine/modulatorgroup.cpp \
     editor/modulator/modulatorlistwidget.cpp \
     clavier/styledslider.cpp \
     editor/tools/default_mod/tooldefaultmod.cpp \
     editor/tools/default_mod/tooldefaultmod_parameters.cpp \
     editor/tools/default_mod/tooldefaultmod_gui.cpp \
-    core/types/modulatordata.cpp \
     repository/soundfont/editor/editordialoginsertvideo.cpp \
     repository/soundfont/editor/editordialoginsertimage.cpp \
     dialogs/dialogquestion.cpp \
@@ -565,60 +446,16 @@ SOURCES	+= main.cpp \
     lib/qtsingleapplication/qtsingleapplication.cpp \
     editor/tools/load_from_inst/toolloadfrominst.cpp \
     editor/tools/load_from_inst/toolloadfrominst_gui.cpp \
-    editor/tools/load_from_inst/toolloadfrominst_parameters.cpp \
-    core/input/sfark/sfarkextractor1.cpp \
-    core/input/sfark/sfarkextractor2.cpp
+    editor/tools/load_from_inst/toolloadfrominst_parameters.cpp
 
 HEADERS += \
     context/imidilistener.h \
-    core/input/grandorgue/grandorguedatathrough.h \
-    core/input/grandorgue/grandorgueranklink.h \
-    core/input/grandorgue/grandorgueswitch.h \
-    core/input/sfz/sfzparametergroup.h \
-    core/input/sfz/sfzparameterregion.h \
-    core/output/sfz/balanceparameters.h \
-    core/output/sfz/sfzwriter.h \
-    core/sample/samplereaderogg.h \
-    core/solomanager.h \
-    core/input/abstractinput.h \
-    core/input/abstractinputparser.h \
-    core/input/empty/inputparserempty.h \
-    core/input/grandorgue/grandorguepipe.h \
-    core/input/grandorgue/grandorguerank.h \
-    core/input/grandorgue/grandorguestop.h \
-    core/input/grandorgue/inputgrandorgue.h \
-    core/input/grandorgue/inputparsergrandorgue.h \
-    core/input/not_supported/inputparsernotsupported.h \
-    core/input/sf2/inputparsersf2.h \
-    core/input/sf2/inputsf2.h \
-    core/input/sf3/inputparsersf3.h \
-    core/input/sf3/inputsf3.h \
-    core/input/sfark/inputparsersfark.h \
-    core/input/sfark/inputsfark.h \
-    core/input/sfz/inputparsersfz.h \
-    core/input/sfz/inputsfz.h \
-    core/sample/infosound.h \
-    core/sample/samplereader.h \
-    core/sample/samplereaderfactory.h \
-    core/sample/samplereaderflac.h \
-    core/sample/samplereadersf2.h \
-    core/sample/samplereaderwav.h \
-    core/sample/sampleutils.h \
-    core/sample/samplewriterwav.h \
-    core/sample/sound.h \
     core/sample/sampleloader.h \
     core/duplicator.h \
-    core/types/serializabletypes.h \
-    core/utils.h \
-    core/input/sfark/sfarkglobal.h \
-    core/input/sfark/sfarkfilemanager.h \
-    core/input/sfark/sfarkextractor1.h \
-    core/output/sfz/conversion_sfz.h \
     context/contextmanager.h \
     context/thememanager.h \
     context/confmanager.h \
     context/recentfilemanager.h \
-    context/keynamemanager.h \
     context/translationmanager.h \
     context/interface/editkey.h \
     context/mididevice.h \
@@ -699,19 +536,11 @@ HEADERS += \
     repository/soundfont/editor/htmleditor.h \
     repository/soundfont/editor/soundfonteditorfiles.h \
     repository/soundfont/editor/soundfontfilecell.h \
-    sound_engine/elements/liveeq.h \
-    sound_engine/elements/osctriangle.h \
-    sound_engine/imidivalues.h \
-    sound_engine/modulatedparameter.h \
-    sound_engine/synth.h \
-    sound_engine/voice.h \
-    sound_engine/voiceparam.h \
-    sound_engine/soundengine.h \
-    sound_engine/elements/calibrationsinus.h \
-    sound_engine/elements/enveloppevol.h \
-    sound_engine/elements/oscsinus.h \
-    lib/sf3/sfont.h \
     options.h \
+    batchconversion.h \
+    benchmark.h \
+    audioregression.h \
+    testbank.h \
     mainwindow/widgetshowhistory.h \
     mainwindow/widgetshowhistorycell.h \
     mainwindow/mainwindow.h \
@@ -737,37 +566,12 @@ HEADERS += \
     editor/pageprst.h \
     editor/pagesf2.h \
     editor/pagesmpl.h \
-    core/types/idlist.h \
-    core/soundfontmanager.h \
-    core/actionmanager.h \
-    core/model/soundfont.h \
-    core/model/division.h \
-    core/model/modulator.h \
-    core/model/smpl.h \
-    core/model/instprst.h \
-    core/model/soundfonts.h \
-    core/model/treeitem.h \
-    core/model/treemodel.h \
-    core/model/treeitemfirstlevel.h \
-    core/model/treeitemroot.h \
     editor/tree/treeview.h \
     editor/tree/treeitemdelegate.h \
     editor/widgets/backgroundwidget.h \
     editor/tree/treesortfilterproxy.h \
     editor/widgets/styledaction.h \
-    core/actionset.h \
-    core/action.h \
     editor/widgets/styledlineedit.h \
-    core/input/inputfactory.h \
-    core/input/sf2/sf2header.h \
-    core/input/sf2/sf2sdtapart.h \
-    core/input/sf2/sf2pdtapart.h \
-    core/input/sf2/sf2pdtapart_phdr.h \
-    core/input/sf2/sf2pdtapart_inst.h \
-    core/input/sf2/sf2pdtapart_shdr.h \
-    core/input/sf2/sf2pdtapart_mod.h \
-    core/input/sf2/sf2pdtapart_gen.h \
-    core/input/sf2/sf2pdtapart_bag.h \
     repository/widgets/elidedlabel.h \
     editor/widgets/linkedtowidget.h \
     editor/tools/abstracttool.h \
@@ -792,6 +596,8 @@ HEADERS += \
     editor/tools/change_volume/toolchangevolume_parameters.h \
     editor/tools/change_volume/toolchangevolume_gui.h \
     editor/tools/balance_adjustment/toolbalanceadjustment.h \
+    editor/tools/auto_tune/toolautotune.h \
+    editor/tools/auto_tune/pitchdetection.h \
     editor/tools/transpose_smpl/tooltransposesmpl.h \
     editor/tools/transpose_smpl/tooltransposesmpl_parameters.h \
     editor/tools/transpose_smpl/tooltransposesmpl_gui.h \
@@ -809,10 +615,6 @@ HEADERS += \
     editor/tools/global_settings/toolglobalsettings_gui.h \
     editor/tools/global_settings/toolglobalsettings_parameters.h \
     editor/tools/global_settings/graphparamglobal.h \
-    core/types/eltid.h \
-    core/types/complex.h \
-    core/types/attribute.h \
-    core/types/basetypes.h \
     editor/tools/celeste_tuning/toolcelestetuning.h \
     editor/tools/celeste_tuning/toolcelestetuning_gui.h \
     editor/tools/celeste_tuning/toolcelestetuning_parameters.h \
@@ -858,16 +660,6 @@ HEADERS += \
     editor/tools/soundfont_export/toolsoundfontexport_gui.h \
     editor/tools/soundfont_export/toolsoundfontexport_parameters.h \
     editor/tools/abstracttoolonestep.h \
-    core/output/abstractoutput.h \
-    core/output/outputfactory.h \
-    core/output/empty/outputdummy.h \
-    core/output/sf2/outputsf2.h \
-    core/output/sfz/outputsfz.h \
-    core/output/not_supported/outputnotsupported.h \
-    core/output/sfz/sfzparamlist.h \
-    core/output/sf2/sf2indexconverter.h \
-    core/output/sf3/outputsf3.h \
-    core/input/sfz/sfzparameter.h \
     dialogs/dialogcreateelements.h \
     editor/widgets/tableheaderview.h \
     context/interface/configtoc.h \
@@ -902,7 +694,6 @@ HEADERS += \
     repository/downloadmanager.h \
     repository/widgets/downloadprogressbutton.h \
     repository/widgets/downloadprogresscell.h \
-    core/types/indexedelementlist.h \
     editor/overview/sortedtablewidgetitem.h \
     editor/modulator/modulatoreditor.h \
     editor/modulator/modulatorcell.h \
@@ -916,20 +707,7 @@ HEADERS += \
     context/programevent.h \
     clavier/controllerarea.h \
     clavier/combocc.h \
-    lib/iir/Iir_2.h \
-    lib/iir/Biquad.h \
-    lib/iir/Butterworth.h \
-    lib/iir/Cascade.h \
-    lib/iir/Common.h \
-    lib/iir/Layout.h \
-    lib/iir/MathSupplement.h \
-    lib/iir/PoleFilter.h \
-    lib/iir/State.h \
-    lib/iir/Types.h \
     editor/widgets/spinboxcents.h \
-    sound_engine/parametermodulator.h \
-    sound_engine/modulatorgroup.h \
-    core/types/modulatordata.h \
     clavier/styledslider.h \
     editor/tools/default_mod/tooldefaultmod.h \
     editor/tools/default_mod/tooldefaultmod_parameters.h \
@@ -950,9 +728,7 @@ HEADERS += \
     lib/qtsingleapplication/qtsingleapplication.h \
     editor/tools/load_from_inst/toolloadfrominst.h \
     editor/tools/load_from_inst/toolloadfrominst_gui.h \
-    editor/tools/load_from_inst/toolloadfrominst_parameters.h \
-    core/input/sfark/sfarkextractor2.h \
-    core/input/sfark/abstractextractor.h
+    editor/tools/load_from_inst/toolloadfrominst_parameters.h
 
 FORMS += \
     dialogs/dialog_list.ui \
@@ -0,0 +1,105 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "defaultmidivalues.h"
+
+DefaultMidiValues::DefaultMidiValues()
+{
+    for (int channel = 0; channel <= 16; channel++)
+    {
+        for (int i = 0; i < 128; i++)
+        {
+            // Same default values as a MIDI device
+            int defaultValue = 0;
+            switch (i)
+            {
+            case 8: // Balance
+            case 10: // Pan position
+                defaultValue = 64;
+                break;
+            case 7: case 11: // Main volume, expression
+                defaultValue = 127;
+                break;
+            default:
+                break;
+            }
+
+            _controllerValues[channel][i] = defaultValue;
+            _polyPressureValues[channel][i] = 0;
+        }
+        _bendValues[channel] = 0;
+        _bendSensitivityValues[channel] = 2.0f;
+        _monoPressureValues[channel] = 0;
+    }
+}
+
+void DefaultMidiValues::setControllerValue(int channel, int controllerNumber, int value)
+{
+    _controllerValues[channel + 1][controllerNumber] = value;
+}
+
+void DefaultMidiValues::setBendValue(int channel, float value)
+{
+    _bendValues[channel + 1] = value;
+}
+
+void DefaultMidiValues::setBendSensitivityValue(int channel, float semitones)
+{
+    _bendSensitivityValues[channel + 1] = semitones;
+}
+
+void DefaultMidiValues::setMonoPressure(int channel, int value)
+{
+    _monoPressureValues[channel + 1] = value;
+}
+
+void DefaultMidiValues::setPolyPressure(int channel, int key, int value)
+{
+    _polyPressureValues[channel + 1][key] = value;
+}
+
+int DefaultMidiValues::getControllerValue(int channel, int controllerNumber)
+{
+    return _controllerValues[channel + 1][controllerNumber];
+}
+
+float DefaultMidiValues::getBendValue(int channel)
+{
+    return _bendValues[channel + 1];
+}
+
+float DefaultMidiValues::getBendSensitivityValue(int channel)
+{
+    return _bendSensitivityValues[channel + 1];
+}
+
+int DefaultMidiValues::getMonoPressure(int channel)
+{
+    return _monoPressureValues[channel + 1];
+}
+
+int DefaultMidiValues::getPolyPressure(int channel, int key)
+{
+    return _polyPressureValues[channel + 1][key];
+}
@@ -0,0 +1,58 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef DEFAULTMIDIVALUES_H
+#define DEFAULTMIDIVALUES_H
+
+#include "imidivalues.h"
+
+// MIDI values used by the synth when no MIDI device is available (offline rendering)
+// All controllers have their default values until they are changed
+class DefaultMidiValues: public IMidiValues
+{
+public:
+    DefaultMidiValues();
+
+    // Channel is -1 (all channels) or from 0 to 15
+    void setControllerValue(int channel, int controllerNumber, int value);
+    void setBendValue(int channel, float value);
+    void setBendSensitivityValue(int channel, float semitones);
+    void setMonoPressure(int channel, int value);
+    void setPolyPressure(int channel, int key, int value);
+
+    int getControllerValue(int channel, int controllerNumber) override;
+    float getBendValue(int channel) override;
+    float getBendSensitivityValue(int channel) override;
+    int getMonoPressure(int channel) override;
+    int getPolyPressure(int channel, int key) override;
+
+private:
+    int _controllerValues[17][128];
+    float _bendValues[17];
+    float _bendSensitivityValues[17];
+    int _monoPressureValues[17];
+    int _polyPressureValues[17][128];
+};
+
+#endif // DEFAULTMIDIVALUES_H
@@ -301,7 +301,7 @@ int Synth::playSmpl(Soundfont * soundfont, Smpl * smpl, int channel, int key, in
                     InstPrst * prst, Division * prstDiv)
 {
     // Load the sound
-    smpl->_sound.loadInRam();
+    smpl->_sound->loadInRam();
 
     int currentToken = s_sampleVoiceTokenCounter++;
     if (_numberOfVoicesToAdd >= MAX_NUMBER_OF_VOICES_TO_ADD)
@@ -95,8 +95,8 @@ void Voice::initialize(VoiceInitializer * voiceInitializer)
                            voiceInitializer->vel);
 
     _chorusLevel = 0;
-    _baData = voiceInitializer->smpl->_sound.getData();
-    _smplRate = voiceInitializer->smpl->_sound.getUInt32(champ_dwSampleRate);
+    _baData = voiceInitializer->smpl->_sound->getData();
+    _smplRate = voiceInitializer->smpl->_sound->getUInt32(champ_dwSampleRate);
     _audioSmplRate = voiceInitializer->audioSmplRate;
     _gain = 0;
     _token = voiceInitializer->token;
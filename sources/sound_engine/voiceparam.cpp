@@ -171,12 +171,12 @@ void VoiceParam::readSmpl(Smpl *smpl)
 {
     // Read sample properties
     AttributeValue val;
-    val.bValue = smpl->_sound.getUInt32(champ_byOriginalPitch);
+    val.bValue = smpl->_sound->getUInt32(champ_byOriginalPitch);
     _parameters[champ_overridingRootKey].initValue(val, false);
-    _sampleFineTune = smpl->_sound.getInt32(champ_chPitchCorrection);
-    _sampleLength = static_cast<qint32>(smpl->_sound.getUInt32(champ_dwLength));
-    _sampleLoopStart = static_cast<qint32>(smpl->_sound.getUInt32(champ_dwStartLoop));
-    _sampleLoopEnd = static_cast<qint32>(smpl->_sound.getUInt32(champ_dwEndLoop));
+    _sampleFineTune = smpl->_sound->getInt32(champ_chPitchCorrection);
+    _sampleLength = static_cast<qint32>(smpl->_sound->getUInt32(champ_dwLength));
+    _sampleLoopStart = static_cast<qint32>(smpl->_sound->getUInt32(champ_dwStartLoop));
+    _sampleLoopEnd = static_cast<qint32>(smpl->_sound->getUInt32(champ_dwEndLoop));
 }
 
 void VoiceParam::readDivisionAttributes(Division * globalDivision, Division * division, bool isPrst)
@@ -0,0 +1,155 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#include "testbank.h"
+#include "polyphonecore.h"
+#include "soundfontmanager.h"
+#include "synth.h"
+#include "modulatordata.h"
+#include "voice.h"
+#include <QFile>
+#include <QtMath>
+
+const quint32 TestBank::SAMPLE_RATE;
+
+void TestBank::initialize()
+{
+    // Prepare arrays, as for the synthesizer
+    SFModulator::prepareConversionTables();
+    Voice::prepareSincTable();
+    PolyphoneCore::initialize();
+}
+
+QVector<float> TestBank::createTone(double frequency, quint32 length, int harmonicCount, quint32 * seed)
+{
+    double period = SAMPLE_RATE / frequency;
+    QVector<float> vData(static_cast<int>(length));
+    for (quint32 i = 0; i < length; i++)
+    {
+        double value = 0;
+        for (int harmonic = 1; harmonic <= harmonicCount && harmonic * frequency < SAMPLE_RATE / 2; harmonic++)
+            value += qSin(2.0 * M_PI * harmonic * i / period) / (harmonic * 2);
+        if (seed != nullptr)
+        {
+            *seed = *seed * 1664525 + 1013904223;
+            value += 0.01 * (static_cast<double>(*seed >> 8) / 8388608.0 - 1.0);
+        }
+        vData[static_cast<int>(i)] = static_cast<float>(value);
+    }
+    return vData;
+}
+
+int TestBank::addSample(SoundfontManager * sm, int sf2Index, QString name, int key, QVector<float> vData,
+                        quint32 loopStart, quint32 loopMaxLength)
+{
+    double period = SAMPLE_RATE / (440.0 * qPow(2.0, (key - 69) / 12.0));
+
+    EltID idSmpl(elementSmpl, sf2Index);
+    idSmpl.indexElt = sm->add(idSmpl);
+    sm->set(idSmpl, vData);
+    sm->set(idSmpl, champ_name, name);
+    AttributeValue value;
+    value.dwValue = static_cast<quint32>(vData.size());
+    sm->set(idSmpl, champ_dwLength, value);
+    value.dwValue = SAMPLE_RATE;
+    sm->set(idSmpl, champ_dwSampleRate, value);
+    value.wValue = static_cast<quint16>(key);
+    sm->set(idSmpl, champ_byOriginalPitch, value);
+    value.cValue = 0;
+    sm->set(idSmpl, champ_chPitchCorrection, value);
+    value.dwValue = loopStart;
+    sm->set(idSmpl, champ_dwStartLoop, value);
+    value.dwValue = loopStart + static_cast<quint32>(qFloor(loopMaxLength / period) * period);
+    sm->set(idSmpl, champ_dwEndLoop, value);
+    value.sfLinkValue = monoSample;
+    sm->set(idSmpl, champ_sfSampleType, value);
+    value.wValue = 0;
+    sm->set(idSmpl, champ_wSampleLink, value);
+
+    return idSmpl.indexElt;
+}
+
+int TestBank::addInstrument(SoundfontManager * sm, int sf2Index, QString name)
+{
+    EltID idInst(elementInst, sf2Index);
+    idInst.indexElt = sm->add(idInst);
+    sm->set(idInst, champ_name, name);
+    AttributeValue value;
+    value.wValue = 1; // Loop
+    sm->set(idInst, champ_sampleModes, value);
+    return idInst.indexElt;
+}
+
+EltID TestBank::addDivision(SoundfontManager * sm, EltID idInst, int sampleIndex, int keyMin, int keyMax)
+{
+    EltID idInstSmpl(elementInstSmpl, idInst.indexSf2, idInst.indexElt);
+    idInstSmpl.indexElt2 = sm->add(idInstSmpl);
+    AttributeValue value;
+    value.wValue = static_cast<quint16>(sampleIndex);
+    sm->set(idInstSmpl, champ_sampleID, value);
+    value.rValue.byLo = static_cast<quint8>(keyMin);
+    value.rValue.byHi = static_cast<quint8>(keyMax);
+    sm->set(idInstSmpl, champ_keyRange, value);
+    return idInstSmpl;
+}
+
+int TestBank::addPreset(SoundfontManager * sm, int sf2Index, QString name, int presetNumber, int instIndex)
+{
+    EltID idPrst(elementPrst, sf2Index);
+    idPrst.indexElt = sm->add(idPrst);
+    sm->set(idPrst, champ_name, name);
+    AttributeValue value;
+    value.wValue = 0;
+    sm->set(idPrst, champ_wBank, value);
+    value.wValue = static_cast<quint16>(presetNumber);
+    sm->set(idPrst, champ_wPreset, value);
+
+    EltID idPrstInst(elementPrstInst, sf2Index, idPrst.indexElt);
+    idPrstInst.indexElt2 = sm->add(idPrstInst);
+    value.wValue = static_cast<quint16>(instIndex);
+    sm->set(idPrstInst, champ_instrument, value);
+
+    return idPrst.indexElt;
+}
+
+void TestBank::configureSynth(Synth * synth, IMidiValues * midiValues)
+{
+    SynthConfig config;
+    config.choLevel = config.choDepth = config.choFrequency = 0;
+    config.revLevel = config.revSize = config.revWidth = config.revDamping = 0;
+    config.gain = 0;
+    config.tuningFork = 440;
+    synth->configure(&config);
+    synth->setIMidiValues(midiValues);
+}
+
+bool TestBank::writeFile(QString filePath, QByteArray data)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(data);
+    file.close();
+    return true;
+}
@@ -0,0 +1,68 @@
+/***************************************************************************
+**                                                                        **
+**  Polyphone, a soundfont editor                                         **
+**  Copyright (C) 2013-2024 Davy Triponney                                **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program. If not, see http://www.gnu.org/licenses/.    **
+**                                                                        **
+****************************************************************************
+**           Author: Davy Triponney                                       **
+**  Website/Contact: https://www.polyphone.io                             **
+**             Date: 01.01.2013                                           **
+***************************************************************************/
+
+#ifndef TESTBANK_H
+#define TESTBANK_H
+
+#include "basetypes.h"
+#include <QVector>
+class SoundfontManager;
+class Synth;
+class IMidiValues;
+
+// Helpers shared by the benchmark and the audio regression tests for building synthetic banks in memory
+// and rendering them without effects
+class TestBank
+{
+public:
+    static const quint32 SAMPLE_RATE = 44100;
+
+    /// Prepare the conversion tables of the synth and initialize the engine
+    static void initialize();
+
+    /// Harmonics of a frequency, the amplitude of the harmonic n being 1 / 2n
+    /// A low level of noise is added if a seed is given, generated deterministically
+    static QVector<float> createTone(double frequency, quint32 length, int harmonicCount, quint32 * seed = nullptr);
+
+    /// Add a mono sample tuned on a key, the loop starting at loopStart and containing as many periods as possible in loopMaxLength
+    static int addSample(SoundfontManager * sm, int sf2Index, QString name, int key, QVector<float> vData,
+                         quint32 loopStart, quint32 loopMaxLength);
+
+    /// Add an instrument playing its samples in loop
+    static int addInstrument(SoundfontManager * sm, int sf2Index, QString name);
+
+    /// Add a division using a sample in an instrument
+    static EltID addDivision(SoundfontManager * sm, EltID idInst, int sampleIndex, int keyMin, int keyMax);
+
+    /// Add a preset in bank 0 using one instrument
+    static int addPreset(SoundfontManager * sm, int sf2Index, QString name, int presetNumber, int instIndex);
+
+    /// Configure a synth without chorus, reverb and gain
+    static void configureSynth(Synth * synth, IMidiValues * midiValues);
+
+    /// Write data in a file, false if the file cannot be written
+    static bool writeFile(QString filePath, QByteArray data);
+};
+
+#endif // TESTBANK_H